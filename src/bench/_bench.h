@@ -0,0 +1,54 @@
+/**
+ * @private
+ * @file _bench.h
+ * @brief Benchmark support.
+ * @details Provides a monotonic timer and a consistent result format
+ * for benchmarks. Build and run benchmarks with optimization, e.g.
+ * `make clean bench CFLAGS="-O2"`, for meaningful results.
+ * @copyright Adequate Systems LLC, 2022. All Rights Reserved.
+ * <br />For license information, please refer to ../LICENSE.md
+*/
+
+/* include guard */
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+
+#include <stdio.h>
+
+#ifdef _WIN32
+   #include <windows.h>
+
+#else
+   #include <time.h>
+
+#endif
+
+/* print a benchmark result, in (millions of) operations per second */
+#define BENCH_RESULT(NAME, OPS, SECONDS) \
+   printf("%-40s %12.3f Mop/s\n", NAME, (double) (OPS) / (SECONDS) / 1e6)
+
+/* print a benchmark result, in (binary) megabytes per second */
+#define BENCH_RESULT_BYTES(NAME, BYTES, SECONDS) \
+   printf("%-40s %12.3f MiB/s\n", NAME, \
+      (double) (BYTES) / (SECONDS) / (1024.0 * 1024.0))
+
+/* Get a monotonic time, in seconds. */
+static inline double bench_time(void)
+{
+#ifdef _WIN32
+   LARGE_INTEGER count, freq;
+   QueryPerformanceCounter(&count);
+   QueryPerformanceFrequency(&freq);
+   return (double) count.QuadPart / (double) freq.QuadPart;
+
+#else
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double) ts.tv_sec + ((double) ts.tv_nsec / 1e9);
+
+#endif
+}
+
+/* end include guard */
+#endif
@@ -0,0 +1,80 @@
+
+/* library (out-of-line) calls, for comparison in extmath-inline.c;
+ * a separate translation unit, built WITHOUT EXTC_INLINE, such that
+ * every call is a call into the library */
+
+#undef EXTC_INLINE
+
+#include "_extmath-inline.h"
+
+#include "extlib.h"
+#include "extmath.h"
+
+word32 lib_get32_loop(const word8 *buff, long buffsz, long iterations)
+{
+   word32 x;
+   long i;
+
+   for (i = x = 0; i < iterations; i++) {
+      x += get32(&buff[(i << 2) & (buffsz - 1)]);
+   }
+
+   return x;
+}  /* end lib_get32_loop() */
+
+void lib_put32_loop(word8 *buff, long buffsz, long iterations)
+{
+   long i;
+
+   for (i = 0; i < iterations; i++) {
+      put32(&buff[(i << 2) & (buffsz - 1)], (word32) i);
+   }
+}  /* end lib_put32_loop() */
+
+void lib_put64_loop(word8 *buff, long buffsz, long iterations)
+{
+   long i, j;
+
+   for (i = 0; i < iterations; i++) {
+      j = (i << 3) & (buffsz - 1);
+      put64(&buff[j], &buff[j ^ 8]);
+   }
+}  /* end lib_put64_loop() */
+
+word32 lib_iszero_loop(const word8 *buff, long buffsz, long iterations)
+{
+   word32 x;
+   long i;
+
+   for (i = x = 0; i < iterations; i++) {
+      x += iszero(&buff[(i << 5) & (buffsz - 1)], 32);
+   }
+
+   return x;
+}  /* end lib_iszero_loop() */
+
+word32 lib_add64_loop(const word8 *buff, long buffsz, long iterations)
+{
+   word64 sum[2];
+   word32 x;
+   long i;
+
+   for (i = x = 0, sum[0] = 0; i < iterations; i++) {
+      x += add64(sum, &buff[(i << 3) & (buffsz - 1)], sum);
+   }
+
+   return x + (word32) sum[0];
+}  /* end lib_add64_loop() */
+
+word32 lib_cmp256_loop(const word8 *buff, long buffsz, long iterations)
+{
+   word32 x;
+   long i, j;
+
+   for (i = x = 0; i < iterations; i++) {
+      j = (i << 5) & (buffsz - 1);
+      x += cmp256(&buff[j], &buff[j ^ 32]) < 0;
+   }
+
+   return x;
+}  /* end lib_cmp256_loop() */
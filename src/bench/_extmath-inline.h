@@ -0,0 +1,27 @@
+/**
+ * @private
+ * @file _extmath-inline.h
+ * @brief Benchmark support; library (out-of-line) call loops.
+ * @details Loops of library calls, defined in _extmath-inline.c, a
+ * translation unit built WITHOUT `EXTC_INLINE`. Baselines for the
+ * inline (`EXTC_INLINE`) forms in extmath-inline.c.
+ * @copyright Adequate Systems LLC, 2022. All Rights Reserved.
+ * <br />For license information, please refer to ../LICENSE.md
+*/
+
+/* include guard */
+#ifndef BENCH_EXTMATH_INLINE_H
+#define BENCH_EXTMATH_INLINE_H
+
+
+#include "extint.h"
+
+word32 lib_get32_loop(const word8 *buff, long buffsz, long iterations);
+void lib_put32_loop(word8 *buff, long buffsz, long iterations);
+void lib_put64_loop(word8 *buff, long buffsz, long iterations);
+word32 lib_iszero_loop(const word8 *buff, long buffsz, long iterations);
+word32 lib_add64_loop(const word8 *buff, long buffsz, long iterations);
+word32 lib_cmp256_loop(const word8 *buff, long buffsz, long iterations);
+
+/* end include guard */
+#endif
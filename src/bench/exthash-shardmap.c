@@ -0,0 +1,108 @@
+
+#include "_bench.h"
+#include "exthash.h"
+
+#include "extio.h"
+#include "extlib.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define KEYLEN       32
+#define COUNT        (1 << 20)
+#define LOOKUPS      (1 << 22)
+#define MAXTHREADS   256
+
+static word8 (*si_keys)[KEYLEN];
+static SHARDMAP si_map;
+static HASHTABLE si_table;
+static RWLock si_rwlock;
+
+ThreadProc lookup_shardmap(void *args)
+{
+   word32 x = *((word32 *) args);
+   word64 value;
+   long i;
+
+   for (i = 0; i < LOOKUPS; i++) {
+      x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+      shardmap_get(&si_map, si_keys[x % COUNT], &value);
+   }
+
+   Unthread;
+}
+
+ThreadProc lookup_rwlock(void *args)
+{
+   word32 x = *((word32 *) args);
+   word64 value;
+   void *vp;
+   long i;
+
+   for (i = 0; i < LOOKUPS; i++) {
+      x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+      rwlock_rdlock(&si_rwlock);
+      vp = hashtable_get(&si_table, si_keys[x % COUNT]);
+      if (vp) memcpy(&value, vp, sizeof(value));
+      rwlock_rdunlock(&si_rwlock);
+   }
+
+   Unthread;
+}
+
+/* run a lookup routine on @a n threads, returning elapsed seconds */
+static double run(ThreadRoutine routine, int n)
+{
+   Thread threads[MAXTHREADS];
+   word32 seeds[MAXTHREADS];
+   double start;
+   int i;
+
+   start = bench_time();
+   for (i = 0; i < n; i++) {
+      seeds[i] = (word32) (i + 1) * 2654435761u;
+      thread_create(&threads[i], routine, &seeds[i]);
+   }
+   for (i = 0; i < n; i++) thread_join(threads[i]);
+
+   return bench_time() - start;
+}
+
+int main()
+{  /* benchmark; lookup throughput of SHARDMAP vs. RWLock'd HASHTABLE */
+   char name[64];
+   word64 value;
+   long i, j;
+   int n, cores;
+
+   si_keys = malloc((size_t) COUNT * KEYLEN);
+   if (si_keys == NULL) return 1;
+   srand32(1);
+   for (i = 0; i < COUNT; i++) {
+      for (j = 0; j < KEYLEN; j += 4) put32(&si_keys[i][j], rand32());
+   }
+   shardmap_init(&si_map, KEYLEN, sizeof(value), 0, 1);
+   hashtable_init(&si_table, KEYLEN, sizeof(value), COUNT, 1);
+   rwlock_init(&si_rwlock);
+   for (i = 0; i < COUNT; i++) {
+      value = (word64) i;
+      shardmap_put(&si_map, si_keys[i], &value);
+      hashtable_put(&si_table, si_keys[i], &value);
+   }
+
+   cores = cpu_cores();
+   if (cores > MAXTHREADS) cores = MAXTHREADS;
+   for (n = 1; ; n = (n * 2 < cores) ? n * 2 : cores) {
+      snprintf(name, sizeof(name), "shardmap_get(), %d threads", n);
+      BENCH_RESULT(name, (double) LOOKUPS * n, run(lookup_shardmap, n));
+      snprintf(name, sizeof(name), "rwlock + hashtable_get(), %d threads", n);
+      BENCH_RESULT(name, (double) LOOKUPS * n, run(lookup_rwlock, n));
+      if (n >= cores) break;
+   }
+
+   rwlock_destroy(&si_rwlock);
+   hashtable_destroy(&si_table);
+   shardmap_destroy(&si_map);
+   free(si_keys);
+
+   return 0;
+}
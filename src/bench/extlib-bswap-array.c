@@ -0,0 +1,65 @@
+
+#include "_bench.h"
+#include "extlib.h"
+
+#include "extmath.h"
+#include <string.h>
+
+#define BUFLEN       (1 << 14)
+#define ITERATIONS   (1 << 14)
+
+int main()
+{  /* benchmark; bulk endian conversion against per element accessors */
+   static unsigned char src[BUFLEN], dst[BUFLEN];
+   volatile word32 sink = 0;
+   word32 sum, x;
+   double start;
+   size_t j;
+   long i;
+
+   for (j = 0; j < BUFLEN; j++) src[j] = (unsigned char) rand32();
+
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      for (j = 0; j < BUFLEN; j += 4) {
+         x = get32be(&src[j]);
+         memcpy(&dst[j], &x, 4);
+      }
+      sink += dst[i & (BUFLEN - 1)];
+   }
+   BENCH_RESULT_BYTES("get32be() loop", (double) BUFLEN * ITERATIONS,
+      bench_time() - start);
+   extmath_dispatch(CPU_FEATURE_SSSE3);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      bswap32_array(dst, src, BUFLEN / 4);
+      sink += dst[i & (BUFLEN - 1)];
+   }
+   BENCH_RESULT_BYTES("bswap32_array(), SSSE3", (double) BUFLEN * ITERATIONS,
+      bench_time() - start);
+   extmath_dispatch(CPU_FEATURE_ALL);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      bswap32_array(dst, src, BUFLEN / 4);
+      sink += dst[i & (BUFLEN - 1)];
+   }
+   BENCH_RESULT_BYTES("bswap32_array(), best", (double) BUFLEN * ITERATIONS,
+      bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      bswap64_array(dst, src, BUFLEN / 8);
+      sink += dst[i & (BUFLEN - 1)];
+   }
+   BENCH_RESULT_BYTES("bswap64_array()", (double) BUFLEN * ITERATIONS,
+      bench_time() - start);
+   /* field decoding, as by a protocol parser */
+   start = bench_time();
+   for (sum = 0, i = 0; i < ITERATIONS; i++) {
+      for (j = 0; j + 8 <= BUFLEN; j += 7) sum += get32be(&src[j]);
+   }
+   sink += sum;
+   BENCH_RESULT("get32be(), unaligned", (double) ITERATIONS * (BUFLEN / 7),
+      bench_time() - start);
+
+   return 0;
+}
@@ -0,0 +1,51 @@
+
+#include "_bench.h"
+#include "extlib.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BUFLEN       (1 << 16)
+#define ITERATIONS   (1 << 13)
+
+int main()
+{  /* benchmark; random fill throughput of rand_fill() vs. rand32_r() */
+   RANDSTATE state = RANDSTATE_INITIALIZER;
+   unsigned char *buf;
+   double start;
+   size_t j;
+   word32 r;
+   long i;
+
+   buf = malloc(BUFLEN);
+   if (buf == NULL) return 1;
+
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) rand_fill(&state, buf, BUFLEN);
+   BENCH_RESULT_BYTES("rand_fill()", (double) BUFLEN * ITERATIONS,
+      bench_time() - start);
+
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      for (j = 0; j < BUFLEN; j += 4) {
+         r = rand32_r(&state);
+         memcpy(&buf[j], &r, 4);
+      }
+   }
+   BENCH_RESULT_BYTES("rand32_r() loop", (double) BUFLEN * ITERATIONS,
+      bench_time() - start);
+
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      for (j = 0; j < BUFLEN; j += 4) {
+         r = rand32();
+         memcpy(&buf[j], &r, 4);
+      }
+   }
+   BENCH_RESULT_BYTES("rand32() loop", (double) BUFLEN * ITERATIONS,
+      bench_time() - start);
+
+   free(buf);
+
+   return 0;
+}
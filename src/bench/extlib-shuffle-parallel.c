@@ -0,0 +1,44 @@
+
+#include "_bench.h"
+#include "extlib.h"
+
+#include "extio.h"
+#include <stdlib.h>
+
+/* number of (word64) elements; e.g. CFLAGS="-O2 -DCOUNT=100000000" */
+#ifndef COUNT
+   #define COUNT  (1 << 24)
+#endif
+
+int main()
+{  /* benchmark; shuffle throughput of shuffle_parallel() vs. shuffle_r() */
+   RANDSTATE state = RANDSTATE_INITIALIZER;
+   char name[64];
+   word64 *list;
+   double start;
+   size_t i;
+   int n, cores;
+
+   list = malloc((size_t) COUNT * sizeof(*list));
+   if (list == NULL) return 1;
+   for (i = 0; i < (size_t) COUNT; i++) list[i] = i;
+
+   start = bench_time();
+   shuffle_r(&state, list, sizeof(*list), COUNT);
+   BENCH_RESULT("shuffle_r()", COUNT, bench_time() - start);
+
+   cores = cpu_cores();
+   for (n = 1; ; n = (n * 2 < cores) ? n * 2 : cores) {
+      snprintf(name, sizeof(name), "shuffle_parallel(), %d threads", n);
+      start = bench_time();
+      if (shuffle_parallel(&state, list, sizeof(*list), COUNT, n) != 0) {
+         break;
+      }
+      BENCH_RESULT(name, COUNT, bench_time() - start);
+      if (n >= cores) break;
+   }
+
+   free(list);
+
+   return 0;
+}
@@ -0,0 +1,50 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+#define COUNT        4096
+#define ITERATIONS   (1 << 11)
+
+int main()
+{  /* benchmark; cmp256_batch() against cmp256() of each value */
+   static const unsigned overrides[] = {
+      0, CPU_FEATURE_X64, CPU_FEATURE_X64 | CPU_FEATURE_SSE2,
+      CPU_FEATURE_ALL
+   };
+   static word8 values[COUNT][32], mask[COUNT / 8];
+   volatile size_t sink = 0;
+   word8 target[32];
+   char name[64];
+   double start;
+   unsigned used;
+   size_t n;
+   long i, j;
+
+   /* hashes against a target, passing about 1 in 4 */
+   srand32(1);
+   for (i = 0; i < COUNT; i++) {
+      for (j = 0; j < 32; j++) values[i][j] = (word8) rand32();
+   }
+   for (j = 0; j < 32; j++) target[j] = (word8) rand32();
+   target[31] = 0x40;
+
+   for (n = 0; n < sizeof(overrides) / sizeof(overrides[0]); n++) {
+      used = extmath_dispatch(overrides[n]);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) {
+         for (j = 0; j < COUNT; j++) sink += (cmp256(values[j], target) < 0);
+      }
+      snprintf(name, sizeof(name), "cmp256() loop, features 0x%x", used);
+      BENCH_RESULT(name, (double) ITERATIONS * COUNT, bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) {
+         sink += cmp256_batch(values, COUNT, target, mask);
+      }
+      snprintf(name, sizeof(name), "cmp256_batch(), features 0x%x", used);
+      BENCH_RESULT(name, (double) ITERATIONS * COUNT, bench_time() - start);
+   }
+
+   return 0;
+}
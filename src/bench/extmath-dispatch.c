@@ -0,0 +1,51 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+#include <string.h>
+
+#define ITERATIONS   (1 << 22)
+
+int main()
+{  /* benchmark; dispatched extmath kernels, per selected CPU features */
+   static const unsigned overrides[] = {
+      0, CPU_FEATURE_X64, CPU_FEATURE_X64 | CPU_FEATURE_SSE2,
+      CPU_FEATURE_X64 | CPU_FEATURE_BMI2, CPU_FEATURE_ALL
+   };
+   static word8 buf[1024];
+   volatile int sink = 0;
+   u256 a, b, lo, hi;
+   char name[64];
+   double start;
+   unsigned used;
+   size_t n;
+   long i;
+
+   srand32(1);
+   for (i = 0; i < 8; i++) a.w[i] = rand32(), b.w[i] = rand32();
+   printf("cpu_features() = 0x%x\n", cpu_features());
+
+   for (n = 0; n < sizeof(overrides) / sizeof(overrides[0]); n++) {
+      used = extmath_dispatch(overrides[n]);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) sink += iszero(buf, sizeof(buf));
+      snprintf(name, sizeof(name), "iszero(1024), features 0x%x", used);
+      BENCH_RESULT_BYTES(name, (double) ITERATIONS * sizeof(buf),
+         bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) sink += cmp256(&a, &b);
+      snprintf(name, sizeof(name), "cmp256(), features 0x%x", used);
+      BENCH_RESULT(name, ITERATIONS, bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) sink += multi_add(&a, &b, &a, 32);
+      snprintf(name, sizeof(name), "multi_add(32), features 0x%x", used);
+      BENCH_RESULT(name, ITERATIONS, bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) sink += u256_mul(&a, &b, &lo, &hi);
+      snprintf(name, sizeof(name), "u256_mul(), features 0x%x", used);
+      BENCH_RESULT(name, ITERATIONS, bench_time() - start);
+   }
+
+   return 0;
+}
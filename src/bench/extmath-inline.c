@@ -0,0 +1,91 @@
+
+/* header-only (static inline) forms, see EXTC_INLINE */
+#ifndef EXTC_INLINE
+   #define EXTC_INLINE
+#endif
+
+#include "_bench.h"
+#include "_extmath-inline.h"
+#include "extmath.h"
+
+#include "extlib.h"
+#include <string.h>
+
+#define ITERATIONS   (1 << 24)
+#define BUFFSZ       (1 << 16)
+
+int main()
+{  /* benchmark; inline (EXTC_INLINE) forms, against library calls */
+   static word64 mem[BUFFSZ / 8];
+   word8 *buff = (word8 *) mem;
+   volatile word32 sink = 0;
+   word64 sum[2];
+   double start;
+   word32 x;
+   long i, j;
+
+   srand32(1);
+   for (i = 0; i < BUFFSZ; i++) buff[i] = (word8) rand32();
+   /* every eighth 32-byte "hash" is zero */
+   for (i = 0; i < BUFFSZ; i += 256) memset(buff + i, 0, 32);
+
+   start = bench_time();
+   sink += lib_get32_loop(buff, BUFFSZ, ITERATIONS);
+   BENCH_RESULT("get32(), library", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = x = 0; i < ITERATIONS; i++) {
+      x += get32(&buff[(i << 2) & (BUFFSZ - 1)]);
+   }
+   sink += x;
+   BENCH_RESULT("get32(), inline", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   lib_put32_loop(buff, BUFFSZ, ITERATIONS);
+   BENCH_RESULT("put32(), library", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      put32(&buff[(i << 2) & (BUFFSZ - 1)], (word32) i);
+   }
+   BENCH_RESULT("put32(), inline", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   lib_put64_loop(buff, BUFFSZ, ITERATIONS);
+   BENCH_RESULT("put64(), library", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = (i << 3) & (BUFFSZ - 1);
+      put64(&buff[j], &buff[j ^ 8]);
+   }
+   BENCH_RESULT("put64(), inline", ITERATIONS, bench_time() - start);
+
+   for (i = 0; i < BUFFSZ; i++) buff[i] = (word8) rand32();
+   for (i = 0; i < BUFFSZ; i += 256) memset(buff + i, 0, 32);
+   start = bench_time();
+   sink += lib_iszero_loop(buff, BUFFSZ, ITERATIONS);
+   BENCH_RESULT("iszero(32), library", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = x = 0; i < ITERATIONS; i++) {
+      x += iszero(&buff[(i << 5) & (BUFFSZ - 1)], 32);
+   }
+   sink += x;
+   BENCH_RESULT("iszero(32), inline", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   sink += lib_add64_loop(buff, BUFFSZ, ITERATIONS);
+   BENCH_RESULT("add64(), library", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = x = 0, sum[0] = 0; i < ITERATIONS; i++) {
+      x += add64(sum, &buff[(i << 3) & (BUFFSZ - 1)], sum);
+   }
+   sink += x + (word32) sum[0];
+   BENCH_RESULT("add64(), inline", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   sink += lib_cmp256_loop(buff, BUFFSZ, ITERATIONS);
+   BENCH_RESULT("cmp256(), library", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = x = 0; i < ITERATIONS; i++) {
+      j = (i << 5) & (BUFFSZ - 1);
+      x += cmp256(&buff[j], &buff[j ^ 32]) < 0;
+   }
+   sink += x;
+   BENCH_RESULT("cmp256(), inline", ITERATIONS, bench_time() - start);
+
+   return 0;
+}
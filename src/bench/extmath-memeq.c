@@ -0,0 +1,86 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+#include <string.h>
+
+#define ITERATIONS   (1 << 24)
+#define KEYS         1024
+
+int main()
+{  /* benchmark; inline fixed length key equality, against memcmp() of
+    * constant (inlined) and, for context, variable (called) length */
+   static word8 keys[KEYS][64];
+   volatile size_t len = 0;
+   volatile int sink = 0;
+   double start;
+   long i, j;
+
+   srand32(1);
+   for (i = 0; i < KEYS; i++) {
+      for (j = 0; j < 64; j++) keys[i][j] = (word8) rand32();
+      /* keys differ only in the final byte, such as sorted hashes */
+      if (i & 1) memcpy(keys[i], keys[i - 1], 63);
+   }
+
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memcmp(keys[j], keys[j ^ 1], 16) == 0;
+   }
+   BENCH_RESULT("memcmp(16)", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memcmp(keys[j], keys[j ^ 1], 16 + len) == 0;
+   }
+   BENCH_RESULT("memcmp(16), variable length", ITERATIONS,
+      bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memeq16(keys[j], keys[j ^ 1]);
+   }
+   BENCH_RESULT("memeq16()", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memcmp(keys[j], keys[j ^ 1], 32) == 0;
+   }
+   BENCH_RESULT("memcmp(32)", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memcmp(keys[j], keys[j ^ 1], 32 + len) == 0;
+   }
+   BENCH_RESULT("memcmp(32), variable length", ITERATIONS,
+      bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memeq32(keys[j], keys[j ^ 1]);
+   }
+   BENCH_RESULT("memeq32()", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memcmp(keys[j], keys[j ^ 1], 64) == 0;
+   }
+   BENCH_RESULT("memcmp(64)", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memcmp(keys[j], keys[j ^ 1], 64 + len) == 0;
+   }
+   BENCH_RESULT("memcmp(64), variable length", ITERATIONS,
+      bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      j = i & (KEYS - 1);
+      sink += memeq64(keys[j], keys[j ^ 1]);
+   }
+   BENCH_RESULT("memeq64()", ITERATIONS, bench_time() - start);
+
+   return 0;
+}
@@ -0,0 +1,67 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+#define ITERATIONS   (1 << 24)
+
+/* previous mult64_x64(), detecting overflow by division; not inlined,
+ * for comparison with library calls */
+#ifdef __GNUC__
+__attribute__((noinline))
+#endif
+int mult64_div(const void *ax, const void *bx, void *cx)
+{
+   word64 *c = (word64 *) cx;
+   word64 a = *((word64 *) ax);
+   word64 b = *((word64 *) bx);
+
+   *c = a * b;
+   if (a == 0) return 0;
+   if ((*c / a) == b) return 0;
+   return 1;
+}
+
+int main()
+{  /* benchmark; 64-bit multiplication with overflow detection */
+   static word64 values[1024];
+   word64 x, lo, hi;
+   double start;
+   volatile long overflows = 0;
+   long i;
+
+   srand32(1);
+   for (i = 0; i < 1024; i++) {
+      /* random widths, such that overflow is unpredictable */
+      values[i] = ((word64) rand32() << 32) | rand32();
+      values[i] >>= rand32() & 63;
+   }
+
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      x = values[i & 1023];
+      if (mult64_div(&x, &values[(i >> 10) & 1023], &lo)) overflows++;
+   }
+   BENCH_RESULT("mult64() by division", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      x = values[i & 1023];
+      if (mult64(&x, &values[(i >> 10) & 1023], &lo)) overflows++;
+   }
+   BENCH_RESULT("mult64()", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      x = values[i & 1023];
+      if (mult64_full(&x, &values[(i >> 10) & 1023], &lo, &hi)) overflows++;
+   }
+   BENCH_RESULT("mult64_full()", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      x = values[i & 1023];
+      if (mult64_full_x86(&x, &values[(i >> 10) & 1023], &lo, &hi)) overflows++;
+   }
+   BENCH_RESULT("mult64_full_x86()", ITERATIONS, bench_time() - start);
+
+   return 0;
+}
@@ -0,0 +1,79 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extint.h"
+#include <string.h>
+
+#define ITERATIONS   (1 << 24)
+
+/* previous byte loop multi_add(), for comparison */
+static int multi_add_bytes(const void *ax, const void *bx, void *cx,
+   int bytelen)
+{
+   word8 *a = (word8 *) ax, *b = (word8 *) bx, *c = (word8 *) cx;
+   int t, carry = 0;
+
+   for( ; bytelen > 0; a++, b++, c++, bytelen--) {
+      t = *a + *b + carry;
+      carry = t >> 8;
+      *c = t;
+   }
+
+   return carry;
+}
+
+/* previous byte loop multi_sub(), for comparison */
+static int multi_sub_bytes(const void *ax, const void *bx, void *cx,
+   int bytelen)
+{
+   word8 *a = (word8 *) ax, *b = (word8 *) bx, *c = (word8 *) cx;
+   int t, carry = 0;
+
+   for( ; bytelen > 0; a++, b++, c++, bytelen--) {
+      t = *a - *b - carry;
+      carry = (t >> 8) & 1;
+      *c = t;
+   }
+
+   return carry;
+}
+
+/* run a multi-byte operation on @a len byte values, returning seconds */
+static double run(int (*fn)(const void *, const void *, void *, int),
+   int len)
+{
+   static word8 a[256], b[256];
+   volatile int sink = 0;
+   double start;
+   long i;
+
+   memset(a, 0xa5, sizeof(a));
+   memset(b, 0x5a, sizeof(b));
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) sink += fn(a, b, a, len);
+
+   return bench_time() - start;
+}
+
+int main()
+{  /* benchmark; limb multi_add/sub() vs. byte loops */
+   static const int lens[] = { 8, 32, 33, 256 };
+   char name[64];
+   size_t i;
+
+   for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+      snprintf(name, sizeof(name), "multi_add(), %d bytes", lens[i]);
+      BENCH_RESULT(name, ITERATIONS, run(multi_add, lens[i]));
+      snprintf(name, sizeof(name), "multi_add() byte loop, %d bytes",
+         lens[i]);
+      BENCH_RESULT(name, ITERATIONS, run(multi_add_bytes, lens[i]));
+      snprintf(name, sizeof(name), "multi_sub(), %d bytes", lens[i]);
+      BENCH_RESULT(name, ITERATIONS, run(multi_sub, lens[i]));
+      snprintf(name, sizeof(name), "multi_sub() byte loop, %d bytes",
+         lens[i]);
+      BENCH_RESULT(name, ITERATIONS, run(multi_sub_bytes, lens[i]));
+   }
+
+   return 0;
+}
@@ -0,0 +1,36 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+#define MAXLEN    8192
+
+int main()
+{  /* benchmark; multi_mul() and multi_sqr(), across operand lengths */
+   static const int lens[] = { 32, 128, 192, 256, 384, 512, 1024, MAXLEN };
+   static word8 a[MAXLEN], b[MAXLEN], c[2 * MAXLEN];
+   char name[64];
+   double start;
+   long i, iterations;
+   size_t n;
+
+   srand32(1);
+   for (i = 0; i < MAXLEN; i++) a[i] = (word8) rand32();
+   for (i = 0; i < MAXLEN; i++) b[i] = (word8) rand32();
+
+   for (n = 0; n < sizeof(lens) / sizeof(lens[0]); n++) {
+      /* scale iterations to quadratic (schoolbook) cost */
+      iterations = (1L << 26) / ((long) lens[n] * lens[n] / 64);
+      start = bench_time();
+      for (i = 0; i < iterations; i++) multi_mul(a, lens[n], b, lens[n], c);
+      snprintf(name, sizeof(name), "multi_mul(), %d bytes", lens[n]);
+      BENCH_RESULT(name, iterations, bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < iterations; i++) multi_sqr(a, lens[n], c);
+      snprintf(name, sizeof(name), "multi_sqr(), %d bytes", lens[n]);
+      BENCH_RESULT(name, iterations, bench_time() - start);
+   }
+
+   return 0;
+}
@@ -0,0 +1,63 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+#define ITERATIONS   (1 << 20)
+
+/* shift right by one bit, a byte at a time (repeated per bit) */
+void shr1_bytes(word8 *a, int len)
+{
+   int i;
+
+   for (i = 0; i < len - 1; i++) a[i] = (word8) ((a[i] >> 1) | (a[i + 1] << 7));
+   a[len - 1] >>= 1;
+}
+
+int main()
+{  /* benchmark; multi-byte shifts by many bits, and bit scans */
+   static const int lens[] = { 32, 256 };
+   word8 a[256], c[256];
+   volatile int sink = 0;
+   char name[64];
+   double start;
+   long i;
+   size_t n;
+   int j;
+
+   srand32(1);
+   for (j = 0; j < 256; j++) a[j] = (word8) rand32();
+
+   for (n = 0; n < sizeof(lens) / sizeof(lens[0]); n++) {
+      start = bench_time();
+      for (i = 0; i < ITERATIONS / 64; i++) {
+         memcpy(c, a, lens[n]);
+         for (j = 0; j < 61; j++) shr1_bytes(c, lens[n]);
+         sink += c[0];
+      }
+      snprintf(name, sizeof(name), "shift by 61, 1 bit loop, %d bytes",
+         lens[n]);
+      BENCH_RESULT(name, ITERATIONS / 64, bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) {
+         multi_shr(a, 61, c, lens[n]);
+         sink += c[0];
+      }
+      snprintf(name, sizeof(name), "multi_shr() by 61, %d bytes", lens[n]);
+      BENCH_RESULT(name, ITERATIONS, bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) {
+         multi_shl(a, 61, c, lens[n]);
+         sink += c[0];
+      }
+      snprintf(name, sizeof(name), "multi_shl() by 61, %d bytes", lens[n]);
+      BENCH_RESULT(name, ITERATIONS, bench_time() - start);
+      start = bench_time();
+      for (i = 0; i < ITERATIONS; i++) sink += multi_popcount(a, lens[n]);
+      snprintf(name, sizeof(name), "multi_popcount(), %d bytes", lens[n]);
+      BENCH_RESULT(name, ITERATIONS, bench_time() - start);
+   }
+
+   return 0;
+}
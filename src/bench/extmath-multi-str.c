@@ -0,0 +1,89 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+#include <stdio.h>
+
+#define ITERATIONS   (1 << 20)
+
+/* previous decimal conversion, by repeated division by 10 */
+int bytes_to_dec(const void *ax, int len, char *str)
+{
+   word8 t[32];
+   char rev[80];
+   int i, n = 0, r, nonzero;
+
+   memcpy(t, ax, (size_t) len);
+   do {
+      for (nonzero = r = 0, i = len - 1; i >= 0; i--) {
+         r = (r << 8) | t[i];
+         t[i] = (word8) (r / 10);
+         r %= 10;
+         nonzero |= t[i];
+      }
+      rev[n++] = (char) ('0' + r);
+   } while (nonzero);
+   for (i = 0; i < n; i++) str[i] = rev[n - 1 - i];
+   str[n] = '\0';
+
+   return n;
+}
+
+int main()
+{  /* benchmark; decimal and hex conversion, against snprintf() */
+   static word64 amounts[1024];
+   volatile int sink = 0;
+   u256 total;
+   char str[96];
+   double start;
+   long i;
+
+   srand32(1);
+   for (i = 0; i < 1024; i++) {
+      amounts[i] = (((word64) rand32() << 32) | rand32()) >> (i & 31);
+   }
+   for (i = 0; i < 8; i++) total.w[i] = rand32();
+
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      sink += snprintf(str, sizeof(str), "%" P64u, amounts[i & 1023]);
+   }
+   BENCH_RESULT("snprintf(P64u)", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      sink += multi_to_dec(&amounts[i & 1023], 8, str, sizeof(str));
+   }
+   BENCH_RESULT("multi_to_dec(), 8 bytes", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      sink += snprintf(str, sizeof(str), "%" P64x, amounts[i & 1023]);
+   }
+   BENCH_RESULT("snprintf(P64x)", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      sink += multi_to_hex(&amounts[i & 1023], 8, str, sizeof(str));
+   }
+   BENCH_RESULT("multi_to_hex(), 8 bytes", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS / 16; i++) {
+      total.b[0] = (word8) i;
+      sink += bytes_to_dec(&total, 32, str);
+   }
+   BENCH_RESULT("divide by 10 loop, 32 bytes", ITERATIONS / 16,
+      bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      total.b[0] = (word8) i;
+      sink += multi_to_dec(&total, 32, str, sizeof(str));
+   }
+   BENCH_RESULT("multi_to_dec(), 32 bytes", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) {
+      sink += multi_from_dec(str, &total, 32);
+   }
+   BENCH_RESULT("multi_from_dec(), 32 bytes", ITERATIONS,
+      bench_time() - start);
+
+   return 0;
+}
@@ -0,0 +1,41 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+#define MAXCOUNT  (1 << 20)
+
+int comp(const void *a, const void *b)
+{
+   return cmp256(a, b);
+}
+
+int main()
+{  /* benchmark; sort256() against qsort() by cmp256(), of random hashes */
+   static const size_t counts[] = { 1000, 100000, MAXCOUNT };
+   static word8 keys[MAXCOUNT][32], values[MAXCOUNT][32];
+   char name[64];
+   double start;
+   size_t n, i, j;
+
+   srand32(1);
+   for (i = 0; i < MAXCOUNT; i++) {
+      for (j = 0; j < 32; j++) keys[i][j] = (word8) rand32();
+   }
+
+   for (n = 0; n < sizeof(counts) / sizeof(counts[0]); n++) {
+      memcpy(values, keys, counts[n] * 32);
+      start = bench_time();
+      qsort(values, counts[n], 32, comp);
+      snprintf(name, sizeof(name), "qsort(cmp256), %zu keys", counts[n]);
+      BENCH_RESULT(name, counts[n], bench_time() - start);
+      memcpy(values, keys, counts[n] * 32);
+      start = bench_time();
+      sort256(values, counts[n]);
+      snprintf(name, sizeof(name), "sort256(), %zu keys", counts[n]);
+      BENCH_RESULT(name, counts[n], bench_time() - start);
+   }
+
+   return 0;
+}
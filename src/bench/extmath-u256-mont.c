@@ -0,0 +1,67 @@
+
+#include "_bench.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+#define ITERATIONS   (1 << 20)
+
+/* previous modular product, by shift-and-add with repeated subtraction
+ * of the modulus, using only multi_add() and multi_sub() */
+void mulmod_add_sub(const u256 *a, const u256 *b, const u256 *n, u256 *c)
+{
+   u256 r;
+   int i;
+
+   memset(&r, 0, sizeof(r));
+   for (i = 255; i >= 0; i--) {
+      if (multi_add(&r, &r, &r, 32) || cmp256(&r, n) >= 0) {
+         multi_sub(&r, n, &r, 32);
+      }
+      if ((b->b[i >> 3] >> (i & 7)) & 1) {
+         if (multi_add(&r, a, &r, 32) || cmp256(&r, n) >= 0) {
+            multi_sub(&r, n, &r, 32);
+         }
+      }
+   }
+   *c = r;
+}
+
+int main()
+{  /* benchmark; Montgomery arithmetic, against shift-and-add */
+   U256MONT ctx;
+   u256 n, a, b, e;
+   double start;
+   long i, iterations;
+
+   srand32(1);
+   multi_from_hex("fffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+      "efffffc2f", &n, sizeof(n));
+   for (i = 0; i < 8; i++) a.w[i] = rand32();
+   for (i = 0; i < 8; i++) b.w[i] = rand32();
+   for (i = 0; i < 8; i++) e.w[i] = rand32();
+   u256_divmod(&a, &n, NULL, &a);
+   u256_divmod(&b, &n, NULL, &b);
+
+   iterations = ITERATIONS / 64;
+   start = bench_time();
+   for (i = 0; i < iterations; i++) mulmod_add_sub(&a, &b, &n, &a);
+   BENCH_RESULT("shift-and-add mulmod", iterations, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS / 64; i++) u256_mont_init(&ctx, &n);
+   BENCH_RESULT("u256_mont_init()", ITERATIONS / 64, bench_time() - start);
+   u256_mont_to(&ctx, &a, &a);
+   u256_mont_to(&ctx, &b, &b);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) u256_mont_mul(&ctx, &a, &b, &a);
+   BENCH_RESULT("u256_mont_mul()", ITERATIONS, bench_time() - start);
+   start = bench_time();
+   for (i = 0; i < ITERATIONS; i++) u256_mont_sqr(&ctx, &a, &a);
+   BENCH_RESULT("u256_mont_sqr()", ITERATIONS, bench_time() - start);
+   iterations = ITERATIONS / 256;
+   start = bench_time();
+   for (i = 0; i < iterations; i++) u256_mont_exp(&ctx, &a, &e, &a);
+   BENCH_RESULT("u256_mont_exp()", iterations, bench_time() - start);
+
+   return 0;
+}
@@ -0,0 +1,74 @@
+
+#include "_bench.h"
+#include "extstring.h"
+
+#include <stdlib.h>
+
+#define BUFLEN    (1 << 20)
+#define TOTAL     (1 << 28)
+
+/* previous memswap(), through a BUFSIZ stack temp, for comparison */
+static void memswap_bufsiz(void *ax, void *bx, size_t count)
+{
+   unsigned char *pa = (unsigned char *) ax;
+   unsigned char *pb = (unsigned char *) bx;
+   unsigned char temp[BUFSIZ];
+
+   while (count >= BUFSIZ) {
+      memcpy(temp, pa, BUFSIZ);
+      memcpy(pa, pb, BUFSIZ);
+      memcpy(pb, temp, BUFSIZ);
+      count -= BUFSIZ;
+      pa += BUFSIZ;
+      pb += BUFSIZ;
+   }
+   if (count) {
+      memcpy(temp, pa, count);
+      memcpy(pa, pb, count);
+      memcpy(pb, temp, count);
+   }
+}
+
+/* swap @a size byte elements of buffers, until TOTAL bytes swapped */
+static double run(void (*fn)(void *, void *, size_t),
+   unsigned char *a, unsigned char *b, size_t size)
+{
+   double start;
+   size_t n, i;
+
+   start = bench_time();
+   for (n = 0; n < TOTAL; n += BUFLEN) {
+      for (i = 0; i + size <= BUFLEN; i += size) fn(&a[i], &b[i], size);
+   }
+
+   return bench_time() - start;
+}
+
+int main()
+{  /* benchmark; memswap() vs. BUFSIZ memswap, across element sizes */
+   static const size_t sizes[] =
+      { 4, 8, 12, 16, 32, 64, 100, 256, 4096, 65536 };
+   unsigned char *a, *b;
+   char name[64];
+   size_t i;
+
+   a = malloc(BUFLEN);
+   b = malloc(BUFLEN);
+   if (a == NULL || b == NULL) return 1;
+   memset(a, 0xaa, BUFLEN);
+   memset(b, 0x55, BUFLEN);
+
+   for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+      snprintf(name, sizeof(name), "memswap(), %lu bytes",
+         (unsigned long) sizes[i]);
+      BENCH_RESULT_BYTES(name, TOTAL, run(memswap, a, b, sizes[i]));
+      snprintf(name, sizeof(name), "memswap() BUFSIZ temp, %lu bytes",
+         (unsigned long) sizes[i]);
+      BENCH_RESULT_BYTES(name, TOTAL, run(memswap_bufsiz, a, b, sizes[i]));
+   }
+
+   free(b);
+   free(a);
+
+   return 0;
+}
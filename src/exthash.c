@@ -0,0 +1,943 @@
+/**
+ * @private
+ * @headerfile exthash.h <exthash.h>
+ * @copyright Adequate Systems LLC, 2022. All Rights Reserved.
+ * <br />For license information, please refer to ../LICENSE.md
+*/
+
+/* include guard */
+#ifndef EXTENDED_HASH_C
+#define EXTENDED_HASH_C
+
+
+#include "exthash.h"
+
+/* internal support */
+#include "exterrno.h"
+#include "extio.h"      /* for f*64() functions and cpu_cores() */
+
+/* external support */
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #include <emmintrin.h>
+   #define HASHTABLE_SSE2
+
+#endif
+
+#ifdef _MSC_VER
+   #include <intrin.h>
+
+#endif
+
+/* control byte values; full slots hold 7 bits of hash (high bit clear) */
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xfe
+
+/* hash splits; H1 selects the probe start, H2 is stored in control */
+#define H1(hash)     ( (hash) >> 7 )
+#define H2(hash)     ( (word8) ((hash) & 0x7f) )
+
+/* hash table growth limit (7/8 load) */
+#define HTLIMIT(ap)  ( ((ap)->mask + 1) - (((ap)->mask + 1) >> 3) )
+
+/* shard selection, by index or by the high bits of a key hash */
+#define SHARD(smp, idx) \
+   ( (SMSHARD *) &(smp)->shards[(idx) * (smp)->shardsz] )
+#define SHARDOF(smp, hash) \
+   SHARD(smp, ((hash) >> 1) >> (smp)->shift)
+
+/* maximum number of shards in a SHARDMAP */
+#define SHARDMAX     65536
+
+#ifndef rotl32
+   #define rotl32(x, n)  ( ((x) << (n)) | ((x) >> (32 - (n))) )
+
+#endif
+
+#ifndef rotl64
+   #define rotl64(x, n)  ( ((x) << (n)) | ((x) >> (64 - (n))) )
+
+#endif
+
+/* Count trailing zeros of a non-zero group mask. */
+static int group_ctz(word32 mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_ctz(mask);
+
+#elif defined(_MSC_VER)
+   unsigned long idx;
+   _BitScanForward(&idx, mask);
+   return (int) idx;
+
+#else
+   int n = 0;
+   for ( ; (mask & 1) == 0; mask >>= 1) n++;
+   return n;
+
+#endif
+}  /* end group_ctz() */
+
+/* Get a mask of control bytes in a group matching @a h2. */
+static word32 group_match(const word8 *ctrl, word8 h2)
+{
+#ifdef HASHTABLE_SSE2
+   __m128i group = _mm_loadu_si128((const __m128i *) ctrl);
+   return (word32) _mm_movemask_epi8(
+      _mm_cmpeq_epi8(group, _mm_set1_epi8((char) h2)));
+
+#else
+   word32 mask = 0;
+   int i;
+
+   for (i = 0; i < HASHTABLE_GROUP; i++) {
+      if (ctrl[i] == h2) mask |= (WORD32_C(1) << i);
+   }
+   return mask;
+
+#endif
+}  /* end group_match() */
+
+/* Get a mask of empty or deleted control bytes in a group. */
+static word32 group_free(const word8 *ctrl)
+{
+#ifdef HASHTABLE_SSE2
+   /* CTRL_EMPTY and CTRL_DELETED are the only values with high bit set */
+   return (word32) _mm_movemask_epi8(
+      _mm_loadu_si128((const __m128i *) ctrl));
+
+#else
+   word32 mask = 0;
+   int i;
+
+   for (i = 0; i < HASHTABLE_GROUP; i++) {
+      if (ctrl[i] & 0x80) mask |= (WORD32_C(1) << i);
+   }
+   return mask;
+
+#endif
+}  /* end group_free() */
+
+/* Allocate a HTARRAY of @a capacity slots of @a slotsz bytes. */
+static int htarray_alloc(HTARRAY *ap, size_t capacity, size_t slotsz)
+{
+   if (capacity > ((size_t) -1) / slotsz) goto FAIL_NOMEM;
+   ap->ctrl = malloc(capacity);
+   ap->slots = malloc(capacity * slotsz);
+   if (ap->ctrl == NULL || ap->slots == NULL) {
+      if (ap->ctrl) free(ap->ctrl);
+      if (ap->slots) free(ap->slots);
+      goto FAIL_NOMEM;
+   }
+   memset(ap->ctrl, CTRL_EMPTY, capacity);
+   ap->mask = capacity - 1;
+   ap->used = 0;
+
+   return 0;
+
+/* error handling */
+FAIL_NOMEM:
+   memset(ap, 0, sizeof(*ap));
+   set_errno(ENOMEM);
+   return (-1);
+}  /* end htarray_alloc() */
+
+/* Find the slot of @a key in a HTARRAY, or NULL if not found. */
+static word8 *htarray_find(const HTARRAY *ap, const void *key,
+   size_t keylen, size_t slotsz, size_t hash)
+{
+   const word8 *ctrl;
+   word8 *slot;
+   size_t gmask, gi, i;
+   word32 mask;
+
+   if (ap->ctrl == NULL) return NULL;
+
+   /* triangular probe sequence visits every group once */
+   gmask = ap->mask / HASHTABLE_GROUP;
+   gi = H1(hash) & gmask;
+   for (i = 1; ; i++) {
+      ctrl = &ap->ctrl[gi * HASHTABLE_GROUP];
+      for (mask = group_match(ctrl, H2(hash)); mask; mask &= mask - 1) {
+         slot = &ap->slots[((gi * HASHTABLE_GROUP) + group_ctz(mask)) * slotsz];
+         if (memcmp(slot, key, keylen) == 0) return slot;
+      }
+      /* an empty slot in a group terminates the probe sequence */
+      if (group_match(ctrl, CTRL_EMPTY)) break;
+      if (i > gmask) break;
+      gi = (gi + i) & gmask;
+   }
+
+   return NULL;
+}  /* end htarray_find() */
+
+/* Claim a free slot for a (known absent) key hash, in a HTARRAY. */
+static word8 *htarray_insert(HTARRAY *ap, size_t slotsz, size_t hash)
+{
+   size_t gmask, gi, i, idx;
+   word32 mask;
+
+   /* table load limit guarantees a free slot */
+   gmask = ap->mask / HASHTABLE_GROUP;
+   gi = H1(hash) & gmask;
+   for (i = 1; ; i++) {
+      mask = group_free(&ap->ctrl[gi * HASHTABLE_GROUP]);
+      if (mask) break;
+      gi = (gi + i) & gmask;
+   }
+   idx = (gi * HASHTABLE_GROUP) + group_ctz(mask);
+   if (ap->ctrl[idx] == CTRL_EMPTY) ap->used++;
+   ap->ctrl[idx] = H2(hash);
+
+   return &ap->slots[idx * slotsz];
+}  /* end htarray_insert() */
+
+/* Free the memory of a HTARRAY. */
+static void htarray_free(HTARRAY *ap)
+{
+   if (ap->ctrl) free(ap->ctrl);
+   if (ap->slots) free(ap->slots);
+   memset(ap, 0, sizeof(*ap));
+}  /* end htarray_free() */
+
+/* Remove the entry at @a slot from a HTARRAY. */
+static void htarray_remove(HTARRAY *ap, word8 *slot, size_t slotsz)
+{
+   size_t idx = (size_t) (slot - ap->slots) / slotsz;
+   const word8 *group = &ap->ctrl[idx & ~((size_t) HASHTABLE_GROUP - 1)];
+
+   /* any probe reaching a group with an empty slot stops there anyway */
+   if (group_match(group, CTRL_EMPTY)) {
+      ap->ctrl[idx] = CTRL_EMPTY;
+      ap->used--;
+   } else ap->ctrl[idx] = CTRL_DELETED;
+}  /* end htarray_remove() */
+
+/* Get the minimum capacity for @a count entries, or 0 on overflow. */
+static size_t hashtable_capacity(size_t count)
+{
+   size_t capacity;
+
+   for (capacity = HASHTABLE_GROUP; ; capacity <<= 1) {
+      if (capacity - (capacity >> 3) >= count) break;
+      if (capacity > (((size_t) -1) >> 2)) return 0;
+   }
+
+   return capacity;
+}  /* end hashtable_capacity() */
+
+/* Migrate, at most, @a n slots from the old slot array. */
+static void hashtable_migrate(HASHTABLE *htp, size_t n)
+{
+   HTARRAY *old = &htp->old;
+   word8 *src, *dst;
+
+   if (old->ctrl == NULL) return;
+
+   for ( ; n && htp->opos <= old->mask; n--, htp->opos++) {
+      if (old->ctrl[htp->opos] & 0x80) continue;
+      src = &old->slots[htp->opos * htp->slotsz];
+      dst = htarray_insert(&htp->cur, htp->slotsz,
+         hash_bytes(src, htp->keylen, htp->seed));
+      memcpy(dst, src, htp->slotsz);
+   }
+   /* old slot array is released once fully migrated */
+   if (htp->opos > old->mask) {
+      htarray_free(old);
+      htp->opos = 0;
+   }
+}  /* end hashtable_migrate() */
+
+/* Begin an incremental resize to a slot array of @a capacity slots. */
+static int hashtable_resize(HASHTABLE *htp, size_t capacity)
+{
+   HTARRAY next;
+
+   /* complete any resize in progress */
+   hashtable_migrate(htp, (size_t) -1);
+   if (htarray_alloc(&next, capacity, htp->slotsz) != 0) return (-1);
+   htp->old = htp->cur;
+   htp->cur = next;
+   htp->opos = 0;
+   /* nothing to migrate from an empty table */
+   if (htp->count == 0) htarray_free(&htp->old);
+
+   return 0;
+}  /* end hashtable_resize() */
+
+/* Begin a modification of a shard (makes sequence counter odd). */
+static void shard_begin(SMSHARD *sp)
+{
+   atomic_store32(&sp->seq, sp->seq + 1);
+   atomic_fence_rel();
+}  /* end shard_begin() */
+
+/* Destroy (deallocate) the slot arrays and lock of a shard. */
+static void shard_destroy(SMSHARD *sp)
+{
+   size_t i;
+
+   for (i = 0; i < sp->nretired; i++) {
+      htarray_free(sp->retired[i]);
+      free(sp->retired[i]);
+   }
+   if (sp->retired) free(sp->retired);
+   if (sp->array) {
+      htarray_free(sp->array);
+      free(sp->array);
+   }
+   mutex_destroy(&sp->lock);
+}  /* end shard_destroy() */
+
+/* End a modification of a shard (makes sequence counter even). */
+static void shard_end(SMSHARD *sp)
+{
+   atomic_store32(&sp->seq, sp->seq + 1);
+}  /* end shard_end() */
+
+/* Grow the slot array of a shard to @a capacity slots. The new slot
+ * array is filled before publication, and the old slot array (which
+ * may still be read) is retired, so no modification is required. */
+static int shard_grow(SHARDMAP *smp, SMSHARD *sp, size_t capacity)
+{
+   HTARRAY *ap, *next, **retired;
+   word8 *src;
+   size_t i;
+
+   if (capacity > (((size_t) -1) >> 2)) goto FAIL_NOMEM;
+   retired = realloc(sp->retired, (sp->nretired + 1) * sizeof(*retired));
+   if (retired == NULL) goto FAIL_NOMEM;
+   sp->retired = retired;
+   next = malloc(sizeof(*next));
+   if (next == NULL) goto FAIL_NOMEM;
+   if (htarray_alloc(next, capacity, smp->slotsz) != 0) {
+      free(next);
+      return (-1);
+   }
+
+   ap = sp->array;
+   for (i = 0; i <= ap->mask; i++) {
+      if (ap->ctrl[i] & 0x80) continue;
+      src = &ap->slots[i * smp->slotsz];
+      memcpy(htarray_insert(next, smp->slotsz,
+         hash_bytes(src, smp->keylen, smp->seed)), src, smp->slotsz);
+   }
+   atomic_store_ptr(&sp->array, next);
+   sp->retired[sp->nretired++] = ap;
+
+   return 0;
+
+/* error handling */
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end shard_grow() */
+
+/* Purge deleted slots from the slot array of a shard, in place. */
+static int shard_purge(SHARDMAP *smp, SMSHARD *sp)
+{
+   HTARRAY *ap = sp->array;
+   word8 *temp, *src;
+   size_t i, n;
+
+   temp = NULL;
+   if (sp->count) {
+      temp = malloc(sp->count * smp->slotsz);
+      if (temp == NULL) goto FAIL_NOMEM;
+   }
+
+   shard_begin(sp);
+   for (n = i = 0; i <= ap->mask; i++) {
+      if (ap->ctrl[i] & 0x80) continue;
+      memcpy(&temp[n++ * smp->slotsz], &ap->slots[i * smp->slotsz],
+         smp->slotsz);
+   }
+   memset(ap->ctrl, CTRL_EMPTY, ap->mask + 1);
+   ap->used = 0;
+   for (i = 0; i < n; i++) {
+      src = &temp[i * smp->slotsz];
+      memcpy(htarray_insert(ap, smp->slotsz,
+         hash_bytes(src, smp->keylen, smp->seed)), src, smp->slotsz);
+   }
+   shard_end(sp);
+   if (temp) free(temp);
+
+   return 0;
+
+/* error handling */
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end shard_purge() */
+
+/**
+ * Hash @a len bytes of @a key, with a @a seed.
+ * Based on MurmurHash3 by Austin Appleby, with 64-bit (x64) or 32-bit
+ * (x86) operation. Results are platform (width and endian) dependent.
+ * @param key Pointer to key to hash
+ * @param len Length of key, in bytes
+ * @param seed Hash seed
+ * @returns Hash of key.
+*/
+size_t hash_bytes(const void *key, size_t len, size_t seed)
+{
+   const word8 *p = (const word8 *) key;
+
+#ifdef HAS_64BIT
+   word64 h = ((word64) seed) ^ ((word64) len * WORD64_C(0x9e3779b97f4a7c15));
+   word64 k;
+
+   for ( ; len >= 8; p += 8, len -= 8) {
+      memcpy(&k, p, 8);
+      k *= WORD64_C(0x87c37b91114253d5);
+      k = rotl64(k, 31);
+      k *= WORD64_C(0x4cf5ad432745937f);
+      h ^= k;
+      h = rotl64(h, 27) * 5 + WORD64_C(0x52dce729);
+   }
+   if (len) {
+      k = 0;
+      memcpy(&k, p, len);
+      k *= WORD64_C(0x87c37b91114253d5);
+      k = rotl64(k, 31);
+      k *= WORD64_C(0x4cf5ad432745937f);
+      h ^= k;
+   }
+   /* final avalanche */
+   h ^= h >> 33;
+   h *= WORD64_C(0xff51afd7ed558ccd);
+   h ^= h >> 33;
+   h *= WORD64_C(0xc4ceb9fe1a85ec53);
+   h ^= h >> 33;
+
+#else
+   word32 h = ((word32) seed) ^ (word32) len;
+   word32 k;
+
+   for ( ; len >= 4; p += 4, len -= 4) {
+      memcpy(&k, p, 4);
+      k *= WORD32_C(0xcc9e2d51);
+      k = rotl32(k, 15);
+      k *= WORD32_C(0x1b873593);
+      h ^= k;
+      h = rotl32(h, 13) * 5 + WORD32_C(0xe6546b64);
+   }
+   if (len) {
+      k = 0;
+      memcpy(&k, p, len);
+      k *= WORD32_C(0xcc9e2d51);
+      k = rotl32(k, 15);
+      k *= WORD32_C(0x1b873593);
+      h ^= k;
+   }
+   /* final avalanche */
+   h ^= h >> 16;
+   h *= WORD32_C(0x85ebca6b);
+   h ^= h >> 13;
+   h *= WORD32_C(0xc2b2ae35);
+   h ^= h >> 16;
+
+#endif
+
+   return (size_t) h;
+}  /* end hash_bytes() */
+
+/**
+ * Bulk-build a HASHTABLE from a file of key/value records. Records in
+ * the file are `keylen + valuelen` bytes, each a key followed by its
+ * value. Capacity is reserved for all records up front, and where keys
+ * are in ascending memcmp() order (as in a file sorted with filesort()
+ * and a memcmp() comparison), an empty hash table is built without
+ * lookups. Records out of order are detected, and the remainder of the
+ * file is built with lookups. Duplicate keys keep the value of the last
+ * record.
+ * @param htp Pointer to hash table to build
+ * @param filename Name of file to build from, ideally sorted by key
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for hash table
+*/
+int hashtable_build(HASHTABLE *htp, const char *filename)
+{
+   FILE *fp;
+   word8 *buffer, *rec, *prev;
+   long long filelen;
+   size_t count, chunk, in, hash;
+   int unique, cmp;
+
+   /* sanity checks */
+   if (htp == NULL || filename == NULL) goto FAIL_INVAL;
+
+   buffer = NULL;
+   fp = fopen(filename, "rb");
+   if (fp == NULL) return (-1);
+   if (fseek64(fp, 0LL, SEEK_END) != 0) goto FAIL;
+   if ((filelen = ftell64(fp)) == EOF) goto FAIL;
+   rewind(fp);
+
+   /* reserve capacity for all records, migrating up front */
+   count = (size_t) (filelen / (long long) htp->slotsz);
+   if (count == 0) goto DONE;
+   if (hashtable_reserve(htp, htp->count + count) != 0) goto FAIL;
+   hashtable_migrate(htp, (size_t) -1);
+   chunk = count < 4096 ? count : 4096;
+   buffer = malloc(chunk * htp->slotsz);
+   if (buffer == NULL) goto FAIL_NOMEM;
+
+   /* an empty table (without tombstones) needs no lookups */
+   unique = (htp->count == 0 && htp->cur.used == 0);
+   prev = NULL;
+   while ((in = fread(buffer, htp->slotsz, chunk, fp)) > 0) {
+      for (rec = buffer; in; in--, rec += htp->slotsz) {
+         if (unique && prev) {
+            cmp = memcmp(prev, rec, htp->keylen);
+            if (cmp == 0) {
+               memcpy(&prev[htp->keylen], &rec[htp->keylen], htp->valuelen);
+               continue;
+            }
+            /* keys out of order; duplicates may not be adjacent */
+            if (cmp > 0) unique = 0;
+         }
+         if (!unique) {
+            if (hashtable_put(htp, rec, &rec[htp->keylen]) != 0) goto FAIL;
+         } else {
+            hash = hash_bytes(rec, htp->keylen, htp->seed);
+            prev = htarray_insert(&htp->cur, htp->slotsz, hash);
+            memcpy(prev, rec, htp->slotsz);
+            htp->count++;
+         }
+      }
+   }
+   if (ferror(fp)) goto FAIL;
+
+DONE:
+   if (buffer) free(buffer);
+   fclose(fp);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM);
+FAIL:
+   if (buffer) free(buffer);
+   fclose(fp);
+   return (-1);
+}  /* end hashtable_build() */
+
+/**
+ * Destroy (deallocate) the slot arrays of a HASHTABLE.
+ * @param htp Pointer to hash table to destroy
+*/
+void hashtable_destroy(HASHTABLE *htp)
+{
+   htarray_free(&htp->old);
+   htarray_free(&htp->cur);
+   htp->count = 0;
+}  /* end hashtable_destroy() */
+
+/**
+ * Get the value associated with @a key in a HASHTABLE.
+ * @param htp Pointer to hash table
+ * @param key Pointer to key to find
+ * @returns Pointer to inline value of found key, or NULL if not found.
+ * @note A pointer to a value is valid ONLY until the next modification
+ * of the hash table, which may migrate the key/value pair elsewhere.
+*/
+void *hashtable_get(HASHTABLE *htp, const void *key)
+{
+   word8 *slot;
+   size_t hash;
+
+   hash = hash_bytes(key, htp->keylen, htp->seed);
+   slot = htarray_find(&htp->cur, key, htp->keylen, htp->slotsz, hash);
+   if (slot == NULL) {
+      slot = htarray_find(&htp->old, key, htp->keylen, htp->slotsz, hash);
+      if (slot == NULL) return NULL;
+   }
+
+   return &slot[htp->keylen];
+}  /* end hashtable_get() */
+
+/**
+ * Initialize a HASHTABLE for @a keylen byte keys and @a valuelen byte
+ * values. To prevent a memory leak, use hashtable_destroy() before
+ * discarding an initialized hash table.
+ * @param htp Pointer to hash table to initialize
+ * @param keylen Length of each key, in bytes
+ * @param valuelen Length of each value, in bytes (may be 0)
+ * @param count Number of entries to reserve capacity for
+ * @param seed Hash function seed; use a random seed for keys that may
+ * be chosen by an adversary
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for hash table
+*/
+int hashtable_init(HASHTABLE *htp, size_t keylen, size_t valuelen,
+   size_t count, size_t seed)
+{
+   size_t capacity;
+
+   /* sanity checks */
+   if (htp == NULL || keylen == 0) goto FAIL_INVAL;
+   if (keylen + valuelen < keylen) goto FAIL_INVAL;
+
+   memset(htp, 0, sizeof(*htp));
+   htp->keylen = keylen;
+   htp->valuelen = valuelen;
+   htp->slotsz = keylen + valuelen;
+   htp->seed = seed;
+   capacity = hashtable_capacity(count);
+   if (capacity == 0) goto FAIL_NOMEM;
+
+   return htarray_alloc(&htp->cur, capacity, htp->slotsz);
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end hashtable_init() */
+
+/**
+ * Put a @a key and @a value in a HASHTABLE. An existing value
+ * associated with @a key is overwritten.
+ * @param htp Pointer to hash table
+ * @param key Pointer to key to put
+ * @param value Pointer to value to put, or NULL for a zero value
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for hash table growth
+*/
+int hashtable_put(HASHTABLE *htp, const void *key, const void *value)
+{
+   word8 *slot;
+   size_t hash, capacity;
+
+   if (htp == NULL || key == NULL) goto FAIL_INVAL;
+
+   hash = hash_bytes(key, htp->keylen, htp->seed);
+   slot = htarray_find(&htp->cur, key, htp->keylen, htp->slotsz, hash);
+   if (slot == NULL) {
+      slot = htarray_find(&htp->old, key, htp->keylen, htp->slotsz, hash);
+   }
+   if (slot == NULL) {
+      /* grow (or purge deleted slots) at load limit */
+      if (htp->cur.used >= HTLIMIT(&htp->cur)) {
+         capacity = htp->cur.mask + 1;
+         if (htp->count >= (capacity >> 1)) capacity <<= 1;
+         if (hashtable_resize(htp, capacity) != 0) return (-1);
+      }
+      slot = htarray_insert(&htp->cur, htp->slotsz, hash);
+      memcpy(slot, key, htp->keylen);
+      htp->count++;
+   }
+   if (value) memcpy(&slot[htp->keylen], value, htp->valuelen);
+   else memset(&slot[htp->keylen], 0, htp->valuelen);
+   hashtable_migrate(htp, HASHTABLE_MIGRATE);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end hashtable_put() */
+
+/**
+ * Remove a @a key (and associated value) from a HASHTABLE.
+ * @param htp Pointer to hash table
+ * @param key Pointer to key to remove
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOENT The key was not found
+*/
+int hashtable_remove(HASHTABLE *htp, const void *key)
+{
+   word8 *slot;
+   size_t hash;
+
+   if (htp == NULL || key == NULL) goto FAIL_INVAL;
+
+   hash = hash_bytes(key, htp->keylen, htp->seed);
+   slot = htarray_find(&htp->cur, key, htp->keylen, htp->slotsz, hash);
+   if (slot) htarray_remove(&htp->cur, slot, htp->slotsz);
+   else {
+      slot = htarray_find(&htp->old, key, htp->keylen, htp->slotsz, hash);
+      if (slot == NULL) goto FAIL_NOENT;
+      htarray_remove(&htp->old, slot, htp->slotsz);
+   }
+   htp->count--;
+   hashtable_migrate(htp, HASHTABLE_MIGRATE);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOENT: set_errno(ENOENT); return (-1);
+}  /* end hashtable_remove() */
+
+/**
+ * Reserve capacity in a HASHTABLE for, at least, @a count entries.
+ * Existing entries are migrated incrementally.
+ * @param htp Pointer to hash table
+ * @param count Number of entries to reserve capacity for
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for hash table
+*/
+int hashtable_reserve(HASHTABLE *htp, size_t count)
+{
+   size_t capacity;
+
+   if (htp == NULL) goto FAIL_INVAL;
+
+   capacity = hashtable_capacity(count);
+   if (capacity == 0) goto FAIL_NOMEM;
+   if (capacity <= htp->cur.mask + 1) return 0;
+
+   return hashtable_resize(htp, capacity);
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end hashtable_reserve() */
+
+/**
+ * Get the number of entries in a SHARDMAP. The result is exact only
+ * in the absence of concurrent modification.
+ * @param smp Pointer to sharded hash map
+ * @returns Number of entries in sharded hash map.
+*/
+size_t shardmap_count(SHARDMAP *smp)
+{
+   size_t count, i;
+
+   for (count = i = 0; i <= smp->mask; i++) {
+      count += atomic_load_size(&SHARD(smp, i)->count);
+   }
+
+   return count;
+}  /* end shardmap_count() */
+
+/**
+ * Destroy (deallocate) the shards of a SHARDMAP, including retired
+ * slot arrays. The sharded hash map MUST NOT be in use.
+ * @param smp Pointer to sharded hash map to destroy
+*/
+void shardmap_destroy(SHARDMAP *smp)
+{
+   size_t i;
+
+   if (smp->alloc == NULL) return;
+   for (i = 0; i <= smp->mask; i++) shard_destroy(SHARD(smp, i));
+   free(smp->alloc);
+   memset(smp, 0, sizeof(*smp));
+}  /* end shardmap_destroy() */
+
+/**
+ * Get (a copy of) the value associated with @a key in a SHARDMAP.
+ * Lookups take no lock and write no shared memory. Instead, a lookup
+ * is retried whenever it overlaps a modification of the same shard.
+ * @param smp Pointer to sharded hash map
+ * @param key Pointer to key to find
+ * @param value Pointer to place a copy of the value, or NULL
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=ENOENT The key was not found
+*/
+int shardmap_get(SHARDMAP *smp, const void *key, void *value)
+{
+   SMSHARD *sp;
+   HTARRAY *ap;
+   word8 *slot;
+   size_t hash;
+   word32 seq;
+
+   hash = hash_bytes(key, smp->keylen, smp->seed);
+   sp = SHARDOF(smp, hash);
+   slot = NULL;
+   do {
+      seq = atomic_load32(&sp->seq);
+      if (seq & 1) continue;
+      ap = atomic_load_ptr(&sp->array);
+      slot = htarray_find(ap, key, smp->keylen, smp->slotsz, hash);
+      if (slot && value) memcpy(value, &slot[smp->keylen], smp->valuelen);
+      /* lookup must complete before the sequence counter is checked */
+      atomic_fence_acq();
+      if (atomic_load32(&sp->seq) == seq) break;
+   } while (1);
+   if (slot == NULL) goto FAIL_NOENT;
+
+   return 0;
+
+/* error handling */
+FAIL_NOENT: set_errno(ENOENT); return (-1);
+}  /* end shardmap_get() */
+
+/**
+ * Initialize a SHARDMAP for @a keylen byte keys and @a valuelen byte
+ * values. To prevent a memory leak, use shardmap_destroy() before
+ * discarding an initialized sharded hash map.
+ * @param smp Pointer to sharded hash map to initialize
+ * @param keylen Length of each key, in bytes
+ * @param valuelen Length of each value, in bytes (may be 0)
+ * @param shards Number of shards (rounded up to a power of two), or 0
+ * for a default of 4 shards per CPU core
+ * @param seed Hash function seed; use a random seed for keys that may
+ * be chosen by an adversary
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for sharded hash map
+*/
+int shardmap_init(SHARDMAP *smp, size_t keylen, size_t valuelen,
+   size_t shards, size_t seed)
+{
+   SMSHARD *sp;
+   size_t count, i;
+   int bits, cores;
+
+   /* sanity checks */
+   if (smp == NULL || keylen == 0) goto FAIL_INVAL;
+   if (keylen + valuelen < keylen) goto FAIL_INVAL;
+   if (shards > SHARDMAX) goto FAIL_INVAL;
+
+   if (shards == 0) {
+      cores = cpu_cores();
+      shards = (size_t) (cores > 0 ? cores : 1) * 4;
+      if (shards > SHARDMAX) shards = SHARDMAX;
+   }
+   for (count = 1, bits = 0; count < shards; count <<= 1) bits++;
+
+   memset(smp, 0, sizeof(*smp));
+   smp->keylen = keylen;
+   smp->valuelen = valuelen;
+   smp->slotsz = keylen + valuelen;
+   smp->seed = seed;
+   smp->mask = count - 1;
+   smp->shift = (int) (sizeof(size_t) * 8) - 1 - bits;
+   /* shards occupy separate cache lines */
+   smp->shardsz = sizeof(SMSHARD) + CACHE_LINE_SIZE - 1;
+   smp->shardsz -= smp->shardsz % CACHE_LINE_SIZE;
+   smp->alloc = malloc((count * smp->shardsz) + CACHE_LINE_SIZE - 1);
+   if (smp->alloc == NULL) goto FAIL_NOMEM;
+   smp->shards = (word8 *) smp->alloc;
+   smp->shards += (CACHE_LINE_SIZE -
+      ((size_t) smp->alloc % CACHE_LINE_SIZE)) % CACHE_LINE_SIZE;
+
+   for (i = 0; i < count; i++) {
+      sp = SHARD(smp, i);
+      memset(sp, 0, sizeof(*sp));
+      if (mutex_init(&sp->lock) != 0) goto FAIL;
+      sp->array = malloc(sizeof(*sp->array));
+      if (sp->array == NULL) {
+         set_errno(ENOMEM);
+         i++;
+         goto FAIL;
+      }
+      if (htarray_alloc(sp->array, HASHTABLE_GROUP, smp->slotsz) != 0) {
+         i++;
+         goto FAIL;
+      }
+   }
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+FAIL:
+   while (i--) shard_destroy(SHARD(smp, i));
+   free(smp->alloc);
+   smp->alloc = NULL;
+   return (-1);
+}  /* end shardmap_init() */
+
+/**
+ * Put a @a key and @a value in a SHARDMAP. An existing value
+ * associated with @a key is overwritten. Modifications of a shard
+ * are serialized, but do not block lookups.
+ * @param smp Pointer to sharded hash map
+ * @param key Pointer to key to put
+ * @param value Pointer to value to put, or NULL for a zero value
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for shard growth
+*/
+int shardmap_put(SHARDMAP *smp, const void *key, const void *value)
+{
+   SMSHARD *sp;
+   HTARRAY *ap;
+   word8 *slot;
+   size_t hash, capacity;
+   int ecode;
+
+   if (smp == NULL || key == NULL) goto FAIL_INVAL;
+
+   hash = hash_bytes(key, smp->keylen, smp->seed);
+   sp = SHARDOF(smp, hash);
+   mutex_lock(&sp->lock);
+   ap = sp->array;
+   slot = htarray_find(ap, key, smp->keylen, smp->slotsz, hash);
+   if (slot == NULL && ap->used >= HTLIMIT(ap)) {
+      /* grow (or purge deleted slots) at load limit */
+      capacity = ap->mask + 1;
+      if (sp->count >= (capacity >> 1)) {
+         ecode = shard_grow(smp, sp, capacity << 1);
+      } else ecode = shard_purge(smp, sp);
+      if (ecode != 0) {
+         mutex_unlock(&sp->lock);
+         return (-1);
+      }
+      ap = sp->array;
+   }
+   shard_begin(sp);
+   if (slot == NULL) {
+      slot = htarray_insert(ap, smp->slotsz, hash);
+      memcpy(slot, key, smp->keylen);
+      atomic_store_size(&sp->count, sp->count + 1);
+   }
+   if (value) memcpy(&slot[smp->keylen], value, smp->valuelen);
+   else memset(&slot[smp->keylen], 0, smp->valuelen);
+   shard_end(sp);
+   mutex_unlock(&sp->lock);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end shardmap_put() */
+
+/**
+ * Remove a @a key (and associated value) from a SHARDMAP.
+ * @param smp Pointer to sharded hash map
+ * @param key Pointer to key to remove
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOENT The key was not found
+*/
+int shardmap_remove(SHARDMAP *smp, const void *key)
+{
+   SMSHARD *sp;
+   word8 *slot;
+   size_t hash;
+
+   if (smp == NULL || key == NULL) goto FAIL_INVAL;
+
+   hash = hash_bytes(key, smp->keylen, smp->seed);
+   sp = SHARDOF(smp, hash);
+   mutex_lock(&sp->lock);
+   slot = htarray_find(sp->array, key, smp->keylen, smp->slotsz, hash);
+   if (slot == NULL) {
+      mutex_unlock(&sp->lock);
+      goto FAIL_NOENT;
+   }
+   shard_begin(sp);
+   htarray_remove(sp->array, slot, smp->slotsz);
+   atomic_store_size(&sp->count, sp->count - 1);
+   shard_end(sp);
+   mutex_unlock(&sp->lock);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOENT: set_errno(ENOENT); return (-1);
+}  /* end shardmap_remove() */
+
+/* end include guard */
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file exthash.h
+ * @brief Extended hash table support.
+ * @details Provides associative containers for fixed length binary keys,
+ * such as 32-byte hashes or 16-byte addresses, with fixed size values
+ * stored inline with their keys. A sharded variant supports concurrent
+ * access, with lock-free lookups for read-mostly workloads.
+ * @copyright Adequate Systems LLC, 2022. All Rights Reserved.
+ * <br />For license information, please refer to ../LICENSE.md
+*/
+
+/* include guard */
+#ifndef EXTENDED_HASH_H
+#define EXTENDED_HASH_H
+
+
+#include "extint.h"
+#include "extthrd.h"
+#include <stddef.h>
+
+/**
+ * Number of control bytes (and slots) in a hash table group.
+ * Groups are probed as a whole, with SSE2 where available.
+*/
+#define HASHTABLE_GROUP    16
+
+/**
+ * Maximum number of slots migrated by each hash table modification,
+ * while an incremental resize is in progress.
+*/
+#define HASHTABLE_MIGRATE  64
+
+/**
+ * @struct HTARRAY Hash table slot array struct.
+ * @property HTARRAY::ctrl Pointer to control bytes, one per slot
+ * @property HTARRAY::slots Pointer to slots, of key/value pairs
+ * @property HTARRAY::mask Number of slots in array, less 1
+ * @property HTARRAY::used Number of non-empty (full or deleted) slots
+*/
+typedef struct hash_table_array {
+   word8 *ctrl;
+   word8 *slots;
+   size_t mask;
+   size_t used;
+} HTARRAY;
+
+/**
+ * @struct HASHTABLE Open-addressing hash table struct.
+ * Based on the "Swiss table" design, each slot has a control byte
+ * holding 7 bits of the key's hash, or an empty/deleted marker, such
+ * that a group of slots is matched against a key in a few instructions.
+ * Growth is incremental; a resize allocates a new slot array and each
+ * following modification migrates (at most) ::HASHTABLE_MIGRATE slots
+ * from the old slot array, avoiding a full rehash pause.
+ * @property HASHTABLE::cur Current slot array
+ * @property HASHTABLE::old Old slot array, during an incremental resize
+ * @property HASHTABLE::opos Migration position in old slot array
+ * @property HASHTABLE::count Number of entries in the hash table
+ * @property HASHTABLE::keylen Length of each key, in bytes
+ * @property HASHTABLE::valuelen Length of each value, in bytes
+ * @property HASHTABLE::slotsz Length of each slot (key + value), in bytes
+ * @property HASHTABLE::seed Hash function seed
+*/
+typedef struct hash_table {
+   HTARRAY cur;
+   HTARRAY old;
+   size_t opos;
+   size_t count;
+   size_t keylen;
+   size_t valuelen;
+   size_t slotsz;
+   size_t seed;
+} HASHTABLE;
+
+/**
+ * @struct SMSHARD Sharded hash map shard struct.
+ * Writers serialize on the shard lock and make the sequence counter
+ * odd for the duration of a modification. Readers take no lock; a
+ * lookup is retried whenever the sequence counter was odd, or changed,
+ * during the lookup. Slot arrays replaced by growth are retired rather
+ * than freed, as they may still be read, and released on destruction.
+ * @property SMSHARD::seq Sequence counter; odd during a modification
+ * @property SMSHARD::array Pointer to current slot array
+ * @property SMSHARD::count Number of entries in the shard
+ * @property SMSHARD::retired Pointer to list of retired slot arrays
+ * @property SMSHARD::nretired Number of retired slot arrays
+ * @property SMSHARD::lock Mutex lock for writers
+*/
+typedef struct shard_map_shard {
+   volatile word32 seq;
+   HTARRAY *array;
+   size_t count;
+   HTARRAY **retired;
+   size_t nretired;
+   Mutex lock;
+} SMSHARD;
+
+/**
+ * @struct SHARDMAP Concurrent (sharded) hash map struct.
+ * Keys are distributed across a power of two number of shards by the
+ * high bits of their hash, with each shard occupying separate cache
+ * lines, such that concurrent lookups share no written memory.
+ * @property SHARDMAP::shards Pointer to (cache aligned) shards
+ * @property SHARDMAP::alloc Pointer to allocated memory of shards
+ * @property SHARDMAP::shardsz Size of each shard, in bytes
+ * @property SHARDMAP::mask Number of shards, less 1
+ * @property SHARDMAP::shift Hash shift selecting a shard
+ * @property SHARDMAP::keylen Length of each key, in bytes
+ * @property SHARDMAP::valuelen Length of each value, in bytes
+ * @property SHARDMAP::slotsz Length of each slot (key + value), in bytes
+ * @property SHARDMAP::seed Hash function seed
+*/
+typedef struct shard_map {
+   word8 *shards;
+   void *alloc;
+   size_t shardsz;
+   size_t mask;
+   int shift;
+   size_t keylen;
+   size_t valuelen;
+   size_t slotsz;
+   size_t seed;
+} SHARDMAP;
+
+/* C/C++ compatible function prototypes */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t hash_bytes(const void *key, size_t len, size_t seed);
+int hashtable_build(HASHTABLE *htp, const char *filename);
+void hashtable_destroy(HASHTABLE *htp);
+void *hashtable_get(HASHTABLE *htp, const void *key);
+int hashtable_init(HASHTABLE *htp, size_t keylen, size_t valuelen,
+   size_t count, size_t seed);
+int hashtable_put(HASHTABLE *htp, const void *key, const void *value);
+int hashtable_remove(HASHTABLE *htp, const void *key);
+int hashtable_reserve(HASHTABLE *htp, size_t count);
+size_t shardmap_count(SHARDMAP *smp);
+void shardmap_destroy(SHARDMAP *smp);
+int shardmap_get(SHARDMAP *smp, const void *key, void *value);
+int shardmap_init(SHARDMAP *smp, size_t keylen, size_t valuelen,
+   size_t shards, size_t seed);
+int shardmap_put(SHARDMAP *smp, const void *key, const void *value);
+int shardmap_remove(SHARDMAP *smp, const void *key);
+
+#ifdef __cplusplus
+}  /* end extern "C" */
+#endif
+
+/* end include guard */
+#endif
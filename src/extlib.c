@@ -10,21 +10,43 @@
 #define EXTENDED_UTILITIES_C
 
 
+/* library symbols are always built out-of-line, see EXTC_INLINE */
+#undef EXTC_INLINE
+
 #include "extlib.h"
 
 /* internal support */
 #include "exterrno.h"
-#include "extio.h"      /* for f*64() functions in filesort */
-#include "extmath.h"    /* for iszero() in *nz() functions */
+#include "extio.h"      /* for f*64() functions in filesort, cpu_cores() */
+#include "extmath.h"    /* for iszero(), extmath_features() */
 #include "extstring.h"  /* for memory manipulation support */
+#include "extthrd.h"    /* for ThreadLocal PRNG state, shuffle threads */
+
+/* external support */
+#include <stddef.h>     /* for offsetof() in *list_sort() functions */
+
+/* Internal (thread local) default state for PRNG's, see lstate() */
+static ThreadLocal RANDSTATE Lstate = RANDSTATE_INITIALIZER;
+static ThreadLocal int Lstate_ready;
+static volatile word32 Lstate_streams;
+
+/* x86 SIMD kernels of bswap32/64_array() and rand_fill(), selected at
+ * runtime by extmath_features(), with per function target attributes */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+   (defined(__x86_64__) || defined(__i386__))
+   #include <immintrin.h>
+   #define EXTLIB_SIMD
+   #define EXTLIB_ISA(isa)  __attribute__((target(isa)))
 
-/* Internal state seeds for PRNG's */
-static word32 Lseed = 1;
-static word32 Lseed2 = 1;
-static word32 Lseed3 = 362436069;
-static word32 Lseed4 = 123456789;
-static word32 State128[4] =
-   { 0xcafef00d, 0xf01dab1e, 0x5eed1e55, 0x1dea112e };
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+   #include <immintrin.h>
+   #define EXTLIB_SIMD
+   #define EXTLIB_ISA(isa)
+
+#endif
+
+/* bytes of output per block of rand_fill() lanes */
+#define RANDFILL_BLOCK  ( RANDFILL_LANES * 4 )
 
 #ifndef rotl
    #define rotl(x, n)  ( ((x) << (n)) | ((x) >> (32 - (n))) )
@@ -102,51 +124,221 @@ void put64(void *buff, const void *value)
 #endif
 }
 
+/* Reverse the bytes of 32-bit @a x. */
+static inline word32 bswap32(word32 x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+   return __builtin_bswap32(x);
+
+#else
+   x = ((x << 8) & 0xff00ff00) | ((x >> 8) & 0x00ff00ff);
+   return (x << 16) | (x >> 16);
+
+#endif
+}
+
+/* x86 SIMD guard */
+#ifdef EXTLIB_SIMD
+
+   /* Byte shuffle masks, reversing the bytes of 32/64-bit elements */
+   static const word8 Bswap32mask[16] = {
+      3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+   };
+   static const word8 Bswap64mask[16] = {
+      7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+   };
+
+   /* Shuffle the bytes of `src[len]` into `dst[len]` by @a mask, 32
+    * bytes per iteration (with PSHUFB). Returns bytes shuffled. */
+   EXTLIB_ISA("ssse3")
+   static size_t bswap_ssse3(word8 *dst, const word8 *src, size_t len,
+      const word8 *mask)
+   {
+      const __m128i m = _mm_loadu_si128((const __m128i *) mask);
+      __m128i a, b;
+      size_t i;
+
+      for (i = 0; i + 32 <= len; i += 32) {
+         a = _mm_loadu_si128((const __m128i *) (src + i));
+         b = _mm_loadu_si128((const __m128i *) (src + i + 16));
+         _mm_storeu_si128((__m128i *) (dst + i), _mm_shuffle_epi8(a, m));
+         _mm_storeu_si128((__m128i *) (dst + i + 16), _mm_shuffle_epi8(b, m));
+      }
+
+      return i;
+   }
+
+   /* Shuffle the bytes of `src[len]` into `dst[len]` by @a mask (in
+    * each 16-byte lane), 64 bytes per iteration (with AVX2 VPSHUFB).
+    * Returns bytes shuffled. */
+   EXTLIB_ISA("avx2")
+   static size_t bswap_avx2(word8 *dst, const word8 *src, size_t len,
+      const word8 *mask)
+   {
+      const __m256i m = _mm256_broadcastsi128_si256(
+         _mm_loadu_si128((const __m128i *) mask));
+      __m256i a, b;
+      size_t i;
+
+      for (i = 0; i + 64 <= len; i += 64) {
+         a = _mm256_loadu_si256((const __m256i *) (src + i));
+         b = _mm256_loadu_si256((const __m256i *) (src + i + 32));
+         _mm256_storeu_si256((__m256i *) (dst + i),
+            _mm256_shuffle_epi8(a, m));
+         _mm256_storeu_si256((__m256i *) (dst + i + 32),
+            _mm256_shuffle_epi8(b, m));
+      }
+
+      return i;
+   }
+
+   /* Shuffle the bytes of `src[len]` into `dst[len]` by @a mask, with
+    * the widest shuffle selected by extmath_dispatch(), or none at all.
+    * Returns bytes shuffled; the remainder is left to the caller. */
+   static size_t bswap_shuffle(word8 *dst, const word8 *src, size_t len,
+      const word8 *mask)
+   {
+      unsigned features = extmath_features();
+
+      if (features & CPU_FEATURE_AVX2) return bswap_avx2(dst, src, len, mask);
+      if (features & CPU_FEATURE_SSSE3) {
+         return bswap_ssse3(dst, src, len, mask);
+      }
+
+      return 0;
+   }
+
+/* end x86 SIMD guard */
+#endif
+
+/**
+ * Reverse the bytes of each 32-bit element of `src[count]`, placing
+ * the result in `dst[count]`. Converts arrays between host and
+ * big-endian (network) byte order, on little-endian hosts. Bytes are
+ * shuffled 32 (or 64) at a time, with SSSE3 (or AVX2), where available.
+ * @param dst Pointer to place elements; may equal (but not otherwise
+ * overlap) @a src
+ * @param src Pointer to 32-bit elements, of any alignment
+ * @param count Number of elements
+ * @note Uses SSSE3 or AVX2 kernels, as selected by extmath_dispatch().
+*/
+void bswap32_array(void *dst, const void *src, size_t count)
+{
+   word8 *dp = (word8 *) dst;
+   const word8 *sp = (const word8 *) src;
+   size_t i = 0, len = count * 4;
+   word32 x;
+
+#ifdef EXTLIB_SIMD
+   i = bswap_shuffle(dp, sp, len, Bswap32mask);
+#endif
+   for ( ; i < len; i += 4) {
+      memcpy(&x, sp + i, 4);
+      x = bswap32(x);
+      memcpy(dp + i, &x, 4);
+   }
+}
+
+/**
+ * Reverse the bytes of each 64-bit element of `src[count]`, placing
+ * the result in `dst[count]`. Converts arrays between host and
+ * big-endian (network) byte order, on little-endian hosts. Bytes are
+ * shuffled 32 (or 64) at a time, with SSSE3 (or AVX2), where available.
+ * @param dst Pointer to place elements; may equal (but not otherwise
+ * overlap) @a src
+ * @param src Pointer to 64-bit elements, of any alignment
+ * @param count Number of elements
+ * @note Uses SSSE3 or AVX2 kernels, as selected by extmath_dispatch().
+*/
+void bswap64_array(void *dst, const void *src, size_t count)
+{
+   word8 *dp = (word8 *) dst;
+   const word8 *sp = (const word8 *) src;
+   size_t i = 0, len = count * 8;
+   word32 x[2], y;
+
+#ifdef EXTLIB_SIMD
+   i = bswap_shuffle(dp, sp, len, Bswap64mask);
+#endif
+   for ( ; i < len; i += 8) {
+      memcpy(x, sp + i, 8);
+      y = bswap32(x[0]);
+      x[0] = bswap32(x[1]);
+      x[1] = y;
+      memcpy(dp + i, x, 8);
+   }
+}
+
+/* Get the default PRNG state of the calling thread. The first thread to
+ * use a default state keeps ::RANDSTATE_INITIALIZER, and each following
+ * thread derives a distinct state from its (stream) index. */
+static RANDSTATE *lstate(void)
+{
+   RANDSTATE *sp = &Lstate;
+   word32 stream, x, y, z;
+
+   if (Lstate_ready) return sp;
+   Lstate_ready = 1;
+   stream = atomic_add32(&Lstate_streams, 1);
+   if (stream) {
+      srand32_r(sp, WORD64_C(0xcafef00df01dab1e) ^
+         ((unsigned long long) stream << 32));
+      sp->lcg = rand32_r(sp);
+      x = rand32_r(sp);
+      y = rand32_r(sp);
+      z = rand32_r(sp);
+      srand16_r(sp, x, y, z);
+   }
+
+   return sp;
+}  /* end lstate() */
+
 /**
- * Set the internal state seed for rand16fast().
- * @param x Value to set the internal state seed @a Lseed to.
+ * Set the internal (thread local) state seed for rand16fast().
+ * @param x Value to set the LCG state seed to
 */
 void srand16fast(word32 x)
 {
-   Lseed = x;
+   lstate()->lcg = x;
 }
 
 /**
- * Get the current internal state seed used by rand16fast().
- * @returns Value of internal state seed @a Lseed. */
+ * Get the current internal (thread local) state seed used by
+ * rand16fast().
+ * @returns Value of the LCG state seed. */
 word32 get_rand16fast(void)
 {
-   return Lseed;
+   return lstate()->lcg;
 }
 
 /**
- * Set the internal state seed for rand16().
- * @param x Value to set the internal state seed @a Lseed to
- * @param y Value to set the internal state seed @a Lseed to
- * @param z Value to set the internal state seed @a Lseed to
+ * Set the internal (thread local) state seeds for rand16().
+ * @param x Value to set the LCG state seed to
+ * @param y Value to set the MWC state seed to
+ * @param z Value to set the LFSR state seed to
 */
 void srand16(word32 x, word32 y, word32 z)
 {
-   Lseed2 = x;
-   Lseed3 = y;
-   Lseed4 = z;
+   srand16_r(lstate(), x, y, z);
 }
 
 /**
- * Get the current internal state seeds used by rand16().
- * @param x Pointer to location to place internal state seed @a Lseed2
- * @param y Pointer to location to place internal state seed @a Lseed3
- * @param z Pointer to location to place internal state seed @a Lseed4
+ * Get the current internal (thread local) state seeds used by rand16().
+ * @param x Pointer to location to place the LCG state seed
+ * @param y Pointer to location to place the MWC state seed
+ * @param z Pointer to location to place the LFSR state seed
 */
 void get_rand16(word32 *x, word32 *y, word32 *z)
 {
-   *x = Lseed2;
-   *y = Lseed3;
-   *z = Lseed4;
+   RANDSTATE *sp = lstate();
+
+   *x = sp->kiss[0];
+   *y = sp->kiss[1];
+   *z = sp->kiss[2];
 }
 
 /**
- * Fast 16-bit PRNG using internal state seed @a Lseed.
+ * Fast 16-bit PRNG using the internal (thread local) state.
  * Based on Dr. Marsaglia's Usenet post of a linear
  * congruential generator.
  * @returns Random number range [0, 65535].
@@ -155,74 +347,497 @@ void get_rand16(word32 *x, word32 *y, word32 *z)
 */
 word32 rand16fast(void)
 {
-   Lseed = Lseed * WORD32_C(69069) + WORD32_C(262145);
-
-   return Lseed >> 16;
+   return rand16fast_r(lstate());
 }
 
 /**
- * 16-bit PRNG using internal state seeds @a Lseed2/3/4.
+ * 16-bit PRNG using the internal (thread local) state.
  * Based on Dr. Marsaglia's KISS method. Produces
  * reasonable 16-bit statistical randomness.
  * @returns Random number range [0, 65535].
 */
 word32 rand16(void)
 {
+   return rand16_r(lstate());
+}  /* end rand16() */
+
+/**
+ * 32-bit PRNG using 128-bits of internal (thread local) state.
+ * Based on Xoshiro128** by David Blackman and Sebastiano Vigna.
+ * @returns (word32) value representing a random 32-bit unsigned integer.
+*/
+word32 rand32(void)
+{
+   return rand32_r(lstate());
+}  /* end rand32() */
+
+/**
+ * Generate an internal (thread local) state seed for rand32(), using
+ * a value. State generation based on SplitMix64 by Sebastiano Vigna.
+ * @param x 64-bit unsigned integer value to seed rand32() with
+*/
+void srand32(unsigned long long x)
+{
+   srand32_r(lstate(), x);
+}  /* end srand32() */
+
+/**
+ * Get the default PRNG state of the calling thread. The default state
+ * is used by the non-reentrant PRNG's, such as rand32(). It begins as
+ * ::RANDSTATE_INITIALIZER in the first thread to use one, and as a
+ * distinct (derived) state in every following thread.
+ * @returns Pointer to the default RANDSTATE of the calling thread.
+*/
+RANDSTATE *rand_state(void)
+{
+   return lstate();
+}  /* end rand_state() */
+
+/**
+ * Reentrant 16-bit PRNG, as rand16(), using an explicit @a state.
+ * @param state Pointer to PRNG state
+ * @returns Random number range [0, 65535].
+*/
+word32 rand16_r(RANDSTATE *state)
+{
+   word32 *kiss = state->kiss;
+
    /* linear congruential generator */
-   Lseed2 = Lseed2 * WORD32_C(69069) + WORD32_C(262145);
+   kiss[0] = kiss[0] * WORD32_C(69069) + WORD32_C(262145);
    /* multiply with carry */
-   if(Lseed3 == 0) Lseed3 = WORD32_C(362436069);
-   Lseed3 = WORD32_C(36969) * (Lseed3 & WORD32_C(65535)) + (Lseed3 >> 16);
+   if(kiss[1] == 0) kiss[1] = WORD32_C(362436069);
+   kiss[1] = WORD32_C(36969) * (kiss[1] & WORD32_C(65535)) + (kiss[1] >> 16);
    /* linear-feedback shift register */
-   if(Lseed4 == 0) Lseed4 = WORD32_C(123456789);
-   Lseed4 ^= (Lseed4 << 17);
-   Lseed4 ^= (Lseed4 >> 13);
-   Lseed4 ^= (Lseed4 << 5);
+   if(kiss[2] == 0) kiss[2] = WORD32_C(123456789);
+   kiss[2] ^= (kiss[2] << 17);
+   kiss[2] ^= (kiss[2] >> 13);
+   kiss[2] ^= (kiss[2] << 5);
    /* the KISS method (combination of methods) */
-   return (Lseed2 ^ (Lseed3 << 16) ^ Lseed4) >> 16;
-}  /* end rand16() */
+   return (kiss[0] ^ (kiss[1] << 16) ^ kiss[2]) >> 16;
+}  /* end rand16_r() */
 
 /**
- * 32-bit PRNG using 128-bits of internal state seeds.
- * Based on Xoshiro128** by David Blackman and Sebastiano Vigna.
+ * Reentrant fast 16-bit PRNG, as rand16fast(), using an explicit
+ * @a state.
+ * @param state Pointer to PRNG state
+ * @returns Random number range [0, 65535].
+*/
+word32 rand16fast_r(RANDSTATE *state)
+{
+   state->lcg = state->lcg * WORD32_C(69069) + WORD32_C(262145);
+
+   return state->lcg >> 16;
+}  /* end rand16fast_r() */
+
+/**
+ * Reentrant 32-bit PRNG, as rand32(), using an explicit @a state.
+ * @param state Pointer to PRNG state
  * @returns (word32) value representing a random 32-bit unsigned integer.
 */
-word32 rand32(void)
+word32 rand32_r(RANDSTATE *state)
 {
-	const word32 result = rotl(State128[1] * 5, 7) * 9;
-	const word32 t = State128[1] << 9;
+   word32 *s = state->s128;
+   const word32 result = rotl(s[1] * 5, 7) * 9;
+   const word32 t = s[1] << 9;
 
-	State128[2] ^= State128[0];
-	State128[3] ^= State128[1];
-	State128[1] ^= State128[2];
-	State128[0] ^= State128[3];
+   s[2] ^= s[0];
+   s[3] ^= s[1];
+   s[1] ^= s[2];
+   s[0] ^= s[3];
 
-	State128[2] ^= t;
+   s[2] ^= t;
 
-	State128[3] = rotl(State128[3], 11);
+   s[3] = rotl(s[3], 11);
 
-	return result;
-}  /* end rand32() */
+   return result;
+}  /* end rand32_r() */
 
 /**
- * Generate an internal state seed for rand32(), using a value.
- * State generation based on SplitMix64 by Sebastiano Vigna.
- * @param x 64-bit unsigned integer value to seed rand32() with
+ * Reentrant unbiased bounded 32-bit PRNG, using an explicit @a state.
+ * Uses Lemire's multiply-shift method on rand32_r(), where a division
+ * is only performed on the (rare) chance of a rejected sample.
+ * @param state Pointer to PRNG state
+ * @param bound Exclusive upper bound of random number
+ * @returns Random number range [0, bound), or 0 if @a bound is 0.
 */
-void srand32(unsigned long long x)
+word32 rand32_bound_r(RANDSTATE *state, word32 bound)
+{
+   unsigned long long m;
+   word32 t;
+
+   m = (unsigned long long) rand32_r(state) * bound;
+   if ((word32) m < bound) {
+      /* reject samples below 2^32 % bound */
+      t = (word32) -bound % bound;
+      while ((word32) m < t) {
+         m = (unsigned long long) rand32_r(state) * bound;
+      }
+   }
+
+   return (word32) (m >> 32);
+}  /* end rand32_bound_r() */
+
+/* Multiply 64-bit @a a and @a b, returning high 64 bits of product,
+ * and placing the low 64 bits of product in @a lo. */
+static unsigned long long mul64hi(unsigned long long a,
+   unsigned long long b, unsigned long long *lo)
+{
+#ifdef __SIZEOF_INT128__
+   __extension__ unsigned __int128 m = (unsigned __int128) a * b;
+
+   *lo = (unsigned long long) m;
+   return (unsigned long long) (m >> 64);
+
+#else
+   unsigned long long ll, lh, hl, hh, mid;
+
+   ll = (a & 0xffffffff) * (b & 0xffffffff);
+   lh = (a & 0xffffffff) * (b >> 32);
+   hl = (a >> 32) * (b & 0xffffffff);
+   hh = (a >> 32) * (b >> 32);
+   mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+   *lo = (mid << 32) | (ll & 0xffffffff);
+   return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+
+#endif
+}  /* end mul64hi() */
+
+/**
+ * Reentrant unbiased bounded 64-bit PRNG, using an explicit @a state.
+ * As rand32_bound_r(), with 64-bit random numbers from two consecutive
+ * outputs of rand32_r().
+ * @param state Pointer to PRNG state
+ * @param bound Exclusive upper bound of random number
+ * @returns Random number range [0, bound), or 0 if @a bound is 0.
+*/
+unsigned long long rand64_bound_r(RANDSTATE *state, unsigned long long bound)
+{
+   unsigned long long x, hi, lo, t;
+
+   x = (unsigned long long) rand32_r(state) << 32;
+   hi = mul64hi(x | rand32_r(state), bound, &lo);
+   if (lo < bound) {
+      /* reject samples below 2^64 % bound */
+      t = -bound % bound;
+      while (lo < t) {
+         x = (unsigned long long) rand32_r(state) << 32;
+         hi = mul64hi(x | rand32_r(state), bound, &lo);
+      }
+   }
+
+   return hi;
+}  /* end rand64_bound_r() */
+
+/* Jump a Xoshiro128** state by the polynomial of @a jump. */
+static void rand32_jump_poly(RANDSTATE *state, const word32 jump[4])
+{
+   word32 s0, s1, s2, s3;
+   int i, b;
+
+   s0 = s1 = s2 = s3 = 0;
+   for (i = 0; i < 4; i++) {
+      for (b = 0; b < 32; b++) {
+         if (jump[i] & (WORD32_C(1) << b)) {
+            s0 ^= state->s128[0];
+            s1 ^= state->s128[1];
+            s2 ^= state->s128[2];
+            s3 ^= state->s128[3];
+         }
+         rand32_r(state);
+      }
+   }
+   state->s128[0] = s0;
+   state->s128[1] = s1;
+   state->s128[2] = s2;
+   state->s128[3] = s3;
+}  /* end rand32_jump_poly() */
+
+/* Advance a SplitMix64 state @a x, by Sebastiano Vigna, returning the
+ * next (mixed) output. Consecutive outputs are never both zero. */
+static unsigned long long splitmix64(unsigned long long *x)
 {
    unsigned long long z;
-   z = (x += WORD64_C(0x9e3779b97f4a7c15));
-	z = (z ^ (z >> 30)) * WORD64_C(0xbf58476d1ce4e5b9);
-	z = (z ^ (z >> 27)) * WORD64_C(0x94d049bb133111eb);
-	*((unsigned long long *) State128) = z ^ (z >> 31);
-}  /* end srand32() */
+
+   z = (*x += WORD64_C(0x9e3779b97f4a7c15));
+   z = (z ^ (z >> 30)) * WORD64_C(0xbf58476d1ce4e5b9);
+   z = (z ^ (z >> 27)) * WORD64_C(0x94d049bb133111eb);
+
+   return z ^ (z >> 31);
+}  /* end splitmix64() */
+
+/* x86 SIMD guard */
+#ifdef EXTLIB_SIMD
+
+   /* Generate @a blocks of rand_fill_lanes() output, 4 lanes at a time
+    * (with SSE2), in two interleaved sets. */
+   EXTLIB_ISA("sse2")
+   static void rand_fill_sse2(word32 s[4][RANDFILL_LANES],
+      unsigned char *out, size_t blocks)
+   {
+      __m128i s0[2], s1[2], s2[2], s3[2], r, t;
+      int i;
+
+      for (i = 0; i < 2; i++) {
+         s0[i] = _mm_loadu_si128((const __m128i *) &s[0][i * 4]);
+         s1[i] = _mm_loadu_si128((const __m128i *) &s[1][i * 4]);
+         s2[i] = _mm_loadu_si128((const __m128i *) &s[2][i * 4]);
+         s3[i] = _mm_loadu_si128((const __m128i *) &s[3][i * 4]);
+      }
+      for ( ; blocks; blocks--, out += RANDFILL_BLOCK) {
+         for (i = 0; i < 2; i++) {
+            /* result = rotl(s1 * 5, 7) * 9; multiply by shift and add */
+            r = _mm_add_epi32(s1[i], _mm_slli_epi32(s1[i], 2));
+            r = _mm_or_si128(_mm_slli_epi32(r, 7), _mm_srli_epi32(r, 25));
+            r = _mm_add_epi32(r, _mm_slli_epi32(r, 3));
+            _mm_storeu_si128((__m128i *) &out[i * 16], r);
+            t = _mm_slli_epi32(s1[i], 9);
+            s2[i] = _mm_xor_si128(s2[i], s0[i]);
+            s3[i] = _mm_xor_si128(s3[i], s1[i]);
+            s1[i] = _mm_xor_si128(s1[i], s2[i]);
+            s0[i] = _mm_xor_si128(s0[i], s3[i]);
+            s2[i] = _mm_xor_si128(s2[i], t);
+            s3[i] = _mm_or_si128(_mm_slli_epi32(s3[i], 11),
+               _mm_srli_epi32(s3[i], 21));
+         }
+      }
+      for (i = 0; i < 2; i++) {
+         _mm_storeu_si128((__m128i *) &s[0][i * 4], s0[i]);
+         _mm_storeu_si128((__m128i *) &s[1][i * 4], s1[i]);
+         _mm_storeu_si128((__m128i *) &s[2][i * 4], s2[i]);
+         _mm_storeu_si128((__m128i *) &s[3][i * 4], s3[i]);
+      }
+   }
+
+   /* Generate @a blocks of rand_fill_lanes() output, 8 lanes at a time
+    * (with AVX2). */
+   EXTLIB_ISA("avx2")
+   static void rand_fill_avx2(word32 s[4][RANDFILL_LANES],
+      unsigned char *out, size_t blocks)
+   {
+      __m256i s0, s1, s2, s3, r, t;
+
+      s0 = _mm256_loadu_si256((const __m256i *) s[0]);
+      s1 = _mm256_loadu_si256((const __m256i *) s[1]);
+      s2 = _mm256_loadu_si256((const __m256i *) s[2]);
+      s3 = _mm256_loadu_si256((const __m256i *) s[3]);
+      for ( ; blocks; blocks--, out += RANDFILL_BLOCK) {
+         /* result = rotl(s1 * 5, 7) * 9; multiply by shift and add */
+         r = _mm256_add_epi32(s1, _mm256_slli_epi32(s1, 2));
+         r = _mm256_or_si256(_mm256_slli_epi32(r, 7),
+            _mm256_srli_epi32(r, 25));
+         r = _mm256_add_epi32(r, _mm256_slli_epi32(r, 3));
+         _mm256_storeu_si256((__m256i *) out, r);
+         t = _mm256_slli_epi32(s1, 9);
+         s2 = _mm256_xor_si256(s2, s0);
+         s3 = _mm256_xor_si256(s3, s1);
+         s1 = _mm256_xor_si256(s1, s2);
+         s0 = _mm256_xor_si256(s0, s3);
+         s2 = _mm256_xor_si256(s2, t);
+         s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11),
+            _mm256_srli_epi32(s3, 21));
+      }
+      _mm256_storeu_si256((__m256i *) s[0], s0);
+      _mm256_storeu_si256((__m256i *) s[1], s1);
+      _mm256_storeu_si256((__m256i *) s[2], s2);
+      _mm256_storeu_si256((__m256i *) s[3], s3);
+   }
+
+/* end x86 SIMD guard */
+#endif
+
+/* Generate @a blocks of interleaved output from RANDFILL_LANES lanes of
+ * Xoshiro128** state, `s[word][lane]`, into @a out. Each block holds
+ * one 32-bit output of each lane, in lane order. Uses the widest kernel
+ * selected by extmath_dispatch(). */
+static void rand_fill_lanes(word32 s[4][RANDFILL_LANES],
+   unsigned char *out, size_t blocks)
+{
+   word32 r, t;
+   int i;
+
+#ifdef EXTLIB_SIMD
+   unsigned features = extmath_features();
+
+   if (features & CPU_FEATURE_AVX2) {
+      rand_fill_avx2(s, out, blocks);
+      return;
+   }
+   if (features & CPU_FEATURE_SSE2) {
+      rand_fill_sse2(s, out, blocks);
+      return;
+   }
+#endif
+   for ( ; blocks; blocks--, out += RANDFILL_BLOCK) {
+      for (i = 0; i < RANDFILL_LANES; i++) {
+         r = rotl(s[1][i] * 5, 7) * 9;
+         memcpy(&out[i * 4], &r, 4);
+         t = s[1][i] << 9;
+         s[2][i] ^= s[0][i];
+         s[3][i] ^= s[1][i];
+         s[1][i] ^= s[2][i];
+         s[0][i] ^= s[3][i];
+         s[2][i] ^= t;
+         s[3][i] = rotl(s[3][i], 11);
+      }
+   }
+}  /* end rand_fill_lanes() */
+
+/**
+ * Fill a buffer with @a len random bytes, using an explicit @a state.
+ * Larger buffers are filled by ::RANDFILL_LANES interleaved lanes of
+ * Xoshiro128**, seeded by consecutive SplitMix64 outputs from a 64-bit
+ * seed of rand32_r(), with AVX2 or SSE2 kernels where available.
+ * Output is identical with or without SIMD support.
+ * @param state Pointer to PRNG state
+ * @param buf Pointer to buffer to fill
+ * @param len Length of buffer, in bytes
+ * @note Random words are placed in native byte order.
+*/
+void rand_fill(RANDSTATE *state, void *buf, size_t len)
+{
+   word32 lanes[4][RANDFILL_LANES];
+   unsigned char tail[RANDFILL_BLOCK];
+   unsigned char *out = (unsigned char *) buf;
+   unsigned long long seed, z;
+   size_t blocks;
+   word32 r;
+   int i;
+
+   /* small buffers are not worth seeding lanes for */
+   if (len < RANDFILL_BLOCK * RANDFILL_LANES) {
+      for ( ; len >= 4; len -= 4, out += 4) {
+         r = rand32_r(state);
+         memcpy(out, &r, 4);
+      }
+      if (len) {
+         r = rand32_r(state);
+         memcpy(out, &r, len);
+      }
+      return;
+   }
+
+   /* seed lanes through SplitMix64, such that lanes are not (offset)
+    * copies of one sequence; as srand32_r(), from consecutive seeds */
+   seed = rand32_r(state);
+   seed |= (unsigned long long) rand32_r(state) << 32;
+   for (i = 0; i < RANDFILL_LANES; i++) {
+      z = splitmix64(&seed);
+      lanes[0][i] = (word32) z;
+      lanes[1][i] = (word32) (z >> 32);
+      z = splitmix64(&seed);
+      lanes[2][i] = (word32) z;
+      lanes[3][i] = (word32) (z >> 32);
+   }
+   /* fill whole blocks and any partial block */
+   blocks = len / RANDFILL_BLOCK;
+   rand_fill_lanes(lanes, out, blocks);
+   len -= blocks * RANDFILL_BLOCK;
+   if (len) {
+      rand_fill_lanes(lanes, tail, 1);
+      memcpy(&out[blocks * RANDFILL_BLOCK], tail, len);
+   }
+}  /* end rand_fill() */
+
+/**
+ * Advance the rand32_r() sequence of a @a state by 2^64 calls.
+ * Used to generate 2^64 non-overlapping subsequences, for parallel
+ * computations. Based on Xoshiro128** jump() by Blackman and Vigna.
+ * @param state Pointer to PRNG state
+*/
+void rand32_jump(RANDSTATE *state)
+{
+   static const word32 JUMP[4] =
+      { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+   rand32_jump_poly(state, JUMP);
+}  /* end rand32_jump() */
+
+/**
+ * Advance the rand32_r() sequence of a @a state by 2^96 calls.
+ * Used to generate 2^32 starting points, from each of which
+ * rand32_jump() generates 2^32 non-overlapping subsequences, for
+ * parallel distributed computations. Based on Xoshiro128**
+ * long_jump() by Blackman and Vigna.
+ * @param state Pointer to PRNG state
+*/
+void rand32_long_jump(RANDSTATE *state)
+{
+   static const word32 LONG_JUMP[4] =
+      { 0xb523952e, 0x0b6f099f, 0xccf5a0ef, 0x1c580662 };
+
+   rand32_jump_poly(state, LONG_JUMP);
+}  /* end rand32_long_jump() */
+
+/**
+ * Split a @a state into @a count non-overlapping PRNG streams, such as
+ * for each of a number of worker threads. Each stream is a copy of
+ * @a state, advanced by rand32_jump() for each preceding stream, and
+ * is good for 2^64 calls to rand32_r(). The @a state is advanced past
+ * all streams, such that further splits do not overlap.
+ * @param state Pointer to PRNG state to split
+ * @param streams Pointer to `streams[count]` of PRNG states to split to
+ * @param count Number of PRNG streams to split
+ * @note Only the Xoshiro128** state (for rand32_r() and functions
+ * derived from it) is split. Other generators in each stream begin
+ * from identical states.
+*/
+void rand32_split(RANDSTATE *state, RANDSTATE *streams, size_t count)
+{
+   for ( ; count; count--, streams++) {
+      *streams = *state;
+      rand32_jump(state);
+   }
+}  /* end rand32_split() */
+
+/**
+ * Set the state seeds for rand16_r(), in an explicit @a state.
+ * @param state Pointer to PRNG state
+ * @param x Value to set the LCG state seed to
+ * @param y Value to set the MWC state seed to
+ * @param z Value to set the LFSR state seed to
+*/
+void srand16_r(RANDSTATE *state, word32 x, word32 y, word32 z)
+{
+   state->kiss[0] = x;
+   state->kiss[1] = y;
+   state->kiss[2] = z;
+}  /* end srand16_r() */
+
+/**
+ * Set the state seed for rand16fast_r(), in an explicit @a state.
+ * @param state Pointer to PRNG state
+ * @param x Value to set the LCG state seed to
+*/
+void srand16fast_r(RANDSTATE *state, word32 x)
+{
+   state->lcg = x;
+}  /* end srand16fast_r() */
+
+/**
+ * Generate a state seed for rand32_r(), in an explicit @a state.
+ * The full 128-bit state is generated from two consecutive outputs of
+ * SplitMix64 by Sebastiano Vigna, which never yields an all zero state.
+ * @param state Pointer to PRNG state
+ * @param x 64-bit unsigned integer value to seed rand32_r() with
+*/
+void srand32_r(RANDSTATE *state, unsigned long long x)
+{
+   unsigned long long z;
+   int i;
+
+   for (i = 0; i < 4; i += 2) {
+      z = splitmix64(&x);
+      state->s128[i] = (word32) z;
+      state->s128[i + 1] = (word32) (z >> 32);
+   }
+}  /* end srand32_r() */
 
 /**
  * Shuffle a `list[count]` of @a size byte elements.
  * Uses Durstenfeld's implementation of the Fisher-Yates
  * shuffling algorithm.
- * @note Shuffle @a count is bound to 16 bits due to rand16().
+ * @note Shuffle @a count is bound to 16 bits due to rand16(), and is
+ * biased by the modulo of rand16(). Use shuffle_r() for large lists.
  * @note Set random seed with srand16() before use.
 */
 void shuffle(void *list, size_t size, size_t count)
@@ -240,6 +855,204 @@ void shuffle(void *list, size_t size, size_t count)
    }
 }  /* end shuffle() */
 
+/**
+ * Shuffle a `list[count]` of @a size byte elements, using an explicit
+ * PRNG @a state. Uses Durstenfeld's implementation of the Fisher-Yates
+ * shuffling algorithm, with unbiased random indices from
+ * rand32_bound_r(), or rand64_bound_r() where an index exceeds 32 bits.
+ * @param state Pointer to PRNG state
+ * @param list Pointer to list to shuffle
+ * @param size Size of each list element, in bytes
+ * @param count Number of list elements
+*/
+void shuffle_r(RANDSTATE *state, void *list, size_t size, size_t count)
+{
+   unsigned char *listp = (unsigned char *) list;
+   unsigned char *elemp;
+   size_t idx;
+
+   if (count < 2) return;  /* list is not worth shuffling */
+   elemp = &listp[(count - 1) * size];
+   /* indices beyond 32 bits, only where size_t permits */
+   for ( ; (unsigned long long) count > WORD32_C(0xffffffff);
+      count--, elemp -= size) {
+      idx = (size_t) rand64_bound_r(state, count);
+      memswap(elemp, &listp[idx * size], size);
+   }
+   for ( ; count > 1; count--, elemp -= size) {
+      idx = rand32_bound_r(state, (word32) count);
+      memswap(elemp, &listp[idx * size], size);
+   }
+}  /* end shuffle_r() */
+
+/* Shuffle job of a shuffle_parallel() thread; see shuffle_job(). */
+typedef struct shuffle_job {
+   RANDSTATE state;     /* PRNG stream of thread */
+   RANDSTATE start;     /* PRNG stream at start of bucket assignment */
+   unsigned char *list; /* list to shuffle */
+   unsigned char *temp; /* temporary list, of buckets */
+   size_t *counts;      /* per bucket counts (then offsets) of thread */
+   size_t *starts;      /* bucket starts (in elements), of all threads */
+   size_t size, first, count, buckets, thread, threads;
+   int phase;
+} SHUFFLEJOB;
+
+/* Perform a phase of shuffle_parallel(), per thread. Phase 0 assigns
+ * each element of the thread's part of the list to a random bucket
+ * and counts bucket sizes; phase 1 replays the assignment, scattering
+ * elements to their (offset) buckets in temp; phase 2 copies whole
+ * buckets back to list, shuffling each in (cache sized) isolation. */
+static ThreadProc shuffle_job(void *args)
+{
+   SHUFFLEJOB *job = (SHUFFLEJOB *) args;
+   const size_t size = job->size;
+   unsigned char *elemp;
+   size_t b, i, n;
+
+   switch (job->phase) {
+      case 0:
+         job->start = job->state;
+         memset(job->counts, 0, job->buckets * sizeof(size_t));
+         for (i = 0; i < job->count; i++) {
+            job->counts[rand32_bound_r(&job->state, (word32) job->buckets)]++;
+         }
+         break;
+      case 1:
+         job->state = job->start;
+         elemp = &job->list[job->first * size];
+         for (i = 0; i < job->count; i++, elemp += size) {
+            b = rand32_bound_r(&job->state, (word32) job->buckets);
+            memcpy(&job->temp[job->counts[b]++ * size], elemp, size);
+         }
+         break;
+      case 2:
+         for (b = job->thread; b < job->buckets; b += job->threads) {
+            i = job->starts[b];
+            n = job->starts[b + 1] - i;
+            elemp = &job->list[i * size];
+            memcpy(elemp, &job->temp[i * size], n * size);
+            shuffle_r(&job->state, elemp, size, n);
+         }
+         break;
+   }
+
+   Unthread;
+}  /* end shuffle_job() */
+
+/**
+ * Shuffle a `list[count]` of @a size byte elements, in parallel, using
+ * an explicit PRNG @a state. Elements are scattered to uniformly random
+ * buckets of (roughly) ::SHUFFLE_BLOCK bytes, by multiple threads, and
+ * each bucket is then shuffled by shuffle_r() within cache. The result
+ * is a uniformly random permutation, avoiding the cache miss of every
+ * swap made by shuffle_r() on lists larger than cache.
+ * @param state Pointer to PRNG state
+ * @param list Pointer to list to shuffle
+ * @param size Size of each list element, in bytes
+ * @param count Number of list elements
+ * @param threads Number of threads to use, or 0 for cpu_cores()
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for temporary list
+ * @note Requires temporary memory equal to the size of the list.
+ * @note Results are deterministic for a given @a state and @a threads.
+ * Threads that fail to start have their work done by the calling thread.
+*/
+int shuffle_parallel(RANDSTATE *state, void *list, size_t size,
+   size_t count, int threads)
+{
+   SHUFFLEJOB *jobs;
+   Thread *tids;
+   size_t *counts, *starts;
+   unsigned char *temp;
+   size_t buckets, per, b, c, offset;
+   int t, n, phase;
+
+   /* sanity checks */
+   if (state == NULL || (list == NULL && count)) goto FAIL_INVAL;
+   if (size == 0 || threads < 0) goto FAIL_INVAL;
+
+   /* lists within a single bucket are shuffled in place */
+   per = SHUFFLE_BLOCK / size;
+   if (per == 0) per = 1;
+   if (count < 2 || count <= per) {
+      shuffle_r(state, list, size, count);
+      return 0;
+   }
+   if (count > ((size_t) -1) / size) goto FAIL_INVAL;
+   if (threads == 0) {
+      threads = cpu_cores();
+      if (threads < 1) threads = 1;
+   }
+   buckets = (count / per) + 1;
+   if (buckets > WORD32_C(0xffffffff)) buckets = WORD32_C(0xffffffff);
+
+   /* allocate temporary list, jobs and bucket tables */
+   temp = malloc(count * size);
+   if (temp == NULL) goto FAIL_NOMEM;
+   jobs = malloc(threads * (sizeof(SHUFFLEJOB) + sizeof(Thread)));
+   if (jobs == NULL) goto FAIL_JOBS;
+   tids = (Thread *) &jobs[threads];
+   counts = malloc(((threads * buckets) + buckets + 1) * sizeof(size_t));
+   if (counts == NULL) goto FAIL_COUNTS;
+   starts = &counts[threads * buckets];
+
+   /* split list and PRNG streams among threads */
+   for (t = 0; t < threads; t++) {
+      rand32_split(state, &jobs[t].state, 1);
+      jobs[t].list = (unsigned char *) list;
+      jobs[t].temp = temp;
+      jobs[t].counts = &counts[t * buckets];
+      jobs[t].starts = starts;
+      jobs[t].size = size;
+      jobs[t].first = (count / threads) * t;
+      jobs[t].count = (t + 1 < threads) ? count / threads
+         : count - jobs[t].first;
+      jobs[t].buckets = buckets;
+      jobs[t].thread = (size_t) t;
+      jobs[t].threads = (size_t) threads;
+   }
+
+   for (phase = 0; phase < 3; phase++) {
+      for (t = 0; t < threads; t++) jobs[t].phase = phase;
+      for (n = 0; threads > 1 && n < threads; n++) {
+         if (thread_create(&tids[n], shuffle_job, &jobs[n]) != 0) break;
+      }
+      /* run jobs of any threads not created in the calling thread */
+      for (t = n; t < threads; t++) shuffle_job(&jobs[t]);
+      for (t = 0; t < n; t++) thread_join(tids[t]);
+      if (phase) continue;
+      /* convert counts to offsets; buckets are contiguous in temp */
+      for (offset = b = 0; b < buckets; b++) {
+         starts[b] = offset;
+         for (t = 0; t < threads; t++) {
+            c = jobs[t].counts[b];
+            jobs[t].counts[b] = offset;
+            offset += c;
+         }
+      }
+      starts[buckets] = offset;
+   }
+
+   free(counts);
+   free(jobs);
+   free(temp);
+
+   return 0;
+
+   /* error handling */
+FAIL_INVAL:
+   set_errno(EINVAL);
+   return (-1);
+FAIL_COUNTS:
+   free(jobs);
+FAIL_JOBS:
+   free(temp);
+FAIL_NOMEM:
+   set_errno(ENOMEM);
+   return (-1);
+}  /* end shuffle_parallel() */
+
 /**
  * Shuffle a `list[count]` of non-zero, @a size byte elements.
  * A zero value marks the end of list, and shuffling does
@@ -347,6 +1160,7 @@ void *bsearch_len(const void *key, size_t len,
    int cond;
 
    /* init */
+   if (count == 0) return NULL;
    hi = count - 1;
    lo = 0;
 
@@ -358,7 +1172,11 @@ void *bsearch_len(const void *key, size_t len,
       /* adjust and repeat -- find first occurrence */
       if (cond == 0) return data;
       if (lo == hi) break;
-      if (cond < 0) hi = mid - 1; else lo = mid + 1;
+      if (cond < 0) {
+         /* avoid underflow of hi */
+         if (mid == lo) break;
+         hi = mid - 1;
+      } else lo = mid + 1;
    }  /* end while */
 
    return NULL;
@@ -418,6 +1236,8 @@ int filesort(const char *filename, size_t size, size_t blocksz,
          /* perform sort on buffer data, write to output */
          if (in > 1) qsort(buffer, in, size, comp);
          if (fwrite(buffer, size, in, ofp) != in) goto FAIL1;
+         /* reposition stream between write and (next) read */
+         if (fseek(ofp, 0, SEEK_CUR) != 0) goto FAIL1;
       }
    }
    /* cleanup */
@@ -519,42 +1339,475 @@ FAIL1:
    return (-1);
 }  /* end filesort() */
 
-/**
- * Append a DLLIST of DLNODE's to another DLLIST.
- * @param srcp Pointer to source list
- * @param dstp Pointer to destination list
- * @returns 0 on success, or non-zero on error. Check errno for details.
- * @exception errno=ENOLINK One of the provided lists has missing links
- * @exception errno=EINVAL One of the supplied pointers is NULL
-*/
-int dllist_append(DLLIST *srcp, DLLIST *dstp)
+/* Pointer to element @a i of a HEAP; element `capacity` is scratch */
+#define HEAP_ELEM(hp, i)   ( &(hp)->data[(i) * (hp)->size] )
+#define HEAP_SCRATCH(hp)   HEAP_ELEM(hp, (hp)->capacity)
+#define HEAP_NONE          ( (size_t) -1 )
+
+/* Compare two HEAP elements, by comparator or inline 64-bit key. */
+static int heap_cmp(const HEAP *hp, const void *a, const void *b)
 {
-   /* sanity checks on parameters -- acquire lock when available */
-   if (srcp == NULL || dstp == NULL) goto FAIL_INVAL;
+   word64 ka, kb;
 
-   /* determine state of destination list... */
-   if (dstp->last) {
-      /* ... append list mode -- validate source list */
-      if (srcp->next) {
-         if (srcp->last) {
-            /* join next/last linkages -- add count */
-            srcp->next->prev = dstp->last;
-            dstp->last->next = srcp->next;
-            dstp->last = srcp->last;
-            dstp->count += srcp->count;
-            /* clear source list */
-            srcp->next = srcp->last = NULL;
-            srcp->count = 0;
-         } else goto FAIL_NOLINK;
-      } else if (srcp->last) goto FAIL_NOLINK;
-   } else if (dstp->next == NULL) {
-      /* ... new list mode -- set linkage and count */
-      dstp->next = srcp->next;
-      dstp->last = srcp->last;
-      dstp->count = srcp->count;
-      /* clear source list */
-      srcp->next = srcp->last = NULL;
-      srcp->count = 0;
+   if (hp->comp) return hp->comp(a, b);
+   memcpy(&ka, (const unsigned char *) a + hp->keyoff, sizeof(ka));
+   memcpy(&kb, (const unsigned char *) b + hp->keyoff, sizeof(kb));
+
+   return (ka > kb) - (ka < kb);
+}  /* end heap_cmp() */
+
+/* Place the scratch element (of @a handle) at position @a i. */
+static void heap_place(HEAP *hp, size_t i, size_t handle)
+{
+   memcpy(HEAP_ELEM(hp, i), HEAP_SCRATCH(hp), hp->size);
+   hp->hnd[i] = handle;
+   hp->pos[handle] = i;
+}  /* end heap_place() */
+
+/* Move the element at position @a src to position @a dst. */
+static void heap_move(HEAP *hp, size_t dst, size_t src)
+{
+   memcpy(HEAP_ELEM(hp, dst), HEAP_ELEM(hp, src), hp->size);
+   hp->hnd[dst] = hp->hnd[src];
+   hp->pos[hp->hnd[dst]] = dst;
+}  /* end heap_move() */
+
+/* Sift the scratch element (of @a handle) down from position @a i.
+ * Children are moved up into the "hole", rather than swapped. */
+static void heap_siftdown(HEAP *hp, size_t i, size_t handle)
+{
+   size_t child, least, end;
+
+   for ( ; (child = (i * HEAP_ARITY) + 1) < hp->count; i = least) {
+      end = child + HEAP_ARITY;
+      if (end > hp->count) end = hp->count;
+      for (least = child++; child < end; child++) {
+         if (heap_cmp(hp, HEAP_ELEM(hp, child), HEAP_ELEM(hp, least)) < 0) {
+            least = child;
+         }
+      }
+      if (heap_cmp(hp, HEAP_ELEM(hp, least), HEAP_SCRATCH(hp)) >= 0) break;
+      heap_move(hp, i, least);
+   }
+   heap_place(hp, i, handle);
+}  /* end heap_siftdown() */
+
+/* Sift the scratch element (of @a handle) up from position @a i.
+ * Parents are moved down into the "hole", rather than swapped. */
+static void heap_siftup(HEAP *hp, size_t i, size_t handle)
+{
+   size_t parent;
+
+   for ( ; i > 0; i = parent) {
+      parent = (i - 1) / HEAP_ARITY;
+      if (heap_cmp(hp, HEAP_SCRATCH(hp), HEAP_ELEM(hp, parent)) >= 0) break;
+      heap_move(hp, i, parent);
+   }
+   heap_place(hp, i, handle);
+}  /* end heap_siftup() */
+
+/* Reserve capacity in a HEAP for, at least, @a count elements. */
+static int heap_reserve(HEAP *hp, size_t count)
+{
+   unsigned char *data;
+   size_t *pos, *hnd;
+   size_t capacity;
+
+   if (count <= hp->capacity) return 0;
+   for (capacity = hp->capacity ? hp->capacity : 16; capacity < count; ) {
+      if (capacity > (((size_t) -1) >> 2)) goto FAIL_NOMEM;
+      capacity <<= 1;
+   }
+   if (capacity >= ((size_t) -1) / hp->size) goto FAIL_NOMEM;
+   if (capacity > ((size_t) -1) / sizeof(size_t)) goto FAIL_NOMEM;
+
+   /* data includes a scratch element; reallocate one by one */
+   data = realloc(hp->data, (capacity + 1) * hp->size);
+   if (data == NULL) goto FAIL_NOMEM;
+   hp->data = data;
+   pos = realloc(hp->pos, capacity * sizeof(size_t));
+   if (pos == NULL) goto FAIL_NOMEM;
+   hp->pos = pos;
+   hnd = realloc(hp->hnd, capacity * sizeof(size_t));
+   if (hnd == NULL) goto FAIL_NOMEM;
+   hp->hnd = hnd;
+   hp->capacity = capacity;
+
+   return 0;
+
+/* error handling */
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end heap_reserve() */
+
+/* Assign a handle, reusing handles of popped or removed elements. */
+static size_t heap_handle(HEAP *hp)
+{
+   size_t handle;
+
+   if (hp->free == HEAP_NONE) return hp->handles++;
+   handle = hp->free;
+   hp->free = hp->pos[handle];
+
+   return handle;
+}  /* end heap_handle() */
+
+/* Remove the element at position @a i of a HEAP, into @a elem. */
+static void heap_take(HEAP *hp, size_t i, void *elem)
+{
+   size_t handle, last;
+
+   /* release handle of taken element */
+   handle = hp->hnd[i];
+   hp->pos[handle] = hp->free;
+   hp->free = handle;
+   if (elem) memcpy(elem, HEAP_ELEM(hp, i), hp->size);
+
+   /* fill the gap with the last element */
+   last = --hp->count;
+   if (i == last) return;
+   memcpy(HEAP_SCRATCH(hp), HEAP_ELEM(hp, last), hp->size);
+   handle = hp->hnd[last];
+   if (i > 0 && heap_cmp(hp, HEAP_SCRATCH(hp),
+         HEAP_ELEM(hp, (i - 1) / HEAP_ARITY)) < 0) {
+      heap_siftup(hp, i, handle);
+   } else heap_siftdown(hp, i, handle);
+}  /* end heap_take() */
+
+/* Check a @a handle refers to an element in a HEAP. */
+static int heap_valid(const HEAP *hp, size_t handle)
+{
+   if (handle >= hp->handles) return 0;
+   if (hp->pos[handle] >= hp->count) return 0;
+
+   return hp->hnd[hp->pos[handle]] == handle;
+}  /* end heap_valid() */
+
+/**
+ * Build a HEAP from a `list[count]` of elements. Elements are added to
+ * any existing elements, and the heap property is restored for all
+ * elements at once, in O(n) time, rather than O(n log n) time for
+ * pushing elements individually.
+ * @param hp Pointer to heap
+ * @param list Pointer to list of elements to add
+ * @param count Number of elements in list
+ * @param handles Pointer to place `handles[count]` of added elements,
+ * or NULL to discard handles
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for heap growth
+*/
+int heap_build(HEAP *hp, const void *list, size_t count, size_t *handles)
+{
+   size_t i, handle;
+
+   if (hp == NULL || (list == NULL && count)) goto FAIL_INVAL;
+   if (hp->count + count < count) goto FAIL_INVAL;
+   if (heap_reserve(hp, hp->count + count) != 0) return (-1);
+
+   /* append elements, then sift down every parent, last to first */
+   if (count) memcpy(HEAP_ELEM(hp, hp->count), list, count * hp->size);
+   for (i = 0; i < count; i++) {
+      handle = heap_handle(hp);
+      hp->hnd[hp->count + i] = handle;
+      hp->pos[handle] = hp->count + i;
+      if (handles) handles[i] = handle;
+   }
+   hp->count += count;
+   for (i = hp->count / HEAP_ARITY + 1; i--; ) {
+      if ((i * HEAP_ARITY) + 1 >= hp->count) continue;
+      memcpy(HEAP_SCRATCH(hp), HEAP_ELEM(hp, i), hp->size);
+      heap_siftdown(hp, i, hp->hnd[i]);
+   }
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end heap_build() */
+
+/**
+ * Destroy (deallocate) the elements and handles of a HEAP.
+ * @param hp Pointer to heap to destroy
+*/
+void heap_destroy(HEAP *hp)
+{
+   if (hp->data) free(hp->data);
+   if (hp->pos) free(hp->pos);
+   if (hp->hnd) free(hp->hnd);
+   hp->data = NULL;
+   hp->pos = hp->hnd = NULL;
+   hp->count = hp->capacity = hp->handles = 0;
+   hp->free = HEAP_NONE;
+}  /* end heap_destroy() */
+
+/**
+ * Initialize a HEAP of @a size byte elements. Elements are ordered by
+ * @a comp, as with qsort(), or if @a comp is NULL, by a native 64-bit
+ * unsigned key at offset @a keyoff of each element, which avoids the
+ * overhead of a function call per comparison. The least element is at
+ * the top of the heap. To prevent a memory leak, use heap_destroy()
+ * before discarding an initialized heap.
+ * @param hp Pointer to heap to initialize
+ * @param size Size of each element, in bytes
+ * @param count Number of elements to reserve capacity for
+ * @param comp Pointer to comparison function, or NULL for inline keys
+ * @param keyoff Offset of inline key in each element (if @a comp is NULL)
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for heap
+*/
+int heap_init(HEAP *hp, size_t size, size_t count,
+   int (*comp)(const void *, const void *), size_t keyoff)
+{
+   /* sanity checks */
+   if (hp == NULL || size == 0) goto FAIL_INVAL;
+   if (comp == NULL && (keyoff > size || size - keyoff < 8)) goto FAIL_INVAL;
+
+   memset(hp, 0, sizeof(*hp));
+   hp->size = size;
+   hp->free = HEAP_NONE;
+   hp->keyoff = keyoff;
+   hp->comp = comp;
+
+   return heap_reserve(hp, count ? count : 1);
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end heap_init() */
+
+/**
+ * Peek at the top (least) element of a HEAP.
+ * @param hp Pointer to heap
+ * @returns Pointer to top element, or NULL if heap is empty.
+ * @note A pointer to an element is valid ONLY until the next
+ * modification of the heap.
+*/
+void *heap_peek(HEAP *hp)
+{
+   return hp->count ? HEAP_ELEM(hp, 0) : NULL;
+}  /* end heap_peek() */
+
+/**
+ * Pop the top (least) element from a HEAP. The handle of the popped
+ * element is released for reuse.
+ * @param hp Pointer to heap
+ * @param elem Pointer to place popped element, or NULL to discard
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOLINK The heap is empty
+*/
+int heap_pop(HEAP *hp, void *elem)
+{
+   if (hp == NULL) goto FAIL_INVAL;
+   if (hp->count == 0) goto FAIL_NOLINK;
+
+   heap_take(hp, 0, elem);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOLINK: set_errno(ENOLINK); return (-1);
+}  /* end heap_pop() */
+
+/**
+ * Push an element onto a HEAP.
+ * @param hp Pointer to heap
+ * @param elem Pointer to element to push
+ * @param handle Pointer to place handle of pushed element, or NULL
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for heap growth
+*/
+int heap_push(HEAP *hp, const void *elem, size_t *handle)
+{
+   size_t h;
+
+   if (hp == NULL || elem == NULL) goto FAIL_INVAL;
+   if (heap_reserve(hp, hp->count + 1) != 0) return (-1);
+
+   h = heap_handle(hp);
+   if (handle) *handle = h;
+   memcpy(HEAP_SCRATCH(hp), elem, hp->size);
+   heap_siftup(hp, hp->count++, h);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end heap_push() */
+
+/**
+ * Remove the element of a @a handle from a HEAP. The handle is
+ * released for reuse.
+ * @param hp Pointer to heap
+ * @param handle Handle of element to remove
+ * @param elem Pointer to place removed element, or NULL to discard
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOENT The handle does not refer to an element
+*/
+int heap_remove(HEAP *hp, size_t handle, void *elem)
+{
+   if (hp == NULL) goto FAIL_INVAL;
+   if (!heap_valid(hp, handle)) goto FAIL_NOENT;
+
+   heap_take(hp, hp->pos[handle], elem);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOENT: set_errno(ENOENT); return (-1);
+}  /* end heap_remove() */
+
+/**
+ * Update the element of a @a handle in a HEAP, and restore its place
+ * in the heap. A "decrease-key" operation sifts the element up, while
+ * an "increase-key" operation sifts the element down.
+ * @param hp Pointer to heap
+ * @param handle Handle of element to update
+ * @param elem Pointer to updated element
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOENT The handle does not refer to an element
+*/
+int heap_update(HEAP *hp, size_t handle, const void *elem)
+{
+   size_t i;
+
+   if (hp == NULL || elem == NULL) goto FAIL_INVAL;
+   if (!heap_valid(hp, handle)) goto FAIL_NOENT;
+
+   i = hp->pos[handle];
+   memcpy(HEAP_SCRATCH(hp), elem, hp->size);
+   if (i > 0 && heap_cmp(hp, HEAP_SCRATCH(hp),
+         HEAP_ELEM(hp, (i - 1) / HEAP_ARITY)) < 0) {
+      heap_siftup(hp, i, handle);
+   } else heap_siftdown(hp, i, handle);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOENT: set_errno(ENOENT); return (-1);
+}  /* end heap_update() */
+
+/* Linked node accessors, for DLNODE's and SLNODE's; both have a next
+ * pointer as their first member, and a data pointer at @a off. Access
+ * is by memcpy(), which is alias-safe across both node types. */
+static void *llist_next(const void *np)
+{
+   void *next;
+
+   memcpy(&next, np, sizeof(next));
+
+   return next;
+}  /* end llist_next() */
+
+static void llist_link(void *np, void *next)
+{
+   memcpy(np, &next, sizeof(next));
+}  /* end llist_link() */
+
+static void *llist_data(const void *np, size_t off)
+{
+   void *data;
+
+   memcpy(&data, (const char *) np + off, sizeof(data));
+
+   return data;
+}  /* end llist_data() */
+
+/* Merge two sorted, NULL terminated chains of nodes (by next pointer).
+ * Nodes of @a a precede equal nodes of @a b, for a stable merge. */
+static void *llist_merge(void *a, void *b, size_t off,
+   int (*comp)(const void *, const void *))
+{
+   void *head, *tail, *np;
+
+   for (head = tail = NULL; a && b; tail = np) {
+      if (comp(llist_data(a, off), llist_data(b, off)) <= 0) {
+         np = a;
+         a = llist_next(a);
+      } else {
+         np = b;
+         b = llist_next(b);
+      }
+      if (tail) llist_link(tail, np);
+      else head = np;
+   }
+   np = a ? a : b;
+   if (tail) llist_link(tail, np);
+   else head = np;
+
+   return head;
+}  /* end llist_merge() */
+
+/* Stable merge sort a NULL terminated chain of nodes (by next pointer).
+ * Bottom-up; sorted sublists of 2^i nodes are held in pending[i] and
+ * merged as a binary counter, requiring no recursion or allocation. */
+static void *llist_sort(void *head, size_t off,
+   int (*comp)(const void *, const void *))
+{
+   void *pending[sizeof(size_t) * 8] = { 0 };
+   void *np;
+   size_t i;
+
+   while (head) {
+      np = head;
+      head = llist_next(head);
+      llist_link(np, NULL);
+      /* earlier nodes are pending, for stability */
+      for (i = 0; pending[i]; i++) {
+         np = llist_merge(pending[i], np, off, comp);
+         pending[i] = NULL;
+      }
+      pending[i] = np;
+   }
+   for (np = NULL, i = 0; i < sizeof(pending) / sizeof(*pending); i++) {
+      if (pending[i]) np = llist_merge(pending[i], np, off, comp);
+   }
+
+   return np;
+}  /* end llist_sort() */
+
+/**
+ * Append a DLLIST of DLNODE's to another DLLIST.
+ * @param srcp Pointer to source list
+ * @param dstp Pointer to destination list
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=ENOLINK One of the provided lists has missing links
+ * @exception errno=EINVAL One of the supplied pointers is NULL
+*/
+int dllist_append(DLLIST *srcp, DLLIST *dstp)
+{
+   /* sanity checks on parameters -- acquire lock when available */
+   if (srcp == NULL || dstp == NULL) goto FAIL_INVAL;
+
+   /* determine state of destination list... */
+   if (dstp->last) {
+      /* ... append list mode -- validate source list */
+      if (srcp->next) {
+         if (srcp->last) {
+            /* join next/last linkages -- add count */
+            srcp->next->prev = dstp->last;
+            dstp->last->next = srcp->next;
+            dstp->last = srcp->last;
+            dstp->count += srcp->count;
+            /* clear source list */
+            srcp->next = srcp->last = NULL;
+            srcp->count = 0;
+         } else goto FAIL_NOLINK;
+      } else if (srcp->last) goto FAIL_NOLINK;
+   } else if (dstp->next == NULL) {
+      /* ... new list mode -- set linkage and count */
+      dstp->next = srcp->next;
+      dstp->last = srcp->last;
+      dstp->count = srcp->count;
+      /* clear source list */
+      srcp->next = srcp->last = NULL;
+      srcp->count = 0;
    } else goto FAIL_NOLINK;
 
    return 0;
@@ -564,6 +1817,124 @@ FAIL_INVAL: set_errno(EINVAL); return (-1);
 FAIL_NOLINK: set_errno(ENOLINK); return (-1);
 }  /* end dllist_append() */
 
+/**
+ * Sort a DLLIST, in place, by the data of its DLNODE's. The sort is a
+ * stable merge sort, requiring no allocation; only node linkage is
+ * modified.
+ * @param listp Pointer to list to sort
+ * @param comp Pointer to comparison function, which is passed the
+ * data pointers of two nodes, as with qsort()
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL One of the supplied pointers is NULL
+*/
+int dllist_sort(DLLIST *listp, int (*comp)(const void *, const void *))
+{
+   DLNODE *nodep, *prevp;
+
+   if (listp == NULL || comp == NULL) goto FAIL_INVAL;
+
+   /* sort by next linkage, then restore prev linkage */
+   listp->next = llist_sort(listp->next, offsetof(DLNODE, data), comp);
+   for (prevp = NULL, nodep = listp->next; nodep; nodep = nodep->next) {
+      nodep->prev = prevp;
+      prevp = nodep;
+   }
+   listp->last = prevp;
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end dllist_sort() */
+
+/**
+ * Splice a range of DLNODE's from one DLLIST into another DLLIST (or
+ * elsewhere in the same DLLIST). The range of nodes, from @a firstp to
+ * @a lastp (inclusive), are moved in a constant number of operations,
+ * when the number of nodes in the range is known.
+ * @param dstp Pointer to list to splice nodes to
+ * @param posp Pointer to node (of @a dstp) to splice nodes before,
+ * or NULL to splice nodes to the end of the list
+ * @param srcp Pointer to list to splice nodes from
+ * @param firstp Pointer to first node (of @a srcp) of range
+ * @param lastp Pointer to last node (of @a srcp) of range
+ * @param count Number of nodes in range, or -1 to count nodes
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=ENOLINK The provided lists have missing links
+ * @exception errno=EINVAL One of the supplied pointers is NULL
+ * @note @a posp MUST NOT be within the range of nodes.
+*/
+int dllist_splice(DLLIST *dstp, DLNODE *posp, DLLIST *srcp,
+   DLNODE *firstp, DLNODE *lastp, int count)
+{
+   DLNODE *nodep;
+
+   if (dstp == NULL || srcp == NULL) goto FAIL_INVAL;
+   if (firstp == NULL || lastp == NULL) goto FAIL_INVAL;
+   /* validate linkage before modification; non-first nodes SHOULD HAVE
+    * "prev" linkage, and non-last nodes SHOULD HAVE "next" linkage */
+   if (posp && posp != dstp->next && posp->prev == NULL) goto FAIL_NOLINK;
+   if (firstp != srcp->next && firstp->prev == NULL) goto FAIL_NOLINK;
+   if (lastp != srcp->last && lastp->next == NULL) goto FAIL_NOLINK;
+
+   if (count < 0) {
+      for (count = 1, nodep = firstp; nodep != lastp; count++) {
+         nodep = nodep->next;
+         if (nodep == NULL) goto FAIL_NOLINK;
+      }
+   }
+
+   /* detach range from source list */
+   if (firstp == srcp->next) srcp->next = lastp->next;
+   else firstp->prev->next = lastp->next;
+   if (lastp == srcp->last) srcp->last = firstp->prev;
+   else lastp->next->prev = firstp->prev;
+   srcp->count -= count;
+
+   /* attach range to destination list */
+   if (posp == NULL) {
+      firstp->prev = dstp->last;
+      if (dstp->last) dstp->last->next = firstp;
+      else dstp->next = firstp;
+      dstp->last = lastp;
+   } else {
+      firstp->prev = posp->prev;
+      if (posp == dstp->next) dstp->next = firstp;
+      else posp->prev->next = firstp;
+      posp->prev = lastp;
+   }
+   lastp->next = posp;
+   dstp->count += count;
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOLINK: set_errno(ENOLINK); return (-1);
+}  /* end dllist_splice() */
+
+/**
+ * Split a DLLIST at a DLNODE. The node, and all following nodes, are
+ * moved to the end of another DLLIST. Requires counting moved nodes.
+ * @param srcp Pointer to list to split
+ * @param nodep Pointer to node (of @a srcp) to split list at
+ * @param dstp Pointer to list to move nodes to
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=ENOLINK The provided lists have missing links
+ * @exception errno=EINVAL One of the supplied pointers is NULL
+*/
+int dllist_split(DLLIST *srcp, DLNODE *nodep, DLLIST *dstp)
+{
+   if (srcp == NULL || nodep == NULL || dstp == NULL) goto FAIL_INVAL;
+   if (srcp->last == NULL) goto FAIL_NOLINK;
+
+   return dllist_splice(dstp, NULL, srcp, nodep, srcp->last, -1);
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOLINK: set_errno(ENOLINK); return (-1);
+}  /* end dllist_split() */
+
 /**
  * Append a DLNODE to a DLList.
  * @param nodep Pointer to node to append
@@ -701,6 +2072,61 @@ FAIL_INVAL: set_errno(EINVAL); return (-1);
 FAIL_NOLINK: set_errno(ENOLINK); return (-1);
 }  /* end dlnode_remove() */
 
+/**
+ * Sort a SLLIST, in place, by the data of its SLNODE's. The sort is a
+ * stable merge sort, requiring no allocation; only node linkage is
+ * modified.
+ * @param listp Pointer to list to sort
+ * @param comp Pointer to comparison function, which is passed the
+ * data pointers of two nodes, as with qsort()
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL One of the supplied pointers is NULL
+*/
+int sllist_sort(SLLIST *listp, int (*comp)(const void *, const void *))
+{
+   if (listp == NULL || comp == NULL) {
+      set_errno(EINVAL);
+      return (-1);
+   }
+
+   listp->next = llist_sort(listp->next, offsetof(SLNODE, data), comp);
+
+   return 0;
+}  /* end sllist_sort() */
+
+/**
+ * Split a SLLIST after a SLNODE. All nodes following the node are
+ * moved to another (empty) SLLIST. Requires counting moved nodes.
+ * @param srcp Pointer to list to split
+ * @param nodep Pointer to node (of @a srcp) to split list after
+ * @param dstp Pointer to (empty) list to move nodes to
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=ENOLINK The destination list is not empty
+ * @exception errno=EINVAL One of the supplied pointers is NULL
+*/
+int sllist_split(SLLIST *srcp, SLNODE *nodep, SLLIST *dstp)
+{
+   SLNODE *np;
+   int count;
+
+   if (srcp == NULL || nodep == NULL || dstp == NULL) {
+      set_errno(EINVAL);
+      return (-1);
+   } else if (dstp->next) {
+      set_errno(ENOLINK);
+      return (-1);
+   }
+
+   /* move following nodes -- transfer count */
+   for (count = 0, np = nodep->next; np; np = np->next) count++;
+   dstp->next = nodep->next;
+   dstp->count = count;
+   nodep->next = NULL;
+   srcp->count -= count;
+
+   return 0;
+}  /* end sllist_split() */
+
 /**
  * Create a SLNODE and associated data (via malloc).
  * To prevent a memory leak, use slnode_destroy() before discarding.
@@ -792,5 +2218,234 @@ int slnode_push(SLNODE *nodep, SLLIST *listp)
    return 0;
 }  /* end slnode_push() */
 
+/* Release the element data buffer of a VECTOR, per its ownership. */
+static void vector_release(VECTOR *vp)
+{
+   if (vp->data == NULL) return;
+   if (vp->owner == VECTOR_OWNED) free(vp->data);
+   else if (vp->owner == VECTOR_MAPPED) {
+      munmap(vp->data, vp->capacity * vp->size);
+   }
+}  /* end vector_release() */
+
+/**
+ * Adopt an existing buffer of elements as the data of a VECTOR,
+ * without copying. Any existing data of the vector is released.
+ * @param vp Pointer to vector
+ * @param buf Pointer to buffer of elements to adopt
+ * @param size Size of each element, in bytes
+ * @param count Number of elements in buffer
+ * @param capacity Number of elements the buffer can hold
+ * @param owner Ownership of buffer; one of ::VECTOR_OWNED (buffer was
+ * allocated with malloc()), ::VECTOR_BORROWED (buffer remains owned by
+ * the caller) or ::VECTOR_MAPPED (buffer was mapped with mmap())
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+*/
+int vector_adopt(VECTOR *vp, void *buf, size_t size, size_t count,
+   size_t capacity, int owner)
+{
+   /* sanity checks */
+   if (vp == NULL || size == 0 || count > capacity) goto FAIL_INVAL;
+   if (buf == NULL && capacity) goto FAIL_INVAL;
+   if (owner < VECTOR_OWNED || owner > VECTOR_MAPPED) goto FAIL_INVAL;
+
+   vector_release(vp);
+   vp->data = (unsigned char *) buf;
+   vp->size = size;
+   vp->count = count;
+   vp->capacity = capacity;
+   vp->owner = owner;
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end vector_adopt() */
+
+/**
+ * Append a `elems[count]` of elements to a VECTOR.
+ * @param vp Pointer to vector
+ * @param elems Pointer to elements to append, or NULL for zero elements
+ * @param count Number of elements to append
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for vector growth
+*/
+int vector_append(VECTOR *vp, const void *elems, size_t count)
+{
+   unsigned char *dst;
+
+   if (vp == NULL) goto FAIL_INVAL;
+   if (vp->count + count < count) goto FAIL_NOMEM;
+   if (vector_reserve(vp, vp->count + count) != 0) return (-1);
+
+   dst = &vp->data[vp->count * vp->size];
+   if (elems) memcpy(dst, elems, count * vp->size);
+   else if (count) memset(dst, 0, count * vp->size);
+   vp->count += count;
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end vector_append() */
+
+/**
+ * Destroy (release) the element data of a VECTOR, per its ownership.
+ * @param vp Pointer to vector to destroy
+*/
+void vector_destroy(VECTOR *vp)
+{
+   vector_release(vp);
+   vp->data = NULL;
+   vp->count = vp->capacity = 0;
+   vp->owner = VECTOR_OWNED;
+}  /* end vector_destroy() */
+
+/**
+ * Get a pointer to element @a idx of a VECTOR.
+ * @param vp Pointer to vector
+ * @param idx Index of element
+ * @returns Pointer to element, or NULL if @a idx is out of range.
+ * @note A pointer to an element is valid ONLY until the next growth
+ * of the vector, which may move its elements.
+*/
+void *vector_get(VECTOR *vp, size_t idx)
+{
+   if (idx >= vp->count) return NULL;
+
+   return &vp->data[idx * vp->size];
+}  /* end vector_get() */
+
+/**
+ * Initialize an (owned) VECTOR of @a size byte elements. To prevent a
+ * memory leak, use vector_destroy() before discarding a vector.
+ * @param vp Pointer to vector to initialize
+ * @param size Size of each element, in bytes
+ * @param count Number of elements to reserve capacity for
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for vector
+*/
+int vector_init(VECTOR *vp, size_t size, size_t count)
+{
+   /* sanity checks */
+   if (vp == NULL || size == 0) goto FAIL_INVAL;
+
+   memset(vp, 0, sizeof(*vp));
+   vp->size = size;
+   vp->owner = VECTOR_OWNED;
+
+   return vector_reserve(vp, count);
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end vector_init() */
+
+/**
+ * Reserve capacity in a VECTOR for, at least, @a count elements.
+ * Capacity grows geometrically (doubling) to accommodate @a count.
+ * Growth of a borrowed or mapped buffer copies elements to a new
+ * (owned) buffer.
+ * @param vp Pointer to vector
+ * @param count Number of elements to reserve capacity for
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for vector
+*/
+int vector_reserve(VECTOR *vp, size_t count)
+{
+   unsigned char *data;
+   size_t capacity;
+
+   if (vp == NULL) goto FAIL_INVAL;
+   if (count <= vp->capacity) return 0;
+
+   for (capacity = vp->capacity ? vp->capacity : 16; capacity < count; ) {
+      if (capacity > (((size_t) -1) >> 1)) {
+         capacity = count;
+         break;
+      }
+      capacity <<= 1;
+   }
+   if (capacity > ((size_t) -1) / vp->size) goto FAIL_NOMEM;
+
+   if (vp->owner == VECTOR_OWNED) {
+      data = realloc(vp->data, capacity * vp->size);
+      if (data == NULL) goto FAIL_NOMEM;
+   } else {
+      data = malloc(capacity * vp->size);
+      if (data == NULL) goto FAIL_NOMEM;
+      if (vp->count) memcpy(data, vp->data, vp->count * vp->size);
+      vector_release(vp);
+      vp->owner = VECTOR_OWNED;
+   }
+   vp->data = data;
+   vp->capacity = capacity;
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end vector_reserve() */
+
+/**
+ * Resize a VECTOR to @a count elements. Additional elements are zero.
+ * @param vp Pointer to vector
+ * @param count Number of elements to resize vector to
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for vector
+*/
+int vector_resize(VECTOR *vp, size_t count)
+{
+   if (vp == NULL) goto FAIL_INVAL;
+   if (count <= vp->count) {
+      vp->count = count;
+      return 0;
+   }
+
+   return vector_append(vp, NULL, count - vp->count);
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end vector_resize() */
+
+/**
+ * Perform a binary search for @a len bytes of @a key in a VECTOR.
+ * Elements are expected to be sorted by (at least) their first @a len
+ * bytes, such as with vector_sort() using a memcmp() comparison.
+ * @param vp Pointer to vector
+ * @param key Pointer to key to search for
+ * @param len Length, in bytes, of key to compare
+ * @returns Pointer to found element, or NULL if not found.
+*/
+void *vector_search(VECTOR *vp, const void *key, size_t len)
+{
+   return bsearch_len(key, len, vp->data, vp->count, vp->size);
+}  /* end vector_search() */
+
+/**
+ * Shuffle the elements of a VECTOR, with shuffle().
+ * @param vp Pointer to vector
+*/
+void vector_shuffle(VECTOR *vp)
+{
+   shuffle(vp->data, vp->size, vp->count);
+}  /* end vector_shuffle() */
+
+/**
+ * Sort the elements of a VECTOR, in place, with qsort().
+ * @param vp Pointer to vector
+ * @param comp Pointer to comparison function
+*/
+void vector_sort(VECTOR *vp, int (*comp)(const void *, const void *))
+{
+   if (vp->count > 1) qsort(vp->data, vp->count, vp->size, comp);
+}  /* end vector_sort() */
+
 /* end include guard */
 #endif
@@ -2,6 +2,10 @@
  * @file extlib.h
  * @brief Extended general utilities support.
  * @details Provides extended support for general utilities.
+ * <br />Define `EXTC_INLINE` (before inclusion, or with `-DEXTC_INLINE`)
+ * for header-only (static inline) definitions of get16(), put16(),
+ * get32(), put32() and put64(). Library symbols remain, for code built
+ * without `EXTC_INLINE`.
  * @copyright Adequate Systems LLC, 2018-2022. All Rights Reserved.
  * <br />For license information, please refer to ../LICENSE.md
 */
@@ -13,6 +17,7 @@
 
 #include "extint.h"
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * @struct DLNODE Doubly-linked node struct.
@@ -58,6 +63,119 @@ typedef struct singly_linked_list {
    int count;
 } SLLIST;
 
+/**
+ * Number of children per node of a HEAP. A 4-ary heap is shallower
+ * than a binary heap, and the children of a node are adjacent in
+ * memory, which reduces cache misses during a sift down.
+*/
+#define HEAP_ARITY   4
+
+/**
+ * @struct HEAP Heap (priority queue) struct, of fixed size elements.
+ * Elements are ordered by a comparison function, or by a native
+ * 64-bit unsigned key inline with each element, such that the "least"
+ * element is at the top of the heap. Each pushed element is assigned
+ * a handle, which remains valid (as the element moves within the
+ * heap) until the element is popped or removed.
+ * @property HEAP::data Pointer to element data (incl. 1 scratch element)
+ * @property HEAP::pos Pointer to positions of elements, by handle
+ * @property HEAP::hnd Pointer to handles of elements, by position
+ * @property HEAP::size Size of each element, in bytes
+ * @property HEAP::count Number of elements in the heap
+ * @property HEAP::capacity Number of elements allocated
+ * @property HEAP::handles Number of handles assigned
+ * @property HEAP::free Next free handle, or (size_t) -1
+ * @property HEAP::keyoff Offset of inline 64-bit key, if no comparator
+ * @property HEAP::comp Pointer to comparison function, or NULL
+*/
+typedef struct heap {
+   unsigned char *data;
+   size_t *pos;
+   size_t *hnd;
+   size_t size;
+   size_t count;
+   size_t capacity;
+   size_t handles;
+   size_t free;
+   size_t keyoff;
+   int (*comp)(const void *, const void *);
+} HEAP;
+
+/**
+ * Ownership of a VECTOR buffer allocated with malloc(). The buffer is
+ * reallocated for growth and freed on destruction.
+*/
+#define VECTOR_OWNED    0
+
+/**
+ * Ownership of a VECTOR buffer borrowed from the caller, such as a
+ * static array. The buffer is never freed, and growth beyond its
+ * capacity copies elements to a new (owned) buffer.
+*/
+#define VECTOR_BORROWED 1
+
+/**
+ * Ownership of a VECTOR buffer mapped with mmap(). The buffer is
+ * unmapped on destruction, or after growth beyond its capacity copies
+ * elements to a new (owned) buffer.
+*/
+#define VECTOR_MAPPED   2
+
+/**
+ * @struct VECTOR Dynamic array struct, of fixed size elements.
+ * Capacity grows geometrically, such that appending elements one at a
+ * time has an amortized constant cost.
+ * @property VECTOR::data Pointer to element data
+ * @property VECTOR::size Size of each element, in bytes
+ * @property VECTOR::count Number of elements in the vector
+ * @property VECTOR::capacity Number of elements allocated
+ * @property VECTOR::owner Ownership of the element data buffer
+*/
+typedef struct vector {
+   unsigned char *data;
+   size_t size;
+   size_t count;
+   size_t capacity;
+   int owner;
+} VECTOR;
+
+/**
+ * Number of interleaved Xoshiro128** lanes used by rand_fill().
+ * Lanes are generated 8 at a time with AVX2, or 4 at a time with SSE2.
+*/
+#define RANDFILL_LANES  8
+
+/**
+ * Target size of each bucket of shuffle_parallel(), in bytes.
+ * Buckets are shuffled individually, and should fit in (L2) cache.
+*/
+#define SHUFFLE_BLOCK   262144
+
+/**
+ * Static RANDSTATE initializer. Used to initialize a RANDSTATE at the
+ * time of declaration, with the default states of each PRNG.
+ * <br/>Example usage:
+ * @code RANDSTATE state = RANDSTATE_INITIALIZER; @endcode
+*/
+#define RANDSTATE_INITIALIZER \
+   { { 0xcafef00d, 0xf01dab1e, 0x5eed1e55, 0x1dea112e }, \
+     { 1, 362436069, 123456789 }, 1 }
+
+/**
+ * @struct RANDSTATE PRNG state struct, for reentrant PRNG's.
+ * Each thread has a default RANDSTATE, used by the non-reentrant
+ * PRNG's, such that PRNG's never share state between threads. Threads
+ * following the first begin from distinct (derived) default states.
+ * @property RANDSTATE::s128 State of Xoshiro128**, for rand32_r()
+ * @property RANDSTATE::kiss State of KISS, for rand16_r()
+ * @property RANDSTATE::lcg State of LCG, for rand16fast_r()
+*/
+typedef struct rand_state {
+   word32 s128[4];
+   word32 kiss[3];
+   word32 lcg;
+} RANDSTATE;
+
 /* C/C++ compatible function prototypes for extthread.c */
 #ifdef __cplusplus
 extern "C" {
@@ -71,11 +189,18 @@ extern "C" {
 
 void put64_x86(void *buff, const void *val);
 
-word16 get16(const void *value);
-void put16(void *buff, word16 value);
-word32 get32(const void *value);
-void put32(void *buff, word32 value);
-void put64(void *buff, const void *value);
+/* library (out-of-line) forms, unless defined inline */
+#ifndef EXTC_INLINE
+   word16 get16(const void *value);
+   void put16(void *buff, word16 value);
+   word32 get32(const void *value);
+   void put32(void *buff, word32 value);
+   void put64(void *buff, const void *value);
+
+#endif
+
+void bswap32_array(void *dst, const void *src, size_t count);
+void bswap64_array(void *dst, const void *src, size_t count);
 void srand16fast(word32 x);
 word32 get_rand16fast(void);
 void srand16(word32 x, word32 y, word32 z);
@@ -84,7 +209,23 @@ word32 rand16fast(void);
 word32 rand16(void);
 word32 rand32(void);
 void srand32(unsigned long long x);
+void rand_fill(RANDSTATE *state, void *buf, size_t len);
+RANDSTATE *rand_state(void);
+word32 rand16_r(RANDSTATE *state);
+word32 rand16fast_r(RANDSTATE *state);
+word32 rand32_bound_r(RANDSTATE *state, word32 bound);
+word32 rand32_r(RANDSTATE *state);
+void rand32_jump(RANDSTATE *state);
+void rand32_long_jump(RANDSTATE *state);
+void rand32_split(RANDSTATE *state, RANDSTATE *streams, size_t count);
+unsigned long long rand64_bound_r(RANDSTATE *state, unsigned long long bound);
+void srand16_r(RANDSTATE *state, word32 x, word32 y, word32 z);
+void srand16fast_r(RANDSTATE *state, word32 x);
+void srand32_r(RANDSTATE *state, unsigned long long x);
 void shuffle(void *list, size_t size, size_t count);
+int shuffle_parallel(RANDSTATE *state, void *list, size_t size,
+   size_t count, int threads);
+void shuffle_r(RANDSTATE *state, void *list, size_t size, size_t count);
 void shufflenz(void *list, size_t size, size_t count);
 
 void *bsearch_len(const void *key, size_t len,
@@ -92,20 +233,198 @@ void *bsearch_len(const void *key, size_t len,
 int filesort(const char *filename, size_t size, size_t bufsz,
    int (*comp)(const void *, const void *));
 
+int heap_build(HEAP *hp, const void *list, size_t count, size_t *handles);
+void heap_destroy(HEAP *hp);
+int heap_init(HEAP *hp, size_t size, size_t count,
+   int (*comp)(const void *, const void *), size_t keyoff);
+void *heap_peek(HEAP *hp);
+int heap_pop(HEAP *hp, void *elem);
+int heap_push(HEAP *hp, const void *elem, size_t *handle);
+int heap_remove(HEAP *hp, size_t handle, void *elem);
+int heap_update(HEAP *hp, size_t handle, const void *elem);
+
 int dllist_append(DLLIST *srcp, DLLIST *dstp);
+int dllist_sort(DLLIST *listp, int (*comp)(const void *, const void *));
+int dllist_splice(DLLIST *dstp, DLNODE *posp, DLLIST *srcp,
+   DLNODE *firstp, DLNODE *lastp, int count);
+int dllist_split(DLLIST *srcp, DLNODE *nodep, DLLIST *dstp);
 int dlnode_append(DLNODE *nodep, DLLIST *listp);
 DLNODE *dlnode_create(size_t datasz);
 void dlnode_destroy(DLNODE *np);
 int dlnode_insert(DLNODE *nodep, DLNODE *currp, DLLIST *listp);
 int dlnode_remove(DLNODE *nodep, DLLIST *listp);
+int sllist_sort(SLLIST *listp, int (*comp)(const void *, const void *));
+int sllist_split(SLLIST *srcp, SLNODE *nodep, SLLIST *dstp);
 SLNODE *slnode_create(size_t datasz);
 void slnode_destroy(SLNODE *np);
 SLNODE *slnode_pop(SLLIST *listp);
 int slnode_push(SLNODE *nodep, SLLIST *listp);
+int vector_adopt(VECTOR *vp, void *buf, size_t size, size_t count,
+   size_t capacity, int owner);
+int vector_append(VECTOR *vp, const void *elems, size_t count);
+void vector_destroy(VECTOR *vp);
+void *vector_get(VECTOR *vp, size_t idx);
+int vector_init(VECTOR *vp, size_t size, size_t count);
+int vector_reserve(VECTOR *vp, size_t count);
+int vector_resize(VECTOR *vp, size_t count);
+void *vector_search(VECTOR *vp, const void *key, size_t len);
+void vector_shuffle(VECTOR *vp);
+void vector_sort(VECTOR *vp, int (*comp)(const void *, const void *));
 
 #ifdef __cplusplus
 }  /* end extern "C" */
 #endif
 
+/* header-only (static inline) mode guard */
+#ifdef EXTC_INLINE
+
+   /**
+    * Get a 16-bit unsigned value from @a buff. Inline (`EXTC_INLINE`)
+    * form of the library get16().
+    * @param buff Pointer to buffer to get value from, of any alignment
+    * @returns 16-bit unsigned value from @a buff.
+   */
+   static inline word16 get16(const void *buff)
+   {
+      word16 value;
+
+      memcpy(&value, buff, sizeof(value));
+      return value;
+   }
+
+   /**
+    * Place a 16-bit unsigned @a value in @a buff. Inline (`EXTC_INLINE`)
+    * form of the library put16().
+    * @param buff Pointer to buffer to place value, of any alignment
+    * @param value 16-bit unsigned value
+   */
+   static inline void put16(void *buff, word16 value)
+   {
+      memcpy(buff, &value, sizeof(value));
+   }
+
+   /**
+    * Get a 32-bit unsigned value from @a buff. Inline (`EXTC_INLINE`)
+    * form of the library get32().
+    * @param buff Pointer to buffer to get value from, of any alignment
+    * @returns 32-bit unsigned value from @a buff.
+   */
+   static inline word32 get32(const void *buff)
+   {
+      word32 value;
+
+      memcpy(&value, buff, sizeof(value));
+      return value;
+   }
+
+   /**
+    * Place a 32-bit unsigned @a value in @a buff. Inline (`EXTC_INLINE`)
+    * form of the library put32().
+    * @param buff Pointer to buffer to place value, of any alignment
+    * @param value 32-bit unsigned value
+   */
+   static inline void put32(void *buff, word32 value)
+   {
+      memcpy(buff, &value, sizeof(value));
+   }
+
+   /**
+    * Place a 64-bit unsigned @a value in @a buff. Inline (`EXTC_INLINE`)
+    * form of the library put64().
+    * @param buff Pointer to buffer to place value, of any alignment
+    * @param value Pointer to 64-bit value, of any alignment
+   */
+   static inline void put64(void *buff, const void *value)
+   {
+      memcpy(buff, value, 8);
+   }
+
+/* end header-only (static inline) mode guard */
+#endif
+
+/**
+ * Get a 16-bit unsigned value from big-endian @a buff.
+ * @param buff Pointer to buffer to get value from, of any alignment
+ * @returns 16-bit unsigned value from @a buff.
+*/
+static inline word16 get16be(const void *buff)
+{
+   const word8 *bp = (const word8 *) buff;
+
+   return (word16) ((bp[0] << 8) | bp[1]);
+}
+
+/**
+ * Get a 32-bit unsigned value from big-endian @a buff.
+ * @param buff Pointer to buffer to get value from, of any alignment
+ * @returns 32-bit unsigned value from @a buff.
+*/
+static inline word32 get32be(const void *buff)
+{
+   const word8 *bp = (const word8 *) buff;
+
+   return ((word32) bp[0] << 24) | ((word32) bp[1] << 16) |
+      ((word32) bp[2] << 8) | (word32) bp[3];
+}
+
+/**
+ * Place a 16-bit unsigned @a value in @a buff, as big-endian.
+ * @param buff Pointer to buffer to place value, of any alignment
+ * @param value 16-bit unsigned value
+*/
+static inline void put16be(void *buff, word16 value)
+{
+   word8 *bp = (word8 *) buff;
+
+   bp[0] = (word8) (value >> 8);
+   bp[1] = (word8) value;
+}
+
+/**
+ * Place a 32-bit unsigned @a value in @a buff, as big-endian.
+ * @param buff Pointer to buffer to place value, of any alignment
+ * @param value 32-bit unsigned value
+*/
+static inline void put32be(void *buff, word32 value)
+{
+   word8 *bp = (word8 *) buff;
+
+   bp[0] = (word8) (value >> 24);
+   bp[1] = (word8) (value >> 16);
+   bp[2] = (word8) (value >> 8);
+   bp[3] = (word8) value;
+}
+
+/* 64-bit guard */
+#ifdef HAS_64BIT
+
+   /**
+    * Get a 64-bit unsigned value from big-endian @a buff.
+    * @param buff Pointer to buffer to get value from, of any alignment
+    * @returns 64-bit unsigned value from @a buff.
+   */
+   static inline word64 get64be(const void *buff)
+   {
+      const word8 *bp = (const word8 *) buff;
+
+      return ((word64) get32be(bp) << 32) | get32be(bp + 4);
+   }
+
+   /**
+    * Place a 64-bit unsigned @a value in @a buff, as big-endian.
+    * @param buff Pointer to buffer to place value, of any alignment
+    * @param value 64-bit unsigned value
+   */
+   static inline void put64be(void *buff, word64 value)
+   {
+      word8 *bp = (word8 *) buff;
+
+      put32be(bp, (word32) (value >> 32));
+      put32be(bp + 4, (word32) value);
+   }
+
+/* end 64-bit guard */
+#endif
+
 /* end include guard */
 #endif
@@ -10,10 +10,44 @@
 #define EXTENDED_MATH_C
 
 
+/* library symbols are always built out-of-line, see EXTC_INLINE */
+#undef EXTC_INLINE
+
 #include "extmath.h"
+#include "exterrno.h"
 #include "extint.h"
 #include "extlib.h"
 
+/* external support */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* add/subtract with carry intrinsics, for multi_add/sub() */
+#if defined(__x86_64__) || defined(_M_X64)
+   #include <immintrin.h>
+   #define MULTI_ADDCARRY
+
+#endif
+
+/* CPUID support, for runtime kernel dispatch */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+   (defined(__x86_64__) || defined(__i386__))
+   #include <cpuid.h>
+   #include <immintrin.h>
+   #define EXTMATH_CPUID
+   /* per function target attributes for non-baseline kernels */
+   #define EXTMATH_TARGET
+   #define EXTMATH_ISA(isa)   __attribute__((target(isa)))
+
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+   #include <intrin.h>
+   #include <immintrin.h>
+   #define EXTMATH_CPUID
+   #define EXTMATH_ISA(isa)
+
+#endif
+
 /* x64 guard */
 #ifdef HAS_64BIT
 
@@ -22,8 +56,13 @@
    int iszero_x64(const void *buff, int len)
    {
       word8 *bp = (word8 *) buff;
+      word64 q;
 
-      for( ; len >= 8; bp += 8, len -= 8) if(*((word64 *) bp)) return 0;
+      /* memcpy() loads, as buff may be of any alignment */
+      for( ; len >= 8; bp += 8, len -= 8) {
+         memcpy(&q, bp, 8);
+         if(q) return 0;
+      }
       for( ; len; bp++, len--) if(*bp) return 0;
       return 1;
    }  /* end iszero_x64() */
@@ -94,20 +133,477 @@
       *((word64 *) ax) >>= 1;
    }  /* end shiftr64_x64() */
 
+   /* Multiply 64-bit @a a and @a b, returning the low 64 bits of the
+    * product and placing the high 64 bits in @a hi. */
+   static inline word64 mul64x64(word64 a, word64 b, word64 *hi)
+   {
+   #if defined(__SIZEOF_INT128__)
+      __extension__ unsigned __int128 p = (unsigned __int128) a * b;
+
+      *hi = (word64) (p >> 64);
+      return (word64) p;
+
+   #elif defined(_MSC_VER) && defined(_M_X64)
+      return _umul128(a, b, hi);
+
+   #else
+      word64 ll, lh, hl, mid;
+
+      ll = (a & 0xffffffff) * (b & 0xffffffff);
+      lh = (a & 0xffffffff) * (b >> 32);
+      hl = (a >> 32) * (b & 0xffffffff);
+      mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+      *hi = ((a >> 32) * (b >> 32)) + (lh >> 32) + (hl >> 32) + (mid >> 32);
+      return (mid << 32) | (ll & 0xffffffff);
+
+   #endif
+   }  /* end mul64x64() */
+
+   /* Forced 64-bit operation of mult64_full(). Not recommended for
+    * use outside of testing purposes. Use mult64_full() instead. */
+   int mult64_full_x64(const void *ax, const void *bx, void *lo, void *hi)
+   {
+      word64 a, b, ph, pl;
+
+      memcpy(&a, ax, 8);
+      memcpy(&b, bx, 8);
+      pl = mul64x64(a, b, &ph);
+      memcpy(lo, &pl, 8);
+      if (hi) memcpy(hi, &ph, 8);
+
+      return ph != 0;
+   }  /* end mult64_full_x64() */
+
    /* Forced 64-bit operation of mult64(). Not recommended for
     * use outside of testing purposes. Use mult64() instead. */
    int mult64_x64(const void *ax, const void *bx, void *cx)
    {
-      word64 *c = (word64 *) cx;
-      word64 a = *((word64 *) ax);
-      word64 b = *((word64 *) bx);
-
-      *c = a * b;
-      if (a == 0) return 0; /* avoid division by zero */
-      if ((*c / a) == b) return 0; /* check overflow */
-      return 1; /* result overflowed */
+      return mult64_full_x64(ax, bx, cx, NULL);
    }  /* end mult64_x64() */
 
+   /* 64-bit limb add with carry in @a c, returning carry out. */
+   static inline unsigned char addc64(unsigned char c, word64 a, word64 b,
+      word64 *r)
+   {
+   #ifdef MULTI_ADDCARRY
+      unsigned long long t;
+
+      c = _addcarry_u64(c, a, b, &t);
+      *r = (word64) t;
+      return c;
+
+   #else
+      word64 t = a + c;
+
+      c = (t < a);
+      *r = t + b;
+      return c | (*r < b);
+
+   #endif
+   }  /* end addc64() */
+
+   /* 64-bit limb subtract with borrow in @a c, returning borrow out. */
+   static inline unsigned char subb64(unsigned char c, word64 a, word64 b,
+      word64 *r)
+   {
+   #ifdef MULTI_ADDCARRY
+      unsigned long long t;
+
+      c = _subborrow_u64(c, a, b, &t);
+      *r = (word64) t;
+      return c;
+
+   #else
+      word64 t = a - b;
+
+      *r = t - c;
+      return (a < b) | (t < c);
+
+   #endif
+   }  /* end subb64() */
+
+   /* Forced 64-bit operation of multi_add(). Not recommended for
+    * use outside of testing purposes. Use multi_add() instead. */
+   int multi_add_x64(const void *ax, const void *bx, void *cx, int bytelen)
+   {
+      const word8 *a = (const word8 *) ax;
+      const word8 *b = (const word8 *) bx;
+      word8 *c = (word8 *) cx;
+      unsigned char carry = 0;
+      word64 x, y;
+      int t;
+
+      for( ; bytelen >= 8; a += 8, b += 8, c += 8, bytelen -= 8) {
+         memcpy(&x, a, 8);
+         memcpy(&y, b, 8);
+         carry = addc64(carry, x, y, &x);
+         memcpy(c, &x, 8);
+      }
+      for( ; bytelen > 0; a++, b++, c++, bytelen--) {
+         t = *a + *b + carry;
+         carry = (unsigned char) (t >> 8);
+         *c = (word8) t;
+      }
+
+      return carry;
+   }  /* end multi_add_x64() */
+
+   /* Forced 64-bit operation of multi_sub(). Not recommended for
+    * use outside of testing purposes. Use multi_sub() instead. */
+   int multi_sub_x64(const void *ax, const void *bx, void *cx, int bytelen)
+   {
+      const word8 *a = (const word8 *) ax;
+      const word8 *b = (const word8 *) bx;
+      word8 *c = (word8 *) cx;
+      unsigned char carry = 0;
+      word64 x, y;
+      int t;
+
+      for( ; bytelen >= 8; a += 8, b += 8, c += 8, bytelen -= 8) {
+         memcpy(&x, a, 8);
+         memcpy(&y, b, 8);
+         carry = subb64(carry, x, y, &x);
+         memcpy(c, &x, 8);
+      }
+      for( ; bytelen > 0; a++, b++, c++, bytelen--) {
+         t = *a - *b - carry;
+         carry = (unsigned char) ((t >> 8) & 1);
+         *c = (word8) t;
+      }
+
+      return carry;
+   }  /* end multi_sub_x64() */
+
+   /* Divide `u[m]` by `v[n]` (32-bit digits, n >= 2, v[n - 1] != 0),
+    * placing `q[m - n + 1]` and `r[n]`. Knuth's Algorithm D, as in
+    * Hacker's Delight (divmnu), with 64-bit intermediates. */
+   static void u256_divmnu(word32 *q, word32 *r, const word32 *u,
+      const word32 *v, int m, int n)
+   {
+      word32 un[9], vn[8];
+      word64 qhat, rhat, p;
+      int64 t, k;
+      int s, i, j;
+
+      /* normalize, such that the top bit of v[n - 1] is set */
+      for (s = 0; (v[n - 1] << s) < WORD32_C(0x80000000); s++);
+      for (i = n - 1; i > 0; i--) {
+         vn[i] = (v[i] << s) | (word32) ((word64) v[i - 1] >> (32 - s));
+      }
+      vn[0] = v[0] << s;
+      un[m] = (word32) ((word64) u[m - 1] >> (32 - s));
+      for (i = m - 1; i > 0; i--) {
+         un[i] = (u[i] << s) | (word32) ((word64) u[i - 1] >> (32 - s));
+      }
+      un[0] = u[0] << s;
+
+      for (j = m - n; j >= 0; j--) {
+         /* estimate quotient digit, correct at most twice */
+         p = ((word64) un[j + n] << 32) | un[j + n - 1];
+         qhat = p / vn[n - 1];
+         rhat = p - (qhat * vn[n - 1]);
+         while (qhat > 0xffffffff ||
+               qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat > 0xffffffff) break;
+         }
+         /* multiply and subtract */
+         for (k = 0, i = 0; i < n; i++) {
+            p = qhat * vn[i];
+            t = (int64) un[i + j] - k - (int64) (p & 0xffffffff);
+            un[i + j] = (word32) t;
+            k = (int64) (p >> 32) - (t >> 32);
+         }
+         t = (int64) un[j + n] - k;
+         un[j + n] = (word32) t;
+         q[j] = (word32) qhat;
+         if (t < 0) {
+            /* subtracted too much, add back */
+            q[j]--;
+            for (k = 0, i = 0; i < n; i++) {
+               t = (int64) un[i + j] + vn[i] + k;
+               un[i + j] = (word32) t;
+               k = t >> 32;
+            }
+            un[j + n] = (word32) (un[j + n] + k);
+         }
+      }
+      /* unnormalize remainder */
+      for (i = 0; i < n - 1; i++) {
+         r[i] = (un[i] >> s) | (word32) ((word64) un[i + 1] << (32 - s));
+      }
+      r[n - 1] = un[n - 1] >> s;
+   }  /* end u256_divmnu() */
+
+   /* Forced 64-bit operation of u256_add(). Not recommended for
+    * use outside of testing purposes. Use u256_add() instead. */
+   int u256_add_x64(const u256 *a, const u256 *b, u256 *c)
+   {
+      unsigned char carry = 0;
+      int i;
+
+      for (i = 0; i < 4; i++) {
+         carry = addc64(carry, a->q[i], b->q[i], &c->q[i]);
+      }
+
+      return carry;
+   }  /* end u256_add_x64() */
+
+   /* Forced 64-bit operation of u256_sub(). Not recommended for
+    * use outside of testing purposes. Use u256_sub() instead. */
+   int u256_sub_x64(const u256 *a, const u256 *b, u256 *c)
+   {
+      unsigned char carry = 0;
+      int i;
+
+      for (i = 0; i < 4; i++) {
+         carry = subb64(carry, a->q[i], b->q[i], &c->q[i]);
+      }
+
+      return carry;
+   }  /* end u256_sub_x64() */
+
+   /* 256-bit limb multiplication, for u256_mul_x64(). */
+   static inline int u256_mul_limbs(const u256 *a, const u256 *b,
+      u256 *lo, u256 *hi)
+   {
+      word64 t[8] = { 0 };
+      word64 carry, ph, pl;
+      int i, j;
+
+      for (i = 0; i < 4; i++) {
+         for (carry = 0, j = 0; j < 4; j++) {
+            pl = mul64x64(a->q[i], b->q[j], &ph);
+            pl += t[i + j];
+            ph += (pl < t[i + j]);
+            pl += carry;
+            ph += (pl < carry);
+            t[i + j] = pl;
+            carry = ph;
+         }
+         t[i + 4] = carry;
+      }
+      memcpy(lo->q, t, 32);
+      if (hi) memcpy(hi->q, &t[4], 32);
+
+      return (t[4] | t[5] | t[6] | t[7]) != 0;
+   }  /* end u256_mul_limbs() */
+
+   /* Forced 64-bit operation of u256_mul(). Not recommended for
+    * use outside of testing purposes. Use u256_mul() instead. */
+   int u256_mul_x64(const u256 *a, const u256 *b, u256 *lo, u256 *hi)
+   {
+      return u256_mul_limbs(a, b, lo, hi);
+   }  /* end u256_mul_x64() */
+
+   #ifdef EXTMATH_TARGET
+      /* u256_mul_x64(), with flagless (BMI2) MULX products. */
+      EXTMATH_ISA("bmi2")
+      static int u256_mul_bmi2(const u256 *a, const u256 *b,
+         u256 *lo, u256 *hi)
+      {
+         word64 t[8] = { 0 };
+         word64 carry, ph, pl;
+         unsigned long long h;
+         int i, j;
+
+         for (i = 0; i < 4; i++) {
+            for (carry = 0, j = 0; j < 4; j++) {
+               pl = (word64) _mulx_u64(a->q[i], b->q[j], &h);
+               ph = (word64) h;
+               pl += t[i + j];
+               ph += (pl < t[i + j]);
+               pl += carry;
+               ph += (pl < carry);
+               t[i + j] = pl;
+               carry = ph;
+            }
+            t[i + 4] = carry;
+         }
+         memcpy(lo->q, t, 32);
+         if (hi) memcpy(hi->q, &t[4], 32);
+
+         return (t[4] | t[5] | t[6] | t[7]) != 0;
+      }  /* end u256_mul_bmi2() */
+
+   #endif
+
+   #if defined(EXTMATH_TARGET) && defined(__x86_64__)
+      /* u256_mul_x64(), with MULX products accumulated on two
+       * independent carry chains, ADCX (CF) for low and ADOX (OF)
+       * for high halves. Rows of products are accumulated in a
+       * rotating window of 5 registers (r8-r12); r13 is zero. */
+      EXTMATH_ISA("bmi2,adx")
+      static int u256_mul_adx(const u256 *a, const u256 *b,
+         u256 *lo, u256 *hi)
+      {
+         word64 t[8];
+
+         __asm__ (
+            "xorl %%r13d, %%r13d\n\t"
+            /* row 0; t0..t4 = a0 * b */
+            "movq 0(%1), %%rdx\n\t"
+            "mulxq 0(%2), %%r8, %%r9\n\t"
+            "mulxq 8(%2), %%rax, %%r10\n\t"
+            "addq %%rax, %%r9\n\t"
+            "mulxq 16(%2), %%rax, %%r11\n\t"
+            "adcq %%rax, %%r10\n\t"
+            "mulxq 24(%2), %%rax, %%r12\n\t"
+            "adcq %%rax, %%r11\n\t"
+            "adcq %%r13, %%r12\n\t"
+            "movq %%r8, 0(%0)\n\t"
+            /* row 1; t1..t5 += a1 * b */
+            "movq 8(%1), %%rdx\n\t"
+            "xorl %%r8d, %%r8d\n\t"
+            "mulxq 0(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r9\n\t"
+            "adoxq %%rcx, %%r10\n\t"
+            "mulxq 8(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r10\n\t"
+            "adoxq %%rcx, %%r11\n\t"
+            "mulxq 16(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r11\n\t"
+            "adoxq %%rcx, %%r12\n\t"
+            "mulxq 24(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r12\n\t"
+            "adoxq %%rcx, %%r8\n\t"
+            "adcxq %%r13, %%r8\n\t"
+            "movq %%r9, 8(%0)\n\t"
+            /* row 2; t2..t6 += a2 * b */
+            "movq 16(%1), %%rdx\n\t"
+            "xorl %%r9d, %%r9d\n\t"
+            "mulxq 0(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r10\n\t"
+            "adoxq %%rcx, %%r11\n\t"
+            "mulxq 8(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r11\n\t"
+            "adoxq %%rcx, %%r12\n\t"
+            "mulxq 16(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r12\n\t"
+            "adoxq %%rcx, %%r8\n\t"
+            "mulxq 24(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r8\n\t"
+            "adoxq %%rcx, %%r9\n\t"
+            "adcxq %%r13, %%r9\n\t"
+            "movq %%r10, 16(%0)\n\t"
+            /* row 3; t3..t7 += a3 * b */
+            "movq 24(%1), %%rdx\n\t"
+            "xorl %%r10d, %%r10d\n\t"
+            "mulxq 0(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r11\n\t"
+            "adoxq %%rcx, %%r12\n\t"
+            "mulxq 8(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r12\n\t"
+            "adoxq %%rcx, %%r8\n\t"
+            "mulxq 16(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r8\n\t"
+            "adoxq %%rcx, %%r9\n\t"
+            "mulxq 24(%2), %%rax, %%rcx\n\t"
+            "adcxq %%rax, %%r9\n\t"
+            "adoxq %%rcx, %%r10\n\t"
+            "adcxq %%r13, %%r10\n\t"
+            "movq %%r11, 24(%0)\n\t"
+            "movq %%r12, 32(%0)\n\t"
+            "movq %%r8, 40(%0)\n\t"
+            "movq %%r9, 48(%0)\n\t"
+            "movq %%r10, 56(%0)\n\t"
+            : /* no outputs, but t[] (memory) */
+            : "r" (t), "r" (a->q), "r" (b->q)
+            : "rax", "rcx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13",
+               "cc", "memory");
+         memcpy(lo->q, t, 32);
+         if (hi) memcpy(hi->q, &t[4], 32);
+
+         return (t[4] | t[5] | t[6] | t[7]) != 0;
+      }  /* end u256_mul_adx() */
+
+   #endif
+
+   /* Forced 64-bit operation of u256_divmod64(). Not recommended for
+    * use outside of testing purposes. Use u256_divmod64() instead. */
+   int u256_divmod64_x64(const u256 *a, const void *d, u256 *q, void *r)
+   {
+      u256 quot;
+      word64 dv, rv;
+      int i;
+
+      memcpy(&dv, d, 8);
+      if (dv == 0) goto FAIL_INVAL;
+
+      rv = 0;
+      if (dv <= 0xffffffff) {
+         /* short division, by 32-bit digits */
+         for (i = 7; i >= 0; i--) {
+            rv = (rv << 32) | a->w[i];
+            quot.w[i] = (word32) (rv / dv);
+            rv %= dv;
+         }
+      } else {
+      #ifdef __SIZEOF_INT128__
+         __extension__ unsigned __int128 n;
+
+         for (i = 3; i >= 0; i--) {
+            n = rv;
+            n = (n << 64) | a->q[i];
+            quot.q[i] = (word64) (n / dv);
+            rv = (word64) (n % dv);
+         }
+
+      #else
+         u256 div, rem;
+
+         memset(&div, 0, sizeof(div));
+         div.q[0] = dv;
+         u256_divmod_x64(a, &div, &quot, &rem);
+         rv = rem.q[0];
+
+      #endif
+      }
+      if (q) *q = quot;
+      if (r) memcpy(r, &rv, 8);
+
+      return 0;
+
+      /* error handling */
+   FAIL_INVAL:
+      set_errno(EINVAL);
+      return (-1);
+   }  /* end u256_divmod64_x64() */
+
+   /* Forced 64-bit operation of u256_divmod(). Not recommended for
+    * use outside of testing purposes. Use u256_divmod() instead. */
+   int u256_divmod_x64(const u256 *a, const u256 *b, u256 *q, u256 *r)
+   {
+      u256 quot, rem;
+      int m, n;
+
+      /* count significant 32-bit digits */
+      for (n = 8; n > 0 && b->w[n - 1] == 0; n--);
+      for (m = 8; m > 0 && a->w[m - 1] == 0; m--);
+      if (n == 0) goto FAIL_INVAL;
+      if (n == 1) {
+         memset(&rem, 0, sizeof(rem));
+         u256_divmod64_x64(a, b->q, &quot, rem.q);
+      } else if (m < n) {
+         memset(&quot, 0, sizeof(quot));
+         rem = *a;
+      } else {
+         memset(&quot, 0, sizeof(quot));
+         memset(&rem, 0, sizeof(rem));
+         u256_divmnu(quot.w, rem.w, a->w, b->w, m, n);
+      }
+      if (q) *q = quot;
+      if (r) *r = rem;
+
+      return 0;
+
+      /* error handling */
+   FAIL_INVAL:
+      set_errno(EINVAL);
+      return (-1);
+   }  /* end u256_divmod_x64() */
+
 /* end x64 guard */
 #endif
 
@@ -116,8 +612,13 @@
 int iszero_x86(const void *buff, int len)
 {
    word8 *bp = (word8 *) buff;
+   word32 w;
 
-   for( ; len >= 4; bp += 4, len -= 4) if(*((word32 *) bp)) return 0;
+   /* memcpy() loads, as buff may be of any alignment */
+   for( ; len >= 4; bp += 4, len -= 4) {
+      memcpy(&w, bp, 4);
+      if(w) return 0;
+   }
    for( ; len; bp++, len--) if(*bp) return 0;
    return 1;
 }  /* end iszero_x86() */
@@ -202,221 +703,2439 @@ void shiftr64_x86(void *ax)
    a[1] >>= 1;
 }  /* end shiftr64_x86() */
 
+/* Multiply 32-bit @a a and @a b, returning the low 32 bits of the
+ * product and placing the high 32 bits in @a hi. */
+static inline word32 mul32x32(word32 a, word32 b, word32 *hi)
+{
+   word32 ll, lh, hl, mid;
+
+   ll = (a & 0xffff) * (b & 0xffff);
+   lh = (a & 0xffff) * (b >> 16);
+   hl = (a >> 16) * (b & 0xffff);
+   mid = (ll >> 16) + (lh & 0xffff) + (hl & 0xffff);
+   *hi = ((a >> 16) * (b >> 16)) + (lh >> 16) + (hl >> 16) + (mid >> 16);
+   return (mid << 16) | (ll & 0xffff);
+}  /* end mul32x32() */
+
+/* Forced 32-bit operation of mult64_full(). Not recommended for
+ * use outside of testing purposes. Use mult64_full() instead. */
+int mult64_full_x86(const void *ax, const void *bx, void *lo, void *hi)
+{
+   word32 a[2], b[2], t[4] = { 0 };
+   word32 carry, ph, pl;
+   int i, j;
+
+   memcpy(a, ax, 8);
+   memcpy(b, bx, 8);
+   for (i = 0; i < 2; i++) {
+      for (carry = 0, j = 0; j < 2; j++) {
+         pl = mul32x32(a[i], b[j], &ph);
+         pl += t[i + j];
+         ph += (pl < t[i + j]);
+         pl += carry;
+         ph += (pl < carry);
+         t[i + j] = pl;
+         carry = ph;
+      }
+      t[i + 2] = carry;
+   }
+   memcpy(lo, t, 8);
+   if (hi) memcpy(hi, &t[2], 8);
+
+   return (t[2] | t[3]) != 0;
+}  /* end mult64_full_x86() */
+
 /* Forced 32-bit operation of mult64(). Not recommended for
  * use outside of testing purposes. Use mult64() instead. */
 int mult64_x86(const void *ax, const void *bx, void *cx)
 {
-   word32 *c = (word32 *) cx;
-   word32 a[2], b[2];
-   int overflow = 0;
-
-   put64(a, ax);
-   put64(b, bx);
-   c[0] = c[1] = 0;
-   while(b[0] | b[1]) {
-      if(b[0] & 1)
-         overflow |= add64(c, a, c);
-      add64(a, a, a);  /* shift a left */
-      shiftr64(b);
-   }
-
-   return overflow;
+   return mult64_full_x86(ax, bx, cx, NULL);
 }  /* end mult64_x86() */
 
-/**
- * Check if `buff[len]` contains all zeros.
- * @param buff Pointer to buffer to check contains zeros
- * @param len The length of buffer, in bytes, to check
- * @returns 1 if `buff[len]` is all zeros, else 0.
-*/
-int iszero(const void *buff, int len)
+/* 32-bit limb add with carry in @a c, returning carry out. */
+static inline unsigned char addc32(unsigned char c, word32 a, word32 b,
+   word32 *r)
 {
-#ifdef HAS_64BIT
-   return iszero_x64(buff, len);
+#ifdef MULTI_ADDCARRY
+   unsigned int t;
+
+   c = _addcarry_u32(c, a, b, &t);
+   *r = (word32) t;
+   return c;
 
 #else
-   return iszero_x86(buff, len);
+   word32 t = a + c;
+
+   c = (t < a);
+   *r = t + b;
+   return c | (*r < b);
 
 #endif
-}  /* end iszero() */
+}  /* end addc32() */
 
-/**
- * 64-bit addition of @a *ax and @a *bx. Result is placed in @a *cx.
- * @param ax Pointer to 64-bit value to add to
- * @param bx Pointer to 64-bit value to add
- * @param cx Pointer to place result of 64-bit addition
- * @returns Resulting carry of operation.
-*/
-int add64(const void *ax, const void *bx, void *cx)
+/* 32-bit limb subtract with borrow in @a c, returning borrow out. */
+static inline unsigned char subb32(unsigned char c, word32 a, word32 b,
+   word32 *r)
 {
-#ifdef HAS_64BIT
-   return add64_x64(ax, bx, cx);
+#ifdef MULTI_ADDCARRY
+   unsigned int t;
+
+   c = _subborrow_u32(c, a, b, &t);
+   *r = (word32) t;
+   return c;
 
 #else
-   return add64_x86(ax, bx, cx);
+   word32 t = a - b;
+
+   *r = t - c;
+   return (a < b) | (t < c);
 
 #endif
-}  /* end add64() */
+}  /* end subb32() */
 
-/**
- * 64-bit subtraction of @a *bx from @a *ax.
- * Result is placed in @a *cx.
- * @param ax Pointer to 64-bit value to subtract from
- * @param bx Pointer to 64-bit value to subtract
- * @param cx Pointer to place result of 64-bit subtraction
- * @returns Resulting carry of operation.
-*/
-int sub64(const void *ax, const void *bx, void *cx)
+/* Forced 32-bit operation of multi_add(). Not recommended for
+ * use outside of testing purposes. Use multi_add() instead. */
+int multi_add_x86(const void *ax, const void *bx, void *cx, int bytelen)
 {
-#ifdef HAS_64BIT
-   return sub64_x64(ax, bx, cx);
+   const word8 *a = (const word8 *) ax;
+   const word8 *b = (const word8 *) bx;
+   word8 *c = (word8 *) cx;
+   unsigned char carry = 0;
+   word32 x, y;
+   int t;
+
+   for( ; bytelen >= 4; a += 4, b += 4, c += 4, bytelen -= 4) {
+      memcpy(&x, a, 4);
+      memcpy(&y, b, 4);
+      carry = addc32(carry, x, y, &x);
+      memcpy(c, &x, 4);
+   }
+   for( ; bytelen > 0; a++, b++, c++, bytelen--) {
+      t = *a + *b + carry;
+      carry = (unsigned char) (t >> 8);
+      *c = (word8) t;
+   }
 
-#else
-   return sub64_x86(ax, bx, cx);
+   return carry;
+}  /* end multi_add_x86() */
 
-#endif
-}  /* end sub64() */
+/* Forced 32-bit operation of multi_sub(). Not recommended for
+ * use outside of testing purposes. Use multi_sub() instead. */
+int multi_sub_x86(const void *ax, const void *bx, void *cx, int bytelen)
+{
+   const word8 *a = (const word8 *) ax;
+   const word8 *b = (const word8 *) bx;
+   word8 *c = (word8 *) cx;
+   unsigned char carry = 0;
+   word32 x, y;
+   int t;
+
+   for( ; bytelen >= 4; a += 4, b += 4, c += 4, bytelen -= 4) {
+      memcpy(&x, a, 4);
+      memcpy(&y, b, 4);
+      carry = subb32(carry, x, y, &x);
+      memcpy(c, &x, 4);
+   }
+   for( ; bytelen > 0; a++, b++, c++, bytelen--) {
+      t = *a - *b - carry;
+      carry = (unsigned char) ((t >> 8) & 1);
+      *c = (word8) t;
+   }
 
-/**
- * Swap sign on 64-bit @a *ax. Equivalent to @a *ax multiplied by (-1).
- * @param ax Pointer to 64-bit value to "negate"
-*/
-void negate64(void *ax)
+   return carry;
+}  /* end multi_sub_x86() */
+
+/* Forced 32-bit operation of u256_add(). Not recommended for
+ * use outside of testing purposes. Use u256_add() instead. */
+int u256_add_x86(const u256 *a, const u256 *b, u256 *c)
 {
-#ifdef HAS_64BIT
-   negate64_x64(ax);
+   unsigned char carry = 0;
+   int i;
 
-#else
-   negate64_x86(ax);
+   for (i = 0; i < 8; i++) {
+      carry = addc32(carry, a->w[i], b->w[i], &c->w[i]);
+   }
 
-#endif
-}  /* end negate64() */
+   return carry;
+}  /* end u256_add_x86() */
 
-/**
- * 64-bit unsigned compare @a *ax to @a *bx.
- * @param ax Pointer to 64-bit value to compare to
- * @param bx Pointer to 64-bit value to compare
- * @retval -1 if @a *ax < @a *bx
- * @retval 1 if @a *ax > @a *bx
- * @retval 0 if @a *ax == @a *bx.
-*/
-int cmp64(const void *ax, const void *bx)
+/* Forced 32-bit operation of u256_sub(). Not recommended for
+ * use outside of testing purposes. Use u256_sub() instead. */
+int u256_sub_x86(const u256 *a, const u256 *b, u256 *c)
 {
-#ifdef HAS_64BIT
-   return cmp64_x64(ax, bx);
+   unsigned char carry = 0;
+   int i;
 
-#else
-   return cmp64_x86(ax, bx);
+   for (i = 0; i < 8; i++) {
+      carry = subb32(carry, a->w[i], b->w[i], &c->w[i]);
+   }
 
-#endif
-}  /* end cmp64() */
+   return carry;
+}  /* end u256_sub_x86() */
 
-/**
- * 256-bit unsigned compare @a *ax to @a *bx.
- * @param ax Pointer to 256-bit value to compare to
- * @param bx Pointer to 256-bit value to compare
- * @retval -1 if @a *ax < @a *bx
- * @retval 1 if @a *ax > @a *bx
- * @retval 0 if @a *ax == @a *bx.
-*/
-int cmp256(const void *ax, const void *bx)
+/* Forced 32-bit operation of u256_mul(). Not recommended for
+ * use outside of testing purposes. Use u256_mul() instead. */
+int u256_mul_x86(const u256 *a, const u256 *b, u256 *lo, u256 *hi)
 {
-#ifdef HAS_64BIT
-   return cmp256_x64(ax, bx);
+   word32 t[16] = { 0 };
+   word32 carry, ph, pl;
+   int i, j;
+
+   for (i = 0; i < 8; i++) {
+      for (carry = 0, j = 0; j < 8; j++) {
+         pl = mul32x32(a->w[i], b->w[j], &ph);
+         pl += t[i + j];
+         ph += (pl < t[i + j]);
+         pl += carry;
+         ph += (pl < carry);
+         t[i + j] = pl;
+         carry = ph;
+      }
+      t[i + 8] = carry;
+   }
+   memcpy(lo->w, t, 32);
+   if (hi) memcpy(hi->w, &t[8], 32);
 
-#else
-   return cmp256_x86(ax, bx);
+   for (i = 8; i < 16; i++) if (t[i]) return 1;
+   return 0;
+}  /* end u256_mul_x86() */
 
-#endif
-}  /* end cmp256() */
+/* Forced 32-bit operation of u256_divmod(). Not recommended for
+ * use outside of testing purposes. Use u256_divmod() instead. */
+int u256_divmod_x86(const u256 *a, const u256 *b, u256 *q, u256 *r)
+{
+   u256 quot, rem;
+   int i, bit;
 
-/**
- * 64-bit shift @a *ax one to the right.
- * @param ax Pointer to 64-bit value to shift
-*/
-void shiftr64(void *ax)
+   if (u256_iszero(b)) goto FAIL_INVAL;
+
+   /* binary long division, from the most significant set bit */
+   memset(&quot, 0, sizeof(quot));
+   memset(&rem, 0, sizeof(rem));
+   for (bit = 255; bit >= 0; bit--) {
+      if ((a->w[bit >> 5] >> (bit & 31)) & 1) break;
+   }
+   for ( ; bit >= 0; bit--) {
+      for (i = 7; i > 0; i--) {
+         rem.w[i] = (rem.w[i] << 1) | (rem.w[i - 1] >> 31);
+      }
+      rem.w[0] = (rem.w[0] << 1) | ((a->w[bit >> 5] >> (bit & 31)) & 1);
+      if (u256_cmp(&rem, b) >= 0) {
+         u256_sub_x86(&rem, b, &rem);
+         quot.w[bit >> 5] |= WORD32_C(1) << (bit & 31);
+      }
+   }
+   if (q) *q = quot;
+   if (r) *r = rem;
+
+   return 0;
+
+   /* error handling */
+FAIL_INVAL:
+   set_errno(EINVAL);
+   return (-1);
+}  /* end u256_divmod_x86() */
+
+/* Forced 32-bit operation of u256_divmod64(). Not recommended for
+ * use outside of testing purposes. Use u256_divmod64() instead. */
+int u256_divmod64_x86(const u256 *a, const void *d, u256 *q, void *r)
 {
+   u256 div, rem;
+
+   memset(&div, 0, sizeof(div));
+   memcpy(div.w, d, 8);
+   if (u256_divmod_x86(a, &div, q, &rem) != 0) return (-1);
+   if (r) memcpy(r, rem.w, 8);
+
+   return 0;
+}  /* end u256_divmod64_x86() */
+
+/* Multi-precision limbs, for multi_mul() and multi_sqr() */
 #ifdef HAS_64BIT
-   shiftr64_x64(ax);
+   typedef word64 mlimb;
+   #define MLIMB_BYTES  8
+   #define MLIMB_ADDC   addc64
+   #define MLIMB_MUL    mul64x64
+   #define MLIMB_SUBB   subb64
+   #ifdef __SIZEOF_INT128__
+      /* double width limb, for multiply-accumulate */
+      __extension__ typedef unsigned __int128 mlimb2;
+      #define MLIMB2
+
+   #endif
 
 #else
-   shiftr64_x86(ax);
+   typedef word32 mlimb;
+   #define MLIMB_BYTES  4
+   #define MLIMB_ADDC   addc32
+   #define MLIMB_MUL    mul32x32
+   #define MLIMB_SUBB   subb32
 
 #endif
-}  /* end shiftr64() */
 
-/**
- * 64-bit multiplication of @a *ax and @a *bx.
- * Result is placed in @a *cx.
- * @param ax Pointer to 64-bit value to multiply
- * @param bx Pointer to 64-bit value to multiply by
- * @param cx Pointer to place result of 64-bit multiplication
- * @result 1 if multiplication results in overflow, else 0.
-*/
-int mult64(const void *ax, const void *bx, void *cx)
+/* Bits per limb */
+#define MLIMB_BITS   (MLIMB_BYTES * 8)
+
+/* Operand limbs from which multi_mul() and multi_sqr() switch from
+ * schoolbook to Karatsuba multiplication (see extmath-multi-mul bench). */
+#ifndef KARATSUBA_MUL
+   #define KARATSUBA_MUL   32
+#endif
+#ifndef KARATSUBA_SQR
+   #define KARATSUBA_SQR   48
+#endif
+
+/* Limbs of operands and product, below which no allocation is made. */
+#define MULTI_MUL_STACK 256
+
+/* Add `x[xn]` into `r[rn]` (rn >= xn), propagating the carry. */
+static void mlimb_add_into(mlimb *r, int rn, const mlimb *x, int xn)
 {
-#ifdef HAS_64BIT
-   return mult64_x64(ax, bx, cx);
+   unsigned char c = 0;
+   int i;
 
-#else
-   return mult64_x86(ax, bx, cx);
+   for (i = 0; i < xn; i++) c = MLIMB_ADDC(c, r[i], x[i], &r[i]);
+   for ( ; c && i < rn; i++) c = (++r[i] == 0);
+}  /* end mlimb_add_into() */
 
-#endif
-}  /* end mult64() */
+/* Subtract `x[xn]` from `r[rn]` (rn >= xn), propagating the borrow. */
+static void mlimb_sub_into(mlimb *r, int rn, const mlimb *x, int xn)
+{
+   unsigned char c = 0;
+   int i;
 
-/**
- * Multi-byte addition of `ax[bytelen]` and `bx[bytelen]`.
- * Place result in `cx[bytelen]`.
- * @param ax Pointer to multi-byte value to add to
- * @param bx Pointer to multi-byte value to add
- * @param cx Pointer to place result of multi-byte addition
- * @returns Resulting carry of operation.
-*/
-int multi_add(const void *ax, const void *bx, void *cx, int bytelen)
+   for (i = 0; i < xn; i++) c = MLIMB_SUBB(c, r[i], x[i], &r[i]);
+   for ( ; c && i < rn; i++) c = (r[i]-- == 0);
+}  /* end mlimb_sub_into() */
+
+/* Add `a[an]` and `b[bn]` (an >= bn), placing `r[an + 1]`. */
+static void mlimb_add(mlimb *r, const mlimb *a, int an, const mlimb *b,
+   int bn)
 {
-   word8 *a, *b, *c;
-   int t, carry = 0;
+   unsigned char c = 0;
+   int i;
 
-   if(bytelen < 1) return 0;
+   for (i = 0; i < bn; i++) c = MLIMB_ADDC(c, a[i], b[i], &r[i]);
+   for ( ; i < an; i++) c = MLIMB_ADDC(c, a[i], 0, &r[i]);
+   r[an] = c;
+}  /* end mlimb_add() */
 
-   a = (word8 *) ax;
-   b = (word8 *) bx;
-   c = (word8 *) cx;
-   for( ; bytelen; a++, b++, c++, bytelen--) {
-      t = *a + *b + carry;
-      carry = t >> 8;
-      *c = t;
+/* Add `a[n] * b` into `r[n]`, returning the carry limb. */
+static mlimb mlimb_addmul_1(mlimb *r, const mlimb *a, int n, mlimb b)
+{
+#ifdef MLIMB2
+   mlimb carry = 0;
+   mlimb2 t;
+   int i;
+
+   for (i = 0; i < n; i++) {
+      t = (mlimb2) a[i] * b + r[i] + carry;
+      r[i] = (mlimb) t;
+      carry = (mlimb) (t >> 64);
    }
 
    return carry;
-}  /* end multi_add() */
 
-/**
+#else
+   mlimb carry = 0, ph, pl;
+   int i;
+
+   for (i = 0; i < n; i++) {
+      pl = MLIMB_MUL(a[i], b, &ph);
+      pl += r[i];
+      ph += (pl < r[i]);
+      pl += carry;
+      ph += (pl < carry);
+      r[i] = pl;
+      carry = ph;
+   }
+
+   return carry;
+
+#endif
+}  /* end mlimb_addmul_1() */
+
+/* Schoolbook multiplication of `a[an]` and `b[bn]`, into `r[an + bn]`. */
+static void mlimb_mul_base(mlimb *r, const mlimb *a, int an,
+   const mlimb *b, int bn)
+{
+   int i;
+
+   memset(r, 0, (size_t) (an + bn) * sizeof(mlimb));
+   for (i = 0; i < bn; i++) r[i + an] = mlimb_addmul_1(&r[i], a, an, b[i]);
+}  /* end mlimb_mul_base() */
+
+/* Schoolbook squaring of `a[n]`, into `r[2n]`. Cross products are
+ * computed once and doubled, before adding the diagonal squares. */
+static void mlimb_sqr_base(mlimb *r, const mlimb *a, int n)
+{
+   unsigned char c;
+   mlimb top, ph, pl;
+   int i;
+
+   memset(r, 0, (size_t) (2 * n) * sizeof(mlimb));
+   for (i = 0; i < n - 1; i++) {
+      r[i + n] = mlimb_addmul_1(&r[(2 * i) + 1], &a[i + 1], n - i - 1, a[i]);
+   }
+   for (top = 0, i = 0; i < 2 * n; i++) {
+      ph = r[i] >> ((MLIMB_BYTES * 8) - 1);
+      r[i] = (r[i] << 1) | top;
+      top = ph;
+   }
+   for (c = 0, i = 0; i < n; i++) {
+      pl = MLIMB_MUL(a[i], a[i], &ph);
+      c = MLIMB_ADDC(c, r[2 * i], pl, &r[2 * i]);
+      c = MLIMB_ADDC(c, r[(2 * i) + 1], ph, &r[(2 * i) + 1]);
+   }
+}  /* end mlimb_sqr_base() */
+
+/* Scratch limbs required by mlimb_mul(), of `a[an]` and `b[bn]`. */
+static size_t mlimb_mul_scratch(int an, int bn)
+{
+   size_t size, rem;
+   int h;
+
+   if (bn < KARATSUBA_MUL) return 0;
+   if (an == bn) {
+      h = an - (an / 2);
+      return (4 * (size_t) (h + 1)) + mlimb_mul_scratch(h + 1, h + 1);
+   }
+   size = mlimb_mul_scratch(bn, bn);
+   if (an % bn) {
+      rem = mlimb_mul_scratch(bn, an % bn);
+      if (rem > size) size = rem;
+   }
+
+   return (2 * (size_t) bn) + size;
+}  /* end mlimb_mul_scratch() */
+
+/* Scratch limbs required by mlimb_sqr(), of `a[n]`. */
+static size_t mlimb_sqr_scratch(int n)
+{
+   int h;
+
+   if (n < KARATSUBA_SQR) return 0;
+   h = n - (n / 2);
+
+   return (3 * (size_t) (h + 1)) + mlimb_sqr_scratch(h + 1);
+}  /* end mlimb_sqr_scratch() */
+
+/* Multiply `a[an]` and `b[bn]` (an >= bn), into `r[an + bn]`, using
+ * `s[mlimb_mul_scratch(an, bn)]` as scratch. Balanced operands use
+ * Karatsuba (with sums of halves) above ::KARATSUBA_MUL limbs, and
+ * unbalanced operands are multiplied in `b[bn]` sized chunks. */
+static void mlimb_mul(mlimb *r, const mlimb *a, int an, const mlimb *b,
+   int bn, mlimb *s)
+{
+   mlimb *s1, *s2, *z1;
+   int m, h, off, len;
+
+   if (bn < KARATSUBA_MUL) {
+      mlimb_mul_base(r, a, an, b, bn);
+   } else if (an == bn) {
+      /* a * b = z2 * B^2m + (s1 * s2 - z2 - z0) * B^m + z0 */
+      m = an / 2;
+      h = an - m;
+      s1 = s;
+      s2 = s1 + h + 1;
+      z1 = s2 + h + 1;
+      s += 4 * (h + 1);
+      mlimb_mul(r, a, m, b, m, s);
+      mlimb_mul(&r[2 * m], &a[m], h, &b[m], h, s);
+      mlimb_add(s1, &a[m], h, a, m);
+      mlimb_add(s2, &b[m], h, b, m);
+      mlimb_mul(z1, s1, h + 1, s2, h + 1, s);
+      mlimb_sub_into(z1, 2 * (h + 1), r, 2 * m);
+      mlimb_sub_into(z1, 2 * (h + 1), &r[2 * m], 2 * h);
+      mlimb_add_into(&r[m], m + (2 * h), z1, 2 * (h + 1));
+   } else {
+      memset(r, 0, (size_t) (an + bn) * sizeof(mlimb));
+      for (off = 0; off < an; off += bn) {
+         len = an - off < bn ? an - off : bn;
+         if (len == bn) mlimb_mul(s, &a[off], bn, b, bn, &s[2 * bn]);
+         else mlimb_mul(s, b, bn, &a[off], len, &s[2 * bn]);
+         mlimb_add_into(&r[off], an + bn - off, s, len + bn);
+      }
+   }
+}  /* end mlimb_mul() */
+
+/* Square `a[n]`, into `r[2n]`, using `s[mlimb_sqr_scratch(n)]` as
+ * scratch. Uses Karatsuba squaring above ::KARATSUBA_SQR limbs. */
+static void mlimb_sqr(mlimb *r, const mlimb *a, int n, mlimb *s)
+{
+   mlimb *s1, *z1;
+   int m, h;
+
+   if (n < KARATSUBA_SQR) {
+      mlimb_sqr_base(r, a, n);
+      return;
+   }
+   /* a^2 = z2 * B^2m + (s1^2 - z2 - z0) * B^m + z0 */
+   m = n / 2;
+   h = n - m;
+   s1 = s;
+   z1 = s1 + h + 1;
+   s += 3 * (h + 1);
+   mlimb_sqr(r, a, m, s);
+   mlimb_sqr(&r[2 * m], &a[m], h, s);
+   mlimb_add(s1, &a[m], h, a, m);
+   mlimb_sqr(z1, s1, h + 1, s);
+   mlimb_sub_into(z1, 2 * (h + 1), r, 2 * m);
+   mlimb_sub_into(z1, 2 * (h + 1), &r[2 * m], 2 * h);
+   mlimb_add_into(&r[m], m + (2 * h), z1, 2 * (h + 1));
+}  /* end mlimb_sqr() */
+
+/* Multiply (or square, where @a bx is NULL) little-endian `ax[alen]`
+ * and `bx[blen]`, placing `cx[alen + blen]`. Operands are copied into
+ * (zero padded) limbs, such that @a cx may overlap either operand. */
+static int multi_mul_limbs(const void *ax, int alen, const void *bx,
+   int blen, void *cx)
+{
+   mlimb stack[MULTI_MUL_STACK];
+   mlimb *mem, *a, *b, *r;
+   const void *tp;
+   size_t need;
+   int an, bn, t;
+
+   an = (alen + MLIMB_BYTES - 1) / MLIMB_BYTES;
+   bn = (blen + MLIMB_BYTES - 1) / MLIMB_BYTES;
+   if (an < bn) {
+      /* multiplication is commutative; ensure an >= bn */
+      tp = ax, ax = bx, bx = tp;
+      t = alen, alen = blen, blen = t;
+      t = an, an = bn, bn = t;
+   }
+
+   /* operands, product and scratch limbs */
+   need = (size_t) (2 * (an + bn));
+   if (bx == NULL) need += mlimb_sqr_scratch(an);
+   else need += mlimb_mul_scratch(an, bn);
+   mem = stack;
+   if (need > MULTI_MUL_STACK) {
+      mem = malloc(need * sizeof(mlimb));
+      if (mem == NULL) goto FAIL_NOMEM;
+   }
+   a = mem;
+   b = a + an;
+   r = b + bn;
+   a[an - 1] = 0;
+   memcpy(a, ax, (size_t) alen);
+   if (bx == NULL) mlimb_sqr(r, a, an, r + an + bn);
+   else {
+      b[bn - 1] = 0;
+      memcpy(b, bx, (size_t) blen);
+      mlimb_mul(r, a, an, b, bn, r + an + bn);
+   }
+   memcpy(cx, r, (size_t) (alen + blen));
+   if (mem != stack) free(mem);
+
+   return 0;
+
+/* error handling */
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end multi_mul_limbs() */
+
+/* Load limb of little-endian `p[len]` at byte offset @a off, where
+ * @a off may exceed either bound. Bytes out of bounds read as zero. */
+static inline mlimb mlimb_load(const word8 *p, int len, int off)
+{
+   mlimb w = 0;
+   int i;
+
+   if (off >= 0 && off <= len - MLIMB_BYTES) {
+      memcpy(&w, &p[off], MLIMB_BYTES);
+      return w;
+   }
+   for (i = MLIMB_BYTES - 1; i >= 0; i--) {
+      w <<= 8;
+      if (off + i >= 0 && off + i < len) w |= p[off + i];
+   }
+
+   return w;
+}  /* end mlimb_load() */
+
+/* Store limb @a w to little-endian `p[len]` at byte offset @a off,
+ * where @a off may exceed either bound. Bytes out of bounds are
+ * not stored. */
+static inline void mlimb_store(word8 *p, int len, int off, mlimb w)
+{
+   int i;
+
+   if (off >= 0 && off <= len - MLIMB_BYTES) {
+      memcpy(&p[off], &w, MLIMB_BYTES);
+      return;
+   }
+   for (i = 0; i < MLIMB_BYTES; i++, w >>= 8) {
+      if (off + i >= 0 && off + i < len) p[off + i] = (word8) w;
+   }
+}  /* end mlimb_store() */
+
+/* Count leading zero bits of (non-zero) limb @a w. */
+static inline int mlimb_clz(mlimb w)
+{
+#if defined(__GNUC__) && MLIMB_BYTES == 8
+   return __builtin_clzll(w);
+
+#elif defined(__GNUC__)
+   return __builtin_clz(w);
+
+#elif defined(EXTMATH_CPUID) && defined(_MSC_VER) && \
+   (MLIMB_BYTES == 4 || defined(_M_X64))
+   unsigned long idx;
+
+   #if MLIMB_BYTES == 8
+      _BitScanReverse64(&idx, w);
+   #else
+      _BitScanReverse(&idx, w);
+   #endif
+   return (MLIMB_BITS - 1) - (int) idx;
+
+#else
+   int n = 0, s;
+
+   for (s = MLIMB_BITS / 2; s; s >>= 1) {
+      if ((w >> (MLIMB_BITS - s)) == 0) w <<= s, n += s;
+   }
+   return n;
+
+#endif
+}  /* end mlimb_clz() */
+
+/* Count trailing zero bits of (non-zero) limb @a w. */
+static inline int mlimb_ctz(mlimb w)
+{
+#if defined(__GNUC__) && MLIMB_BYTES == 8
+   return __builtin_ctzll(w);
+
+#elif defined(__GNUC__)
+   return __builtin_ctz(w);
+
+#elif defined(EXTMATH_CPUID) && defined(_MSC_VER) && \
+   (MLIMB_BYTES == 4 || defined(_M_X64))
+   unsigned long idx;
+
+   #if MLIMB_BYTES == 8
+      _BitScanForward64(&idx, w);
+   #else
+      _BitScanForward(&idx, w);
+   #endif
+   return (int) idx;
+
+#else
+   int n = 0, s;
+
+   for (s = MLIMB_BITS / 2; s; s >>= 1) {
+      if ((w & (((mlimb) 1 << s) - 1)) == 0) w >>= s, n += s;
+   }
+   return n;
+
+#endif
+}  /* end mlimb_ctz() */
+
+/* Count set bits of limb @a w. */
+static inline int mlimb_popcount(mlimb w)
+{
+#if defined(__GNUC__) && MLIMB_BYTES == 8
+   return __builtin_popcountll(w);
+
+#elif defined(__GNUC__)
+   return __builtin_popcount(w);
+
+#else
+   /* SWAR; sum bits in pairs, nibbles, then bytes */
+   w = w - ((w >> 1) & ((mlimb) -1 / 3));
+   w = (w & ((mlimb) -1 / 15 * 3)) + ((w >> 2) & ((mlimb) -1 / 15 * 3));
+   w = (w + (w >> 4)) & ((mlimb) -1 / 255 * 15);
+   return (int) ((mlimb) (w * ((mlimb) -1 / 255)) >> (MLIMB_BITS - 8));
+
+#endif
+}  /* end mlimb_popcount() */
+
+/* Decimal digits (and power of ten) of each chunk divided from limbs
+ * by mlimb_divrem_dec(), for multi_to_dec(). Without a double width
+ * limb, limbs are divided in halves by a smaller power of ten. */
+#if defined(MLIMB2)
+   #define DEC_DIGITS   19
+   #define DEC_BASE     WORD64_C(10000000000000000000)
+
+#elif MLIMB_BYTES == 8
+   #define DEC_DIGITS   9
+   #define DEC_BASE     1000000000
+
+#else
+   #define DEC_DIGITS   4
+   #define DEC_BASE     10000
+
+#endif
+
+/* Decimal digit pairs, "00" to "99", for multi_to_dec() */
+static const char Decpairs[201] =
+   "0001020304050607080910111213141516171819"
+   "2021222324252627282930313233343536373839"
+   "4041424344454647484950515253545556575859"
+   "6061626364656667686970717273747576777879"
+   "8081828384858687888990919293949596979899";
+
+/* Hexadecimal digits, for multi_to_hex() */
+static const char Hexdigits[17] = "0123456789abcdef";
+
+/* Divide `a[n]` by ::DEC_BASE in place, returning the remainder. */
+static mlimb mlimb_divrem_dec(mlimb *a, int n)
+{
+   mlimb r = 0;
+   int i;
+
+#ifdef MLIMB2
+   mlimb2 t;
+
+   for (i = n - 1; i >= 0; i--) {
+      t = r;
+      t = (t << 64) | a[i];
+      a[i] = (mlimb) (t / DEC_BASE);
+      r = (mlimb) (t % DEC_BASE);
+   }
+
+#else
+   const int half = MLIMB_BITS / 2;
+   const mlimb mask = ((mlimb) 1 << half) - 1;
+   mlimb t, q;
+
+   for (i = n - 1; i >= 0; i--) {
+      t = (r << half) | (a[i] >> half);
+      q = t / DEC_BASE;
+      t = ((t % DEC_BASE) << half) | (a[i] & mask);
+      a[i] = (q << half) | (t / DEC_BASE);
+      r = t % DEC_BASE;
+   }
+
+#endif
+
+   return r;
+}  /* end mlimb_divrem_dec() */
+
+/* Write @a v as @a width decimal digits, ending before @a p. */
+static void mlimb_dec_digits(char *p, mlimb v, int width)
+{
+   for ( ; width >= 2; width -= 2, v /= 100) {
+      p -= 2;
+      memcpy(p, &Decpairs[(v % 100) * 2], 2);
+   }
+   if (width) *(--p) = (char) ('0' + (v % 10));
+}  /* end mlimb_dec_digits() */
+
+/* Multiply `a[n]` by @a m and add @a c, returning the carry limb. */
+static mlimb mlimb_muladd_1(mlimb *a, int n, mlimb m, mlimb c)
+{
+   mlimb ph, pl;
+   int i;
+
+   for (i = 0; i < n; i++) {
+      pl = MLIMB_MUL(a[i], m, &ph);
+      pl += c;
+      ph += (pl < c);
+      a[i] = pl;
+      c = ph;
+   }
+
+   return c;
+}  /* end mlimb_muladd_1() */
+
+/* Limbs of a u256 value, and access to them as an mlimb array */
+#define U256_MLIMBS  (32 / MLIMB_BYTES)
+#if MLIMB_BYTES == 8
+   #define U256_LIMBS(u)   ((u)->q)
+#else
+   #define U256_LIMBS(u)   ((u)->w)
+#endif
+
+/* Multiply-accumulate `a * b + c + d`, placing the low limb in @a *lo
+ * and returning the high limb (which cannot overflow). */
+static inline mlimb mont_mac(mlimb a, mlimb b, mlimb c, mlimb d,
+   mlimb *lo)
+{
+   mlimb ph, pl;
+
+   pl = MLIMB_MUL(a, b, &ph);
+   pl += c;
+   ph += (pl < c);
+   pl += d;
+   ph += (pl < d);
+   *lo = pl;
+
+   return ph;
+}  /* end mont_mac() */
+
+/* Reduce `t[N + 1]` (less than 2n) to less than n, placing @a *c. */
+static inline void mont_final(const mlimb *n, mlimb *t, u256 *c)
+{
+   unsigned char b;
+   int i;
+
+   if (t[U256_MLIMBS] == 0) {
+      for (i = U256_MLIMBS - 1; i >= 0 && t[i] == n[i]; i--);
+      if (i >= 0 && t[i] < n[i]) goto DONE;
+   }
+   for (b = 0, i = 0; i < U256_MLIMBS; i++) {
+      b = MLIMB_SUBB(b, t[i], n[i], &t[i]);
+   }
+DONE:
+   memcpy(U256_LIMBS(c), t, sizeof(u256));
+}  /* end mont_final() */
+
+/* Montgomery reduction of `t[2N]` (t < R * n), placing t / R mod n
+ * in @a *c. Each step adds a multiple of n clearing the lowest limb. */
+static inline void mont_redc(const U256MONT *ctx, mlimb *t, u256 *c)
+{
+   const mlimb *n = U256_LIMBS(&ctx->n);
+   mlimb m, carry, top = 0;
+   int i, j;
+
+   for (i = 0; i < U256_MLIMBS; i++) {
+      m = t[i] * U256_LIMBS(&ctx->ninv)[0];
+      for (carry = 0, j = 0; j < U256_MLIMBS; j++) {
+         carry = mont_mac(n[j], m, t[i + j], carry, &t[i + j]);
+      }
+      /* add carry and previous top carry into next limb */
+      carry += top;
+      top = (carry < top);
+      t[i + U256_MLIMBS] += carry;
+      top += (t[i + U256_MLIMBS] < carry);
+   }
+   t[2 * U256_MLIMBS] = top;
+   mont_final(n, &t[U256_MLIMBS], c);
+}  /* end mont_redc() */
+
+/* Montgomery product of @a *a and @a *b, placing a * b / R mod n.
+ * Multiplication and reduction are interleaved, limb by limb (CIOS). */
+static void mont_mul(const U256MONT *ctx, const u256 *a, const u256 *b,
+   u256 *c)
+{
+   const mlimb *ap = U256_LIMBS(a), *bp = U256_LIMBS(b);
+   const mlimb *n = U256_LIMBS(&ctx->n);
+   mlimb t[U256_MLIMBS + 2] = { 0 };
+   mlimb m, carry;
+   int i, j;
+
+   for (i = 0; i < U256_MLIMBS; i++) {
+      for (carry = 0, j = 0; j < U256_MLIMBS; j++) {
+         carry = mont_mac(ap[j], bp[i], t[j], carry, &t[j]);
+      }
+      t[U256_MLIMBS] += carry;
+      t[U256_MLIMBS + 1] = (t[U256_MLIMBS] < carry);
+      /* add m * n, clearing the low limb, and shift down one limb */
+      m = t[0] * U256_LIMBS(&ctx->ninv)[0];
+      carry = mont_mac(n[0], m, t[0], 0, &t[0]);
+      for (j = 1; j < U256_MLIMBS; j++) {
+         carry = mont_mac(n[j], m, t[j], carry, &t[j - 1]);
+      }
+      t[U256_MLIMBS - 1] = t[U256_MLIMBS] + carry;
+      t[U256_MLIMBS] = t[U256_MLIMBS + 1] + (t[U256_MLIMBS - 1] < carry);
+   }
+   mont_final(n, t, c);
+}  /* end mont_mul() */
+
+/* Montgomery square of @a *a, placing a * a / R mod n. Cross products
+ * are computed once and doubled, before reduction. */
+static void mont_sqr(const U256MONT *ctx, const u256 *a, u256 *c)
+{
+   const mlimb *ap = U256_LIMBS(a);
+   mlimb t[(2 * U256_MLIMBS) + 1] = { 0 };
+   mlimb carry, top, hi;
+   int i, j;
+
+   for (i = 0; i < U256_MLIMBS - 1; i++) {
+      for (carry = 0, j = i + 1; j < U256_MLIMBS; j++) {
+         carry = mont_mac(ap[i], ap[j], t[i + j], carry, &t[i + j]);
+      }
+      t[i + U256_MLIMBS] = carry;
+   }
+   for (top = 0, i = 0; i < 2 * U256_MLIMBS; i++) {
+      hi = t[i] >> (MLIMB_BITS - 1);
+      t[i] = (t[i] << 1) | top;
+      top = hi;
+   }
+   for (carry = 0, i = 0; i < U256_MLIMBS; i++) {
+      carry = mont_mac(ap[i], ap[i], t[2 * i], carry, &t[2 * i]);
+      t[(2 * i) + 1] += carry;
+      carry = (t[(2 * i) + 1] < carry);
+   }
+   mont_redc(ctx, t, c);
+}  /* end mont_sqr() */
+
+/* Generic operation of cmp256_batch(), by cmp256() of each value. */
+static size_t cmp256_batch_base(const void *values, size_t n,
+   const void *target, void *out_mask)
+{
+   const word8 *vp = (const word8 *) values;
+   word8 *mp = (word8 *) out_mask;
+   unsigned bits = 0, lt;
+   size_t i, count = 0;
+
+   for (i = 0; i < n; i++, vp += 32) {
+      lt = (cmp256(vp, target) < 0);
+      bits |= lt << (i & 7);
+      count += lt;
+      if ((i & 7) == 7) mp[i >> 3] = (word8) bits, bits = 0;
+   }
+   if (n & 7) mp[n >> 3] = (word8) bits;
+
+   return count;
+}  /* end cmp256_batch_base() */
+
+/* Values from which sort256() radix sorts, rather than insertion sorts */
+#ifndef SORT256_RADIX
+   #define SORT256_RADIX   64
+#endif
+
+/* Radix sort record; a limb of a 256-bit value, and the value index */
+typedef struct {
+   mlimb key;
+   size_t idx;
+} SORT256REC;
+
+/* Insertion sort of 256-bit `vp[n]`, by cmp256(). */
+static void sort256_insertion(word8 *vp, size_t n)
+{
+   word8 t[32];
+   size_t i, j;
+
+   for (i = 1; i < n; i++) {
+      if (cmp256(&vp[(i - 1) * 32], &vp[i * 32]) <= 0) continue;
+      memcpy(t, &vp[i * 32], 32);
+      for (j = i; j > 0 && cmp256(&vp[(j - 1) * 32], t) > 0; j--) {
+         memcpy(&vp[j * 32], &vp[(j - 1) * 32], 32);
+      }
+      memcpy(&vp[j * 32], t, 32);
+   }
+}  /* end sort256_insertion() */
+
+/* Sort 256-bit `vp[n]`, whose limbs above @a limb are all equal, using
+ * `a[n]` and `b[n]` as scratch. Records of limb @a limb are sorted by
+ * LSD radix sort, 8 bits per pass, skipping passes of a single digit.
+ * Values are permuted into order, and runs of equal limbs are sorted
+ * by the next (less significant) limb. */
+static void sort256_limb(word8 *vp, size_t n, int limb, SORT256REC *a,
+   SORT256REC *b)
+{
+   size_t count[MLIMB_BYTES][256];
+   SORT256REC *r, *t;
+   size_t i, j, k, sum, tmp;
+   word8 v[32];
+   int d, shift;
+
+   if (n < SORT256_RADIX) {
+      sort256_insertion(vp, n);
+      return;
+   }
+
+   /* records and digit histograms of all passes */
+   memset(count, 0, sizeof(count));
+   for (i = 0; i < n; i++) {
+      memcpy(&a[i].key, &vp[(i * 32) + (limb * MLIMB_BYTES)], MLIMB_BYTES);
+      a[i].idx = i;
+      for (d = 0; d < MLIMB_BYTES; d++) {
+         count[d][(a[i].key >> (d * 8)) & 0xff]++;
+      }
+   }
+   for (r = a, t = b, d = 0; d < MLIMB_BYTES; d++) {
+      shift = d * 8;
+      /* skip pass where all records share a digit */
+      if (count[d][(r[0].key >> shift) & 0xff] == n) continue;
+      for (sum = 0, j = 0; j < 256; j++) {
+         tmp = count[d][j];
+         count[d][j] = sum;
+         sum += tmp;
+      }
+      for (i = 0; i < n; i++) {
+         t[count[d][(r[i].key >> shift) & 0xff]++] = r[i];
+      }
+      t = r, r = (r == a) ? b : a;
+   }
+
+   /* permute values into record order, by following cycles */
+   for (i = 0; i < n; i++) {
+      if (r[i].idx == i) continue;
+      memcpy(v, &vp[i * 32], 32);
+      for (j = i; (k = r[j].idx) != i; j = k) {
+         memcpy(&vp[j * 32], &vp[k * 32], 32);
+         r[j].idx = j;
+      }
+      memcpy(&vp[j * 32], v, 32);
+      r[j].idx = j;
+   }
+
+   /* sort runs of equal limbs by the next limb */
+   if (limb == 0) return;
+   for (i = 0; i < n; i = j) {
+      for (j = i + 1; j < n && r[j].key == r[i].key; j++);
+      if (j - i > 1) sort256_limb(&vp[i * 32], j - i, limb - 1, &r[i], &t[i]);
+   }
+}  /* end sort256_limb() */
+
+/* SIMD kernel guard */
+#ifdef EXTMATH_CPUID
+
+/* Check `bp[len]` contains all zeros, for @a len less than 16. Bytes
+ * are checked as (possibly overlapping) 32-bit words, where possible. */
+static inline int iszero_small(const word8 *bp, int len)
+{
+   word32 a, b, c, d;
+
+   if (len >= 8) {
+      memcpy(&a, bp, 4);
+      memcpy(&b, bp + 4, 4);
+      memcpy(&c, bp + len - 8, 4);
+      memcpy(&d, bp + len - 4, 4);
+      return (a | b | c | d) == 0;
+   }
+   if (len >= 4) {
+      memcpy(&a, bp, 4);
+      memcpy(&b, bp + len - 4, 4);
+      return (a | b) == 0;
+   }
+   for( ; len; bp++, len--) if(*bp) return 0;
+   return 1;
+}  /* end iszero_small() */
+
+/* SSE2 operation of iszero(), 64 bytes per iteration. The remainder
+ * is checked with an (overlapping) load of the final 16 bytes. */
+EXTMATH_ISA("sse2")
+static int iszero_sse2(const void *buff, int len)
+{
+   const word8 *bp = (const word8 *) buff;
+   const __m128i zero = _mm_setzero_si128();
+   __m128i x;
+
+   if (len < 16) return iszero_small(bp, len);
+   for( ; len >= 64; bp += 64, len -= 64) {
+      x = _mm_or_si128(
+         _mm_or_si128(_mm_loadu_si128((const __m128i *) bp),
+            _mm_loadu_si128((const __m128i *) (bp + 16))),
+         _mm_or_si128(_mm_loadu_si128((const __m128i *) (bp + 32)),
+            _mm_loadu_si128((const __m128i *) (bp + 48))));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, zero)) != 0xffff) return 0;
+   }
+   x = _mm_loadu_si128((const __m128i *) (bp + len - 16));
+   for( ; len > 16; bp += 16, len -= 16) {
+      x = _mm_or_si128(x, _mm_loadu_si128((const __m128i *) bp));
+   }
+
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(x, zero)) == 0xffff;
+}  /* end iszero_sse2() */
+
+/* AVX2 operation of iszero(), 64 bytes per iteration. The remainder
+ * is checked with an (overlapping) load of the final 32 bytes. */
+EXTMATH_ISA("avx2")
+static int iszero_avx2(const void *buff, int len)
+{
+   const word8 *bp = (const word8 *) buff;
+   __m256i y;
+
+   if (len < 32) return iszero_sse2(bp, len);
+   for( ; len >= 64; bp += 64, len -= 64) {
+      y = _mm256_or_si256(_mm256_loadu_si256((const __m256i *) bp),
+         _mm256_loadu_si256((const __m256i *) (bp + 32)));
+      if (!_mm256_testz_si256(y, y)) return 0;
+   }
+   y = _mm256_loadu_si256((const __m256i *) (bp + len - 32));
+   if (len > 32) {
+      y = _mm256_or_si256(y, _mm256_loadu_si256((const __m256i *) bp));
+   }
+
+   return _mm256_testz_si256(y, y);
+}  /* end iszero_avx2() */
+
+/* Check 256-bit `vp[32]` is less than (sign flipped) target words
+ * @a t0 and @a t1, by SSE2. Words are compared as signed (sign flipped)
+ * 32-bit words; the value is less than the target where the mask of
+ * less-than words exceeds the mask of greater-than words, as the most
+ * significant differing word decides. */
+EXTMATH_ISA("sse2")
+static inline unsigned cmp256_lt_sse2(const word8 *vp, __m128i t0,
+   __m128i t1)
+{
+   const __m128i sign = _mm_set1_epi32((int) 0x80000000);
+   __m128i v0, v1;
+   unsigned lt, gt;
+
+   v0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) vp), sign);
+   v1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (vp + 16)), sign);
+   lt = (unsigned) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(t0, v0)))
+      | ((unsigned) _mm_movemask_ps(
+         _mm_castsi128_ps(_mm_cmpgt_epi32(t1, v1))) << 4);
+   gt = (unsigned) _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v0, t0)))
+      | ((unsigned) _mm_movemask_ps(
+         _mm_castsi128_ps(_mm_cmpgt_epi32(v1, t1))) << 4);
+
+   return lt > gt;
+}  /* end cmp256_lt_sse2() */
+
+/* SSE2 operation of cmp256_batch(), 4 values per iteration. The most
+ * significant words of 4 values are compared at once, and only values
+ * with a most significant word equal to the target's (rare, for hashes)
+ * are compared in full. */
+EXTMATH_ISA("sse2")
+static size_t cmp256_batch_sse2(const void *values, size_t n,
+   const void *target, void *out_mask)
+{
+   const word8 *vp = (const word8 *) values;
+   const word8 *tp = (const word8 *) target;
+   word8 *mp = (word8 *) out_mask;
+   const __m128i sign = _mm_set1_epi32((int) 0x80000000);
+   __m128i t0, t1, top, h01, h23;
+   unsigned bits = 0, lt, eq;
+   size_t i, count = 0;
+   int j;
+
+   t0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) tp), sign);
+   t1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (tp + 16)), sign);
+   top = _mm_shuffle_epi32(t1, 0xff);
+   for (i = 0; i + 4 <= n; i += 4, vp += 128) {
+      /* gather most significant words of 4 values */
+      h01 = _mm_unpackhi_epi32(
+         _mm_loadu_si128((const __m128i *) (vp + 16)),
+         _mm_loadu_si128((const __m128i *) (vp + 48)));
+      h23 = _mm_unpackhi_epi32(
+         _mm_loadu_si128((const __m128i *) (vp + 80)),
+         _mm_loadu_si128((const __m128i *) (vp + 112)));
+      h01 = _mm_xor_si128(_mm_unpackhi_epi64(h01, h23), sign);
+      lt = (unsigned) _mm_movemask_ps(
+         _mm_castsi128_ps(_mm_cmpgt_epi32(top, h01)));
+      eq = (unsigned) _mm_movemask_ps(
+         _mm_castsi128_ps(_mm_cmpeq_epi32(top, h01)));
+      for (j = 0; eq; j++, eq >>= 1) {
+         if (eq & 1) lt |= cmp256_lt_sse2(vp + (j * 32), t0, t1) << j;
+      }
+      bits |= lt << (i & 7);
+      count += (lt & 1) + ((lt >> 1) & 1) + ((lt >> 2) & 1) + (lt >> 3);
+      if ((i & 7) == 4) mp[i >> 3] = (word8) bits, bits = 0;
+   }
+   for ( ; i < n; i++, vp += 32) {
+      lt = cmp256_lt_sse2(vp, t0, t1);
+      bits |= lt << (i & 7);
+      count += lt;
+   }
+   if (n & 7) mp[n >> 3] = (word8) bits;
+
+   return count;
+}  /* end cmp256_batch_sse2() */
+
+/* AVX2 operation of cmp256_batch(), as cmp256_batch_sse2(), comparing
+ * the most significant (sign flipped) 64-bit words of 4 values at once.
+ * Values with a most significant word equal to the target's are
+ * compared in full, as the 64-bit words of a single register. */
+EXTMATH_ISA("avx2")
+static size_t cmp256_batch_avx2(const void *values, size_t n,
+   const void *target, void *out_mask)
+{
+   const word8 *vp = (const word8 *) values;
+   word8 *mp = (word8 *) out_mask;
+   const __m256i sign = _mm256_set1_epi64x((long long) 0x8000000000000000ULL);
+   __m256i t, top, v, h01, h23;
+   unsigned bits = 0, lt, gt, eq;
+   size_t i, count = 0;
+   int j;
+
+   t = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) target), sign);
+   top = _mm256_permute4x64_epi64(t, 0xff);
+   for (i = 0; i + 4 <= n; i += 4, vp += 128) {
+      /* gather most significant words of 4 values */
+      h01 = _mm256_unpackhi_epi64(_mm256_loadu_si256((const __m256i *) vp),
+         _mm256_loadu_si256((const __m256i *) (vp + 32)));
+      h23 = _mm256_unpackhi_epi64(
+         _mm256_loadu_si256((const __m256i *) (vp + 64)),
+         _mm256_loadu_si256((const __m256i *) (vp + 96)));
+      h01 = _mm256_xor_si256(_mm256_permute2x128_si256(h01, h23, 0x31), sign);
+      lt = (unsigned) _mm256_movemask_pd(
+         _mm256_castsi256_pd(_mm256_cmpgt_epi64(top, h01)));
+      eq = (unsigned) _mm256_movemask_pd(
+         _mm256_castsi256_pd(_mm256_cmpeq_epi64(top, h01)));
+      for (j = 0; eq; j++, eq >>= 1) {
+         if ((eq & 1) == 0) continue;
+         v = _mm256_xor_si256(
+            _mm256_loadu_si256((const __m256i *) (vp + (j * 32))), sign);
+         gt = (unsigned) _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(v, t)));
+         lt |= ((unsigned) _mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpgt_epi64(t, v))) > gt) << j;
+      }
+      bits |= lt << (i & 7);
+      count += (lt & 1) + ((lt >> 1) & 1) + ((lt >> 2) & 1) + (lt >> 3);
+      if ((i & 7) == 4) mp[i >> 3] = (word8) bits, bits = 0;
+   }
+   for ( ; i < n; i++, vp += 32) {
+      v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) vp), sign);
+      gt = (unsigned) _mm256_movemask_pd(
+         _mm256_castsi256_pd(_mm256_cmpgt_epi64(v, t)));
+      lt = ((unsigned) _mm256_movemask_pd(
+         _mm256_castsi256_pd(_mm256_cmpgt_epi64(t, v))) > gt);
+      bits |= lt << (i & 7);
+      count += lt;
+   }
+   if (n & 7) mp[n >> 3] = (word8) bits;
+
+   return count;
+}  /* end cmp256_batch_avx2() */
+
+/* end SIMD kernel guard */
+#endif
+
+/* Get (sub)leaf @a leaf / @a sub of CPUID, into `r[4]` (eax..edx). */
+static void cpu_id(unsigned leaf, unsigned sub, unsigned r[4])
+{
+#if defined(EXTMATH_CPUID) && defined(_MSC_VER)
+   int t[4];
+
+   __cpuidex(t, (int) leaf, (int) sub);
+   r[0] = (unsigned) t[0];
+   r[1] = (unsigned) t[1];
+   r[2] = (unsigned) t[2];
+   r[3] = (unsigned) t[3];
+
+#elif defined(EXTMATH_CPUID)
+   __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+
+#else
+   (void) leaf;
+   (void) sub;
+   r[0] = r[1] = r[2] = r[3] = 0;
+
+#endif
+}  /* end cpu_id() */
+
+/* Check OS support for saving AVX (YMM) register state, via XGETBV. */
+static int cpu_avx_os(void)
+{
+#if defined(EXTMATH_CPUID) && defined(_MSC_VER)
+   return (_xgetbv(0) & 6) == 6;
+
+#elif defined(EXTMATH_CPUID)
+   unsigned lo, hi;
+
+   __asm__ volatile ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+   (void) hi;
+   return (lo & 6) == 6;
+
+#else
+   return 0;
+
+#endif
+}  /* end cpu_avx_os() */
+
+/**
+ * Get the features of the host CPU, as used by extmath kernel
+ * dispatch. Features are detected once, via CPUID.
+ * @returns Bitwise OR of `CPU_FEATURE_*` values.
+*/
+unsigned cpu_features(void)
+{
+   static volatile unsigned detected = 0;
+   unsigned r[4], features;
+
+   features = detected;
+   if (features) return features & ~CPU_FEATURE_DETECTED;
+
+   features = CPU_FEATURE_DETECTED;
+#ifdef HAS_64BIT
+   features |= CPU_FEATURE_X64;
+#endif
+   cpu_id(0, 0, r);
+   if (r[0] >= 1) {
+      cpu_id(1, 0, r);
+      if (r[3] & (1u << 26)) features |= CPU_FEATURE_SSE2;
+      if (r[2] & (1u << 9)) features |= CPU_FEATURE_SSSE3;
+      /* AVX requires OSXSAVE and OS support of YMM state */
+      if ((r[2] & (1u << 27)) && (r[2] & (1u << 28)) && cpu_avx_os()) {
+         cpu_id(0, 0, r);
+         if (r[0] >= 7) {
+            cpu_id(7, 0, r);
+            if (r[1] & (1u << 5)) features |= CPU_FEATURE_AVX2;
+         }
+      }
+      cpu_id(0, 0, r);
+      if (r[0] >= 7) {
+         cpu_id(7, 0, r);
+         if (r[1] & (1u << 8)) features |= CPU_FEATURE_BMI2;
+         if (r[1] & (1u << 19)) features |= CPU_FEATURE_ADX;
+      }
+   }
+   detected = features;
+
+   return features & ~CPU_FEATURE_DETECTED;
+}  /* end cpu_features() */
+
+/* Kernel resolvers, for the first call of each dispatched function. */
+static int iszero_resolve(const void *buff, int len);
+static int cmp256_resolve(const void *ax, const void *bx);
+static size_t cmp256_batch_resolve(const void *values, size_t n,
+   const void *target, void *out_mask);
+static int multi_add_resolve(const void *ax, const void *bx, void *cx,
+   int bytelen);
+static int multi_sub_resolve(const void *ax, const void *bx, void *cx,
+   int bytelen);
+static int u256_mul_resolve(const u256 *a, const u256 *b,
+   u256 *lo, u256 *hi);
+
+/* Dispatched kernels, and the features selecting them */
+static int (*Kiszero)(const void *, int) = iszero_resolve;
+static int (*Kcmp256)(const void *, const void *) = cmp256_resolve;
+static size_t (*Kcmp256_batch)(const void *, size_t, const void *,
+   void *) = cmp256_batch_resolve;
+static int (*Kmulti_add)(const void *, const void *, void *, int) =
+   multi_add_resolve;
+static int (*Kmulti_sub)(const void *, const void *, void *, int) =
+   multi_sub_resolve;
+static int (*Ku256_mul)(const u256 *, const u256 *, u256 *, u256 *) =
+   u256_mul_resolve;
+static volatile unsigned Kfeatures;
+
+static int iszero_resolve(const void *buff, int len)
+{
+   extmath_dispatch(CPU_FEATURE_ALL);
+   return Kiszero(buff, len);
+}
+
+static int cmp256_resolve(const void *ax, const void *bx)
+{
+   extmath_dispatch(CPU_FEATURE_ALL);
+   return Kcmp256(ax, bx);
+}
+
+static size_t cmp256_batch_resolve(const void *values, size_t n,
+   const void *target, void *out_mask)
+{
+   extmath_dispatch(CPU_FEATURE_ALL);
+   return Kcmp256_batch(values, n, target, out_mask);
+}
+
+static int multi_add_resolve(const void *ax, const void *bx, void *cx,
+   int bytelen)
+{
+   extmath_dispatch(CPU_FEATURE_ALL);
+   return Kmulti_add(ax, bx, cx, bytelen);
+}
+
+static int multi_sub_resolve(const void *ax, const void *bx, void *cx,
+   int bytelen)
+{
+   extmath_dispatch(CPU_FEATURE_ALL);
+   return Kmulti_sub(ax, bx, cx, bytelen);
+}
+
+static int u256_mul_resolve(const u256 *a, const u256 *b,
+   u256 *lo, u256 *hi)
+{
+   extmath_dispatch(CPU_FEATURE_ALL);
+   return Ku256_mul(a, b, lo, hi);
+}
+
+/**
+ * Select the kernels of dispatched extmath functions (iszero(),
+ * cmp256(), cmp256_batch(), multi_add(), multi_sub() and u256_mul()),
+ * and of bswap32/64_array() and rand_fill(), using only the @a features
+ * also supported by the host CPU. Kernels are otherwise selected
+ * automatically, with all supported features, at startup (where
+ * supported by the compiler) or on first use.
+ * Used to override the automatic selection, such as for benchmarks.
+ * @param features Bitwise OR of `CPU_FEATURE_*` values to allow, or
+ * ::CPU_FEATURE_ALL for the best kernels, or 0 for generic 32-bit
+ * (`_x86`) kernels
+ * @returns Features of the selected kernels.
+ * @note Not intended to be called concurrently with dispatched
+ * functions; selection should occur before threads are started.
+*/
+unsigned extmath_dispatch(unsigned features)
+{
+   unsigned used = 0;
+
+   features &= cpu_features();
+   Kiszero = iszero_x86;
+   Kcmp256 = cmp256_x86;
+   Kcmp256_batch = cmp256_batch_base;
+   Kmulti_add = multi_add_x86;
+   Kmulti_sub = multi_sub_x86;
+   Ku256_mul = u256_mul_x86;
+#ifdef HAS_64BIT
+   if (features & CPU_FEATURE_X64) {
+      used |= CPU_FEATURE_X64;
+      Kiszero = iszero_x64;
+      Kcmp256 = cmp256_x64;
+      Kmulti_add = multi_add_x64;
+      Kmulti_sub = multi_sub_x64;
+      Ku256_mul = u256_mul_x64;
+   #ifdef EXTMATH_TARGET
+      if (features & CPU_FEATURE_BMI2) {
+         used |= CPU_FEATURE_BMI2;
+         Ku256_mul = u256_mul_bmi2;
+      #ifdef __x86_64__
+         if (features & CPU_FEATURE_ADX) {
+            used |= CPU_FEATURE_ADX;
+            Ku256_mul = u256_mul_adx;
+         }
+      #endif
+      }
+   #endif
+   }
+#endif
+#ifdef EXTMATH_CPUID
+   if (features & CPU_FEATURE_SSE2) {
+      used |= CPU_FEATURE_SSE2;
+      Kiszero = iszero_sse2;
+      Kcmp256_batch = cmp256_batch_sse2;
+   }
+   if (features & CPU_FEATURE_SSSE3) {
+      /* selects the byte shuffle kernels of bswap32/64_array() */
+      used |= CPU_FEATURE_SSSE3;
+   }
+   if (features & CPU_FEATURE_AVX2) {
+      used |= CPU_FEATURE_AVX2;
+      Kiszero = iszero_avx2;
+      Kcmp256_batch = cmp256_batch_avx2;
+   }
+#endif
+   Kfeatures = used;
+
+   return used;
+}  /* end extmath_dispatch() */
+
+#ifdef __GNUC__
+   /* Select kernels at startup, before any threads may be started. */
+   __attribute__((constructor)) static void extmath_startup(void)
+   {
+      extmath_dispatch(CPU_FEATURE_ALL);
+   }
+
+#endif
+
+/**
+ * Get the features of the selected kernels of dispatched extmath
+ * functions. Selects kernels automatically if not yet selected.
+ * @returns Bitwise OR of `CPU_FEATURE_*` values.
+*/
+unsigned extmath_features(void)
+{
+   if (Kiszero == iszero_resolve) extmath_dispatch(CPU_FEATURE_ALL);
+
+   return Kfeatures;
+}  /* end extmath_features() */
+
+/**
+ * Check if `buff[len]` contains all zeros.
+ * @param buff Pointer to buffer to check contains zeros
+ * @param len The length of buffer, in bytes, to check
+ * @returns 1 if `buff[len]` is all zeros, else 0.
+ * @note Uses SSE2 or AVX2 kernels, as selected by extmath_dispatch().
+*/
+int iszero(const void *buff, int len)
+{
+   return Kiszero(buff, len);
+}  /* end iszero() */
+
+/**
+ * 64-bit addition of @a *ax and @a *bx. Result is placed in @a *cx.
+ * @param ax Pointer to 64-bit value to add to
+ * @param bx Pointer to 64-bit value to add
+ * @param cx Pointer to place result of 64-bit addition
+ * @returns Resulting carry of operation.
+*/
+int add64(const void *ax, const void *bx, void *cx)
+{
+#ifdef HAS_64BIT
+   return add64_x64(ax, bx, cx);
+
+#else
+   return add64_x86(ax, bx, cx);
+
+#endif
+}  /* end add64() */
+
+/**
+ * 64-bit subtraction of @a *bx from @a *ax.
+ * Result is placed in @a *cx.
+ * @param ax Pointer to 64-bit value to subtract from
+ * @param bx Pointer to 64-bit value to subtract
+ * @param cx Pointer to place result of 64-bit subtraction
+ * @returns Resulting carry of operation.
+*/
+int sub64(const void *ax, const void *bx, void *cx)
+{
+#ifdef HAS_64BIT
+   return sub64_x64(ax, bx, cx);
+
+#else
+   return sub64_x86(ax, bx, cx);
+
+#endif
+}  /* end sub64() */
+
+/**
+ * Swap sign on 64-bit @a *ax. Equivalent to @a *ax multiplied by (-1).
+ * @param ax Pointer to 64-bit value to "negate"
+*/
+void negate64(void *ax)
+{
+#ifdef HAS_64BIT
+   negate64_x64(ax);
+
+#else
+   negate64_x86(ax);
+
+#endif
+}  /* end negate64() */
+
+/**
+ * 64-bit unsigned compare @a *ax to @a *bx.
+ * @param ax Pointer to 64-bit value to compare to
+ * @param bx Pointer to 64-bit value to compare
+ * @retval -1 if @a *ax < @a *bx
+ * @retval 1 if @a *ax > @a *bx
+ * @retval 0 if @a *ax == @a *bx.
+*/
+int cmp64(const void *ax, const void *bx)
+{
+#ifdef HAS_64BIT
+   return cmp64_x64(ax, bx);
+
+#else
+   return cmp64_x86(ax, bx);
+
+#endif
+}  /* end cmp64() */
+
+/**
+ * 256-bit unsigned compare @a *ax to @a *bx.
+ * @param ax Pointer to 256-bit value to compare to
+ * @param bx Pointer to 256-bit value to compare
+ * @retval -1 if @a *ax < @a *bx
+ * @retval 1 if @a *ax > @a *bx
+ * @retval 0 if @a *ax == @a *bx.
+*/
+int cmp256(const void *ax, const void *bx)
+{
+   return Kcmp256(ax, bx);
+}  /* end cmp256() */
+
+/**
+ * Compare `n` 256-bit values, at @a values, to a 256-bit @a target.
+ * Values are compared as cmp256(), most significant word first, and
+ * with SIMD instructions where available. Set bit `i & 7` of byte
+ * `i >> 3` in @a out_mask where value `i` is less than @a target, and
+ * clear it otherwise. Bits beyond `n` in the final byte are cleared.
+ * @param values Pointer to array of `n` 32-byte values to compare
+ * @param n Number of values to compare
+ * @param target Pointer to 32-byte value to compare to
+ * @param out_mask Pointer to place result bits, of `(n + 7) / 8` bytes
+ * @returns Number of values less than @a target.
+*/
+size_t cmp256_batch(const void *values, size_t n, const void *target,
+   void *out_mask)
+{
+   return Kcmp256_batch(values, n, target, out_mask);
+}  /* end cmp256_batch() */
+
+/**
+ * Sort `n` 256-bit values, at @a values, into ascending order (as per
+ * cmp256()). Values are sorted by LSD radix sort of their most
+ * significant 64-bit (or 32-bit) limb, skipping passes of equal digits,
+ * and runs of equal limbs are sorted likewise by following limbs. Small
+ * arrays (and runs) are insertion sorted.
+ * @param values Pointer to array of `n` 32-byte values to sort
+ * @param n Number of values to sort
+ * @returns 0 on success, or (-1) on error. Check errno for details.
+ * @exception errno=EINVAL Parameter @a values is NULL
+ * @exception errno=ENOMEM Insufficient memory for radix sort records
+*/
+int sort256(void *values, size_t n)
+{
+   SORT256REC *mem;
+
+   if (values == NULL) goto FAIL_INVAL;
+   if (n < SORT256_RADIX) {
+      sort256_insertion((word8 *) values, n);
+      return 0;
+   }
+   if (n > ((size_t) -1) / (2 * sizeof(SORT256REC))) goto FAIL_NOMEM;
+   mem = malloc(2 * n * sizeof(SORT256REC));
+   if (mem == NULL) goto FAIL_NOMEM;
+   sort256_limb((word8 *) values, n, U256_MLIMBS - 1, mem, &mem[n]);
+   free(mem);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end sort256() */
+
+/**
+ * 64-bit shift @a *ax one to the right.
+ * @param ax Pointer to 64-bit value to shift
+*/
+void shiftr64(void *ax)
+{
+#ifdef HAS_64BIT
+   shiftr64_x64(ax);
+
+#else
+   shiftr64_x86(ax);
+
+#endif
+}  /* end shiftr64() */
+
+/**
+ * 64-bit multiplication of @a *ax and @a *bx.
+ * Result is placed in @a *cx.
+ * @param ax Pointer to 64-bit value to multiply
+ * @param bx Pointer to 64-bit value to multiply by
+ * @param cx Pointer to place result of 64-bit multiplication
+ * @result 1 if multiplication results in overflow, else 0.
+*/
+int mult64(const void *ax, const void *bx, void *cx)
+{
+#ifdef HAS_64BIT
+   return mult64_x64(ax, bx, cx);
+
+#else
+   return mult64_x86(ax, bx, cx);
+
+#endif
+}  /* end mult64() */
+
+/**
+ * Full width 64-bit multiplication of @a *ax and @a *bx. The 128-bit
+ * product is placed in @a *lo (low 64 bits) and @a *hi (high 64 bits).
+ * @param ax Pointer to 64-bit value to multiply
+ * @param bx Pointer to 64-bit value to multiply by
+ * @param lo Pointer to place low 64 bits of product
+ * @param hi Pointer to place high 64 bits of product, or NULL
+ * @returns 1 if the product exceeds 64 bits (@a *hi is non-zero),
+ * else 0.
+*/
+int mult64_full(const void *ax, const void *bx, void *lo, void *hi)
+{
+#ifdef HAS_64BIT
+   return mult64_full_x64(ax, bx, lo, hi);
+
+#else
+   return mult64_full_x86(ax, bx, lo, hi);
+
+#endif
+}  /* end mult64_full() */
+
+/**
+ * Multi-byte addition of `ax[bytelen]` and `bx[bytelen]`.
+ * Place result in `cx[bytelen]`. Values are little-endian, and are
+ * added in 64-bit (or 32-bit) limbs, then bytes for remaining length.
+ * @param ax Pointer to multi-byte value to add to
+ * @param bx Pointer to multi-byte value to add
+ * @param cx Pointer to place result of multi-byte addition
+ * @param bytelen Length of multi-byte values, in bytes
+ * @returns Resulting carry of operation.
+*/
+int multi_add(const void *ax, const void *bx, void *cx, int bytelen)
+{
+   return Kmulti_add(ax, bx, cx, bytelen);
+}  /* end multi_add() */
+
+/**
  * Multi-byte subtraction of `bx[bytelen]` from `ax[bytelen]`.
- * Place result in `cx[bytelen]`.
+ * Place result in `cx[bytelen]`. Values are little-endian, and are
+ * subtracted in 64-bit (or 32-bit) limbs, then bytes for remaining
+ * length.
  * @param ax Pointer to multi-byte value to subtract from
  * @param bx Pointer to multi-byte value to subtract
  * @param cx Pointer to place result of multi-byte subtraction
+ * @param bytelen Length of multi-byte values, in bytes
  * @returns Resulting carry of operation.
 */
 int multi_sub(const void *ax, const void *bx, void *cx, int bytelen)
 {
-   word8 *a, *b, *c;
-   int t, carry = 0;
+   return Kmulti_sub(ax, bx, cx, bytelen);
+}  /* end multi_sub() */
+
+/**
+ * Multi-precision multiplication of `ax[alen]` and `bx[blen]`. Place
+ * the full product in `cx[alen + blen]`. Values are little-endian, and
+ * are multiplied in 64-bit (or 32-bit) limbs; by schoolbook method for
+ * small values, and by Karatsuba's method for large values. Squares
+ * (where `ax == bx` and `alen == blen`) are computed by multi_sqr().
+ * @param ax Pointer to multi-byte value to multiply
+ * @param alen Length of multi-byte value @a ax, in bytes
+ * @param bx Pointer to multi-byte value to multiply by
+ * @param blen Length of multi-byte value @a bx, in bytes
+ * @param cx Pointer to place product, of `alen + blen` bytes,
+ * which may overlap @a ax or @a bx
+ * @returns 0 on success, or (-1) on error. Check errno for details.
+ * @exception errno=EINVAL A parameter is NULL or a length is not positive
+ * @exception errno=ENOMEM Insufficient memory for large values
+*/
+int multi_mul(const void *ax, int alen, const void *bx, int blen,
+   void *cx)
+{
+   if (ax == NULL || bx == NULL || cx == NULL) goto FAIL_INVAL;
+   if (alen <= 0 || blen <= 0) goto FAIL_INVAL;
+   if (ax == bx && alen == blen) bx = NULL;
 
-   if(bytelen < 1) return 0;
+   return multi_mul_limbs(ax, alen, bx, blen, cx);
 
-   a = (word8 *) ax;
-   b = (word8 *) bx;
-   c = (word8 *) cx;
-   for( ; bytelen; a++, b++, c++, bytelen--) {
-      t = *a - *b - carry;
-      carry = (t >> 8) & 1;
-      *c = t;
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end multi_mul() */
+
+/**
+ * Multi-precision squaring of `ax[alen]`. Place the full square in
+ * `cx[2 * alen]`. Cross products are computed once, making squaring
+ * faster than multi_mul() of distinct values.
+ * @param ax Pointer to multi-byte value to square
+ * @param alen Length of multi-byte value @a ax, in bytes
+ * @param cx Pointer to place square, of `2 * alen` bytes,
+ * which may overlap @a ax
+ * @returns 0 on success, or (-1) on error. Check errno for details.
+ * @exception errno=EINVAL A parameter is NULL or a length is not positive
+ * @exception errno=ENOMEM Insufficient memory for large values
+*/
+int multi_sqr(const void *ax, int alen, void *cx)
+{
+   if (ax == NULL || cx == NULL || alen <= 0) goto FAIL_INVAL;
+
+   return multi_mul_limbs(ax, alen, NULL, alen, cx);
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end multi_sqr() */
+
+/**
+ * Multi-byte left shift of `ax[bytelen]` by @a n bits. Place result in
+ * `cx[bytelen]`. Values are little-endian, and are shifted in 64-bit
+ * (or 32-bit) limbs. Bits shifted beyond @a bytelen are discarded.
+ * @param ax Pointer to multi-byte value to shift
+ * @param n Number of bits to shift; `bytelen * 8` or more results in
+ * zero, and zero (or less) results in a copy
+ * @param cx Pointer to place result of shift, which may be @a ax
+ * @param bytelen Length of multi-byte values, in bytes
+*/
+void multi_shl(const void *ax, int n, void *cx, int bytelen)
+{
+   const word8 *a = (const word8 *) ax;
+   word8 *c = (word8 *) cx;
+   mlimb hi, lo;
+   int q, b, off;
+
+   if (bytelen <= 0) return;
+   if (n <= 0) {
+      if (c != a) memmove(c, a, (size_t) bytelen);
+      return;
    }
+   q = n >> 3;
+   b = n & 7;
+   if (q >= bytelen) {
+      memset(c, 0, (size_t) bytelen);
+      return;
+   }
+   /* from the top; each limb reads only bytes below those stored */
+   off = bytelen - MLIMB_BYTES;
+   hi = mlimb_load(a, bytelen, off - q);
+   for ( ; off > -MLIMB_BYTES; off -= MLIMB_BYTES) {
+      lo = mlimb_load(a, bytelen, off - q - MLIMB_BYTES);
+      if (b) hi = (hi << b) | (lo >> (MLIMB_BITS - b));
+      mlimb_store(c, bytelen, off, hi);
+      hi = lo;
+   }
+}  /* end multi_shl() */
 
-   return carry;
-}  /* end multi_sub() */
+/**
+ * Multi-byte right shift of `ax[bytelen]` by @a n bits. Place result in
+ * `cx[bytelen]`. Values are little-endian, and are shifted in 64-bit
+ * (or 32-bit) limbs. Bits shifted below zero are discarded.
+ * @param ax Pointer to multi-byte value to shift
+ * @param n Number of bits to shift; `bytelen * 8` or more results in
+ * zero, and zero (or less) results in a copy
+ * @param cx Pointer to place result of shift, which may be @a ax
+ * @param bytelen Length of multi-byte values, in bytes
+*/
+void multi_shr(const void *ax, int n, void *cx, int bytelen)
+{
+   const word8 *a = (const word8 *) ax;
+   word8 *c = (word8 *) cx;
+   mlimb hi, lo;
+   int q, b, off;
+
+   if (bytelen <= 0) return;
+   if (n <= 0) {
+      if (c != a) memmove(c, a, (size_t) bytelen);
+      return;
+   }
+   q = n >> 3;
+   b = n & 7;
+   if (q >= bytelen) {
+      memset(c, 0, (size_t) bytelen);
+      return;
+   }
+   /* from the bottom; each limb reads only bytes above those stored */
+   off = 0;
+   lo = mlimb_load(a, bytelen, q);
+   for ( ; off < bytelen; off += MLIMB_BYTES) {
+      hi = mlimb_load(a, bytelen, off + q + MLIMB_BYTES);
+      if (b) lo = (lo >> b) | (hi << (MLIMB_BITS - b));
+      mlimb_store(c, bytelen, off, lo);
+      lo = hi;
+   }
+}  /* end multi_shr() */
+
+/**
+ * Count leading (most significant) zero bits of little-endian
+ * `ax[bytelen]`, in 64-bit (or 32-bit) limbs.
+ * @param ax Pointer to multi-byte value to scan
+ * @param bytelen Length of multi-byte value, in bytes
+ * @returns Number of leading zero bits, or `bytelen * 8` if zero.
+*/
+int multi_clz(const void *ax, int bytelen)
+{
+   const word8 *a = (const word8 *) ax;
+   mlimb w;
+   int off;
+
+   for (off = bytelen - MLIMB_BYTES; off > -MLIMB_BYTES;
+         off -= MLIMB_BYTES) {
+      w = mlimb_load(a, bytelen, off);
+      if (w) return ((bytelen - off - MLIMB_BYTES) * 8) + mlimb_clz(w);
+   }
+
+   return bytelen > 0 ? bytelen * 8 : 0;
+}  /* end multi_clz() */
+
+/**
+ * Count trailing (least significant) zero bits of little-endian
+ * `ax[bytelen]`, in 64-bit (or 32-bit) limbs.
+ * @param ax Pointer to multi-byte value to scan
+ * @param bytelen Length of multi-byte value, in bytes
+ * @returns Number of trailing zero bits, or `bytelen * 8` if zero.
+*/
+int multi_ctz(const void *ax, int bytelen)
+{
+   const word8 *a = (const word8 *) ax;
+   mlimb w;
+   int off;
+
+   for (off = 0; off < bytelen; off += MLIMB_BYTES) {
+      w = mlimb_load(a, bytelen, off);
+      if (w) return (off * 8) + mlimb_ctz(w);
+   }
+
+   return bytelen > 0 ? bytelen * 8 : 0;
+}  /* end multi_ctz() */
+
+/**
+ * Count set bits of `ax[bytelen]`, in 64-bit (or 32-bit) limbs.
+ * @param ax Pointer to multi-byte value to count
+ * @param bytelen Length of multi-byte value, in bytes
+ * @returns Number of set bits.
+*/
+int multi_popcount(const void *ax, int bytelen)
+{
+   const word8 *a = (const word8 *) ax;
+   int off, count = 0;
+
+   for (off = 0; off < bytelen; off += MLIMB_BYTES) {
+      count += mlimb_popcount(mlimb_load(a, bytelen, off));
+   }
+
+   return count;
+}  /* end multi_popcount() */
+
+/**
+ * Convert little-endian `ax[bytelen]` to a decimal string. Digits are
+ * divided from the value in chunks of 19 digits (a power of ten per
+ * 64-bit limb, where supported), and written in pairs.
+ * @param ax Pointer to multi-byte value to convert
+ * @param bytelen Length of multi-byte value, in bytes
+ * @param str Pointer to buffer to place nul-terminated string
+ * @param len Length of @a str buffer, in bytes
+ * @returns Length of string (excluding nul), or (-1) on error.
+ * Check errno for details.
+ * @exception errno=EINVAL A parameter is NULL or @a bytelen is not
+ * positive
+ * @exception errno=ENOMEM Insufficient memory for large values
+ * @exception errno=ERANGE String (and nul) exceeds @a len bytes
+*/
+int multi_to_dec(const void *ax, int bytelen, char *str, size_t len)
+{
+   mlimb stack[MULTI_MUL_STACK];
+   mlimb *mem, *a, *chunk;
+   size_t need, digits;
+   int n, count, width;
+   mlimb v;
+
+   if (ax == NULL || str == NULL || bytelen <= 0) goto FAIL_INVAL;
+
+   /* limbs of value, and chunks (at most one digit per 3 bits) */
+   n = (bytelen + MLIMB_BYTES - 1) / MLIMB_BYTES;
+   need = (size_t) n + ((size_t) n * MLIMB_BITS / (3 * DEC_DIGITS)) + 2;
+   mem = stack;
+   if (need > MULTI_MUL_STACK) {
+      mem = malloc(need * sizeof(mlimb));
+      if (mem == NULL) goto FAIL_NOMEM;
+   }
+   a = mem;
+   chunk = a + n;
+   a[n - 1] = 0;
+   memcpy(a, ax, (size_t) bytelen);
+
+   /* divide chunks from value, least significant first */
+   count = 0;
+   do {
+      while (n > 1 && a[n - 1] == 0) n--;
+      if (n == 1 && a[0] < DEC_BASE) {
+         chunk[count++] = a[0];
+         break;
+      }
+      chunk[count++] = mlimb_divrem_dec(a, n);
+   } while (1);
+
+   /* most significant chunk has no leading zeros */
+   for (width = 1, v = chunk[count - 1]; v >= 10; v /= 10) width++;
+   digits = (size_t) width + ((size_t) (count - 1) * DEC_DIGITS);
+   if (digits >= len) {
+      if (mem != stack) free(mem);
+      set_errno(ERANGE);
+      return (-1);
+   }
+   mlimb_dec_digits(str + width, chunk[--count], width);
+   for (str += width; count > 0; str += DEC_DIGITS) {
+      mlimb_dec_digits(str + DEC_DIGITS, chunk[--count], DEC_DIGITS);
+   }
+   *str = '\0';
+   if (mem != stack) free(mem);
+
+   return (int) digits;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end multi_to_dec() */
+
+/**
+ * Convert little-endian `ax[bytelen]` to a (lowercase) hexadecimal
+ * string, without prefix or leading zeros.
+ * @param ax Pointer to multi-byte value to convert
+ * @param bytelen Length of multi-byte value, in bytes
+ * @param str Pointer to buffer to place nul-terminated string
+ * @param len Length of @a str buffer, in bytes
+ * @returns Length of string (excluding nul), or (-1) on error.
+ * Check errno for details.
+ * @exception errno=EINVAL A parameter is NULL or @a bytelen is not
+ * positive
+ * @exception errno=ERANGE String (and nul) exceeds @a len bytes
+*/
+int multi_to_hex(const void *ax, int bytelen, char *str, size_t len)
+{
+   const word8 *a = (const word8 *) ax;
+   size_t digits;
+   int i;
+
+   if (ax == NULL || str == NULL || bytelen <= 0) goto FAIL_INVAL;
+
+   /* skip leading zero bytes (and nibble) */
+   for (i = bytelen - 1; i > 0 && a[i] == 0; i--);
+   digits = ((size_t) i * 2) + (a[i] > 0xf ? 2 : 1);
+   if (digits >= len) goto FAIL_RANGE;
+   if (a[i] > 0xf) *(str++) = Hexdigits[a[i] >> 4];
+   for (*(str++) = Hexdigits[a[i] & 0xf]; i > 0; str += 2) {
+      i--;
+      str[0] = Hexdigits[a[i] >> 4];
+      str[1] = Hexdigits[a[i] & 0xf];
+   }
+   *str = '\0';
+
+   return (int) digits;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_RANGE: set_errno(ERANGE); return (-1);
+}  /* end multi_to_hex() */
+
+/**
+ * Convert a decimal string to little-endian `cx[bytelen]`. Digits are
+ * accumulated in chunks of 19 digits (or 9, with 32-bit limbs).
+ * @param str Pointer to nul-terminated string of decimal digits
+ * @param cx Pointer to place multi-byte value
+ * @param bytelen Length of multi-byte value, in bytes
+ * @returns 0 on success, or (-1) on error. Check errno for details.
+ * @exception errno=EINVAL A parameter is NULL, @a bytelen is not
+ * positive, or @a str is empty or contains a non-decimal character
+ * @exception errno=ENOMEM Insufficient memory for large values
+ * @exception errno=ERANGE Value exceeds @a bytelen bytes
+ * @note @a cx is not modified on error.
+*/
+int multi_from_dec(const char *str, void *cx, int bytelen)
+{
+   mlimb stack[MULTI_MUL_STACK];
+   mlimb *a, chunk, scale;
+   const char *sp;
+   int n, k, i;
+
+   if (str == NULL || cx == NULL || bytelen <= 0) goto FAIL_INVAL;
+   if (*str == '\0') goto FAIL_INVAL;
+   for (sp = str; *sp; sp++) if (*sp < '0' || *sp > '9') goto FAIL_INVAL;
+
+   n = (bytelen + MLIMB_BYTES - 1) / MLIMB_BYTES;
+   a = stack;
+   if (n > MULTI_MUL_STACK) {
+      a = malloc((size_t) n * sizeof(mlimb));
+      if (a == NULL) goto FAIL_NOMEM;
+   }
+   memset(a, 0, (size_t) n * sizeof(mlimb));
+
+   /* accumulate chunks; value = (value * 10^k) + chunk */
+   for (sp = str; *sp; ) {
+      chunk = 0;
+      scale = 1;
+      for (k = 0; k < (MLIMB_BYTES == 8 ? 19 : 9) && *sp; k++, sp++) {
+         chunk = (chunk * 10) + (mlimb) (*sp - '0');
+         scale *= 10;
+      }
+      if (mlimb_muladd_1(a, n, scale, chunk)) goto FAIL_RANGE;
+   }
+   /* bytes of the final limb beyond bytelen must be zero */
+   for (i = bytelen; i < n * MLIMB_BYTES; i++) {
+      if ((a[i / MLIMB_BYTES] >> ((i % MLIMB_BYTES) * 8)) & 0xff) {
+         goto FAIL_RANGE;
+      }
+   }
+   memcpy(cx, a, (size_t) bytelen);
+   if (a != stack) free(a);
+
+   return 0;
+
+/* error handling */
+FAIL_RANGE:
+   if (a != stack) free(a);
+   set_errno(ERANGE);
+   return (-1);
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM); return (-1);
+}  /* end multi_from_dec() */
+
+/**
+ * Convert a hexadecimal string, with optional "0x" prefix, to
+ * little-endian `cx[bytelen]`. Digits may be upper or lowercase.
+ * @param str Pointer to nul-terminated string of hexadecimal digits
+ * @param cx Pointer to place multi-byte value
+ * @param bytelen Length of multi-byte value, in bytes
+ * @returns 0 on success, or (-1) on error. Check errno for details.
+ * @exception errno=EINVAL A parameter is NULL, @a bytelen is not
+ * positive, or @a str is empty or contains a non-hexadecimal character
+ * @exception errno=ERANGE Value exceeds @a bytelen bytes
+ * @note @a cx is not modified on error.
+*/
+int multi_from_hex(const char *str, void *cx, int bytelen)
+{
+   word8 *c = (word8 *) cx;
+   size_t digits, i;
+   int nibble;
+
+   if (str == NULL || cx == NULL || bytelen <= 0) goto FAIL_INVAL;
+   if (str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) str += 2;
+   for (digits = 0; str[digits]; digits++) {
+      if (!isxdigit((unsigned char) str[digits])) goto FAIL_INVAL;
+   }
+   if (digits == 0) goto FAIL_INVAL;
+   /* skip leading zeros, then check the value fits */
+   for ( ; digits > 1 && *str == '0'; str++, digits--);
+   if (digits > (size_t) bytelen * 2) goto FAIL_RANGE;
+
+   memset(c, 0, (size_t) bytelen);
+   for (i = 0; i < digits; i++) {
+      nibble = str[digits - 1 - i];
+      if (nibble <= '9') nibble -= '0';
+      else nibble = (nibble | 0x20) - 'a' + 10;
+      c[i / 2] |= (word8) (nibble << ((i & 1) * 4));
+   }
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_RANGE: set_errno(ERANGE); return (-1);
+}  /* end multi_from_hex() */
+
+/**
+ * 256-bit addition of @a *a and @a *b. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value to add to
+ * @param b Pointer to 256-bit value to add
+ * @param c Pointer to place result of 256-bit addition
+ * @returns Resulting carry of operation.
+*/
+int u256_add(const u256 *a, const u256 *b, u256 *c)
+{
+#ifdef HAS_64BIT
+   return u256_add_x64(a, b, c);
+
+#else
+   return u256_add_x86(a, b, c);
+
+#endif
+}  /* end u256_add() */
+
+/**
+ * 256-bit bitwise AND of @a *a and @a *b. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value
+ * @param b Pointer to 256-bit value
+ * @param c Pointer to place result of bitwise operation
+*/
+void u256_and(const u256 *a, const u256 *b, u256 *c)
+{
+   int i;
+
+   for (i = 0; i < 8; i++) c->w[i] = a->w[i] & b->w[i];
+}  /* end u256_and() */
+
+/**
+ * 256-bit unsigned compare @a *a to @a *b.
+ * @param a Pointer to 256-bit value to compare to
+ * @param b Pointer to 256-bit value to compare
+ * @retval -1 if @a *a < @a *b
+ * @retval 1 if @a *a > @a *b
+ * @retval 0 if @a *a == @a *b.
+*/
+int u256_cmp(const u256 *a, const u256 *b)
+{
+   int i;
+
+#ifdef HAS_64BIT
+   for (i = 3; i >= 0; i--) {
+      if (a->q[i] != b->q[i]) return (a->q[i] < b->q[i]) ? -1 : 1;
+   }
+
+#else
+   for (i = 7; i >= 0; i--) {
+      if (a->w[i] != b->w[i]) return (a->w[i] < b->w[i]) ? -1 : 1;
+   }
+
+#endif
+
+   return 0;
+}  /* end u256_cmp() */
+
+/**
+ * 256-bit division of @a *a by @a *b. The quotient is placed in @a *q
+ * and the remainder in @a *r, either of which may be NULL.
+ * @param a Pointer to 256-bit dividend
+ * @param b Pointer to 256-bit divisor
+ * @param q Pointer to place 256-bit quotient, or NULL
+ * @param r Pointer to place 256-bit remainder, or NULL
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL Divisor @a *b is zero
+*/
+int u256_divmod(const u256 *a, const u256 *b, u256 *q, u256 *r)
+{
+#ifdef HAS_64BIT
+   return u256_divmod_x64(a, b, q, r);
+
+#else
+   return u256_divmod_x86(a, b, q, r);
+
+#endif
+}  /* end u256_divmod() */
+
+/**
+ * 256-bit division of @a *a by a 64-bit @a *d. The quotient is placed
+ * in @a *q and the 64-bit remainder in @a *r, either of which may be
+ * NULL.
+ * @param a Pointer to 256-bit dividend
+ * @param d Pointer to 64-bit divisor
+ * @param q Pointer to place 256-bit quotient, or NULL
+ * @param r Pointer to place 64-bit remainder, or NULL
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL Divisor @a *d is zero
+*/
+int u256_divmod64(const u256 *a, const void *d, u256 *q, void *r)
+{
+#ifdef HAS_64BIT
+   return u256_divmod64_x64(a, d, q, r);
+
+#else
+   return u256_divmod64_x86(a, d, q, r);
+
+#endif
+}  /* end u256_divmod64() */
+
+/**
+ * Check if 256-bit @a *a is zero.
+ * @param a Pointer to 256-bit value to check
+ * @returns 1 if @a *a is zero, else 0.
+*/
+int u256_iszero(const u256 *a)
+{
+#ifdef HAS_64BIT
+   return (a->q[0] | a->q[1] | a->q[2] | a->q[3]) == 0;
+
+#else
+   return (a->w[0] | a->w[1] | a->w[2] | a->w[3] |
+      a->w[4] | a->w[5] | a->w[6] | a->w[7]) == 0;
+
+#endif
+}  /* end u256_iszero() */
+
+/**
+ * Exponentiate @a *a to the power @a *e, modulo the (odd) modulus of
+ * Montgomery context @a *ctx. Values are in normal (not Montgomery)
+ * form. The exponent is processed in 4-bit windows, requiring (at most)
+ * 256 Montgomery squarings and 64 Montgomery products.
+ * @param ctx Pointer to Montgomery context, from u256_mont_init()
+ * @param a Pointer to 256-bit base, of any value
+ * @param e Pointer to 256-bit exponent
+ * @param c Pointer to place `a^e mod n`
+*/
+void u256_mont_exp(const U256MONT *ctx, const u256 *a, const u256 *e,
+   u256 *c)
+{
+   u256 table[16], t;
+   int i, nib;
+
+   /* powers of a, 0..15, in Montgomery form */
+   table[0] = ctx->one;
+   u256_mont_to(ctx, a, &table[1]);
+   for (i = 2; i < 16; i++) mont_mul(ctx, &table[i - 1], &table[1], &table[i]);
+   /* skip leading zero windows */
+   for (i = 63; i > 0 && ((e->b[i >> 1] >> ((i & 1) << 2)) & 15) == 0; i--);
+   t = table[(e->b[i >> 1] >> ((i & 1) << 2)) & 15];
+   for (i--; i >= 0; i--) {
+      mont_sqr(ctx, &t, &t);
+      mont_sqr(ctx, &t, &t);
+      mont_sqr(ctx, &t, &t);
+      mont_sqr(ctx, &t, &t);
+      nib = (e->b[i >> 1] >> ((i & 1) << 2)) & 15;
+      if (nib) mont_mul(ctx, &t, &table[nib], &t);
+   }
+   u256_mont_from(ctx, &t, c);
+}  /* end u256_mont_exp() */
+
+/**
+ * Convert @a *a from Montgomery form, modulo the modulus of Montgomery
+ * context @a *ctx. Result is placed in @a *c, as `a / R mod n`.
+ * @param ctx Pointer to Montgomery context, from u256_mont_init()
+ * @param a Pointer to 256-bit value in Montgomery form
+ * @param c Pointer to place 256-bit value in normal form
+*/
+void u256_mont_from(const U256MONT *ctx, const u256 *a, u256 *c)
+{
+   mlimb t[(2 * U256_MLIMBS) + 1];
+
+   memcpy(t, U256_LIMBS(a), sizeof(u256));
+   memset(&t[U256_MLIMBS], 0, U256_MLIMBS * sizeof(mlimb));
+   mont_redc(ctx, t, c);
+}  /* end u256_mont_from() */
+
+/**
+ * Initialize a Montgomery context @a *ctx for the (odd) 256-bit
+ * modulus @a *n. Precomputes `n' = -n^-1 mod R`, `R mod n` and
+ * `R^2 mod n`, where `R = 2^256`, such that modular multiplication
+ * by u256_mont_mul() requires no division.
+ * @param ctx Pointer to Montgomery context to initialize
+ * @param n Pointer to 256-bit modulus; must be odd
+ * @returns 0 on success, or (-1) on error. Check errno for details.
+ * @exception errno=EINVAL A parameter is NULL or @a *n is even
+*/
+int u256_mont_init(U256MONT *ctx, const u256 *n)
+{
+   u256 x, t, two;
+   int i;
+
+   if (ctx == NULL || n == NULL) goto FAIL_INVAL;
+   if ((n->b[0] & 1) == 0) goto FAIL_INVAL;
+
+   ctx->n = *n;
+   /* n^-1 mod R by Newton's method, doubling correct bits each step;
+    * x = n is correct to 3 bits, so 7 steps exceed 256 bits */
+   memset(&two, 0, sizeof(two));
+   two.b[0] = 2;
+   x = *n;
+   for (i = 0; i < 7; i++) {
+      u256_mul(n, &x, &t, NULL);
+      u256_sub(&two, &t, &t);
+      u256_mul(&x, &t, &x, NULL);
+   }
+   memset(&t, 0, sizeof(t));
+   u256_sub(&t, &x, &ctx->ninv);
+   /* R mod n = (R - n) mod n */
+   u256_sub(&t, n, &t);
+   u256_divmod(&t, n, NULL, &ctx->one);
+   /* R^2 mod n, by 256 modular doublings of R mod n */
+   x = ctx->one;
+   for (i = 0; i < 256; i++) {
+      if (u256_add(&x, &x, &x) || u256_cmp(&x, n) >= 0) {
+         u256_sub(&x, n, &x);
+      }
+   }
+   ctx->r2 = x;
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end u256_mont_init() */
+
+/**
+ * Montgomery multiplication of @a *a and @a *b, modulo the modulus of
+ * Montgomery context @a *ctx. Operands and result are in Montgomery
+ * form, as from u256_mont_to(), and result is placed in @a *c, as
+ * `a * b / R mod n`. Operands must be less than the modulus.
+ * @param ctx Pointer to Montgomery context, from u256_mont_init()
+ * @param a Pointer to 256-bit value to multiply
+ * @param b Pointer to 256-bit value to multiply by
+ * @param c Pointer to place 256-bit product, which may overlap
+ * @a a or @a b
+*/
+void u256_mont_mul(const U256MONT *ctx, const u256 *a, const u256 *b,
+   u256 *c)
+{
+   mont_mul(ctx, a, b, c);
+}  /* end u256_mont_mul() */
+
+/**
+ * Montgomery squaring of @a *a, modulo the modulus of Montgomery
+ * context @a *ctx. Equivalent to u256_mont_mul() of @a *a by itself,
+ * but faster, computing cross products once.
+ * @param ctx Pointer to Montgomery context, from u256_mont_init()
+ * @param a Pointer to 256-bit value to square, less than the modulus
+ * @param c Pointer to place 256-bit square, which may overlap @a a
+*/
+void u256_mont_sqr(const U256MONT *ctx, const u256 *a, u256 *c)
+{
+   mont_sqr(ctx, a, c);
+}  /* end u256_mont_sqr() */
+
+/**
+ * Convert @a *a to Montgomery form, modulo the modulus of Montgomery
+ * context @a *ctx. Result is placed in @a *c, as `a * R mod n`.
+ * @param ctx Pointer to Montgomery context, from u256_mont_init()
+ * @param a Pointer to 256-bit value to convert, of any value
+ * @param c Pointer to place 256-bit value in Montgomery form
+*/
+void u256_mont_to(const U256MONT *ctx, const u256 *a, u256 *c)
+{
+   mont_mul(ctx, a, &ctx->r2, c);
+}  /* end u256_mont_to() */
+
+/**
+ * 256-bit multiplication of @a *a and @a *b. The low 256 bits of the
+ * (512-bit) product are placed in @a *lo, and the high 256 bits are
+ * placed in @a *hi, if not NULL.
+ * @param a Pointer to 256-bit value to multiply
+ * @param b Pointer to 256-bit value to multiply by
+ * @param lo Pointer to place low 256 bits of product
+ * @param hi Pointer to place high 256 bits of product, or NULL
+ * @returns 1 if product exceeds 256 bits (overflow), else 0.
+*/
+int u256_mul(const u256 *a, const u256 *b, u256 *lo, u256 *hi)
+{
+   return Ku256_mul(a, b, lo, hi);
+}  /* end u256_mul() */
+
+/**
+ * 256-bit bitwise NOT of @a *a. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value
+ * @param c Pointer to place result of bitwise operation
+*/
+void u256_not(const u256 *a, u256 *c)
+{
+   int i;
+
+   for (i = 0; i < 8; i++) c->w[i] = ~a->w[i];
+}  /* end u256_not() */
+
+/**
+ * 256-bit bitwise OR of @a *a and @a *b. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value
+ * @param b Pointer to 256-bit value
+ * @param c Pointer to place result of bitwise operation
+*/
+void u256_or(const u256 *a, const u256 *b, u256 *c)
+{
+   int i;
+
+   for (i = 0; i < 8; i++) c->w[i] = a->w[i] | b->w[i];
+}  /* end u256_or() */
+
+/**
+ * 256-bit shift @a *a left by @a n bits. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value to shift
+ * @param n Number of bits to shift; 256 or more results in zero
+ * @param c Pointer to place result of shift
+*/
+void u256_shl(const u256 *a, int n, u256 *c)
+{
+   u256 t;
+   int i, limbs, bits;
+
+   if (n <= 0) n = 0;
+   if (n > 256) n = 256;
+   limbs = n >> 5;
+   bits = n & 31;
+   for (i = 7; i >= 0; i--) {
+      t.w[i] = (i - limbs >= 0) ? a->w[i - limbs] << bits : 0;
+      if (bits && i - limbs - 1 >= 0) {
+         t.w[i] |= a->w[i - limbs - 1] >> (32 - bits);
+      }
+   }
+   *c = t;
+}  /* end u256_shl() */
+
+/**
+ * 256-bit shift @a *a right by @a n bits. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value to shift
+ * @param n Number of bits to shift; 256 or more results in zero
+ * @param c Pointer to place result of shift
+*/
+void u256_shr(const u256 *a, int n, u256 *c)
+{
+   u256 t;
+   int i, limbs, bits;
+
+   if (n <= 0) n = 0;
+   if (n > 256) n = 256;
+   limbs = n >> 5;
+   bits = n & 31;
+   for (i = 0; i < 8; i++) {
+      t.w[i] = (i + limbs < 8) ? a->w[i + limbs] >> bits : 0;
+      if (bits && i + limbs + 1 < 8) {
+         t.w[i] |= a->w[i + limbs + 1] << (32 - bits);
+      }
+   }
+   *c = t;
+}  /* end u256_shr() */
+
+/**
+ * 256-bit subtraction of @a *b from @a *a. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value to subtract from
+ * @param b Pointer to 256-bit value to subtract
+ * @param c Pointer to place result of 256-bit subtraction
+ * @returns Resulting carry (borrow) of operation.
+*/
+int u256_sub(const u256 *a, const u256 *b, u256 *c)
+{
+#ifdef HAS_64BIT
+   return u256_sub_x64(a, b, c);
+
+#else
+   return u256_sub_x86(a, b, c);
+
+#endif
+}  /* end u256_sub() */
+
+/**
+ * 256-bit bitwise XOR of @a *a and @a *b. Result is placed in @a *c.
+ * @param a Pointer to 256-bit value
+ * @param b Pointer to 256-bit value
+ * @param c Pointer to place result of bitwise operation
+*/
+void u256_xor(const u256 *a, const u256 *b, u256 *c)
+{
+   int i;
+
+   for (i = 0; i < 8; i++) c->w[i] = a->w[i] ^ b->w[i];
+}  /* end u256_xor() */
 
 /* end include guard */
 #endif
@@ -1,6 +1,12 @@
 /**
  * @file extmath.h
  * @brief Extended math support.
+ * @details Provides extended math support, incl. 64-bit math for x86.
+ * <br />Define `EXTC_INLINE` (before inclusion, or with `-DEXTC_INLINE`)
+ * for header-only (static inline) definitions of iszero(), add64(),
+ * sub64(), negate64(), cmp64(), cmp256() and shiftr64(), where 64-bit
+ * words are available. Library symbols remain, for code built without
+ * `EXTC_INLINE`.
  * @copyright Adequate Systems LLC, 2018-2022. All Rights Reserved.
  * <br />For license information, please refer to ../LICENSE.md
 */
@@ -10,7 +16,104 @@
 #define EXTENDED_MATH_H
 
 
+#include "extint.h"
 #include <math.h>
+#include <string.h>
+
+/* SIMD support, for inline fixed length memory comparisons */
+#if defined(__AVX2__)
+   #include <immintrin.h>
+   #define EXTMATH_INLINE_AVX2
+   #define EXTMATH_INLINE_SSE2
+
+#elif defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #include <emmintrin.h>
+   #define EXTMATH_INLINE_SSE2
+
+#endif
+
+/* header-only (static inline) forms of 64-bit math, see EXTC_INLINE */
+#if defined(EXTC_INLINE) && defined(HAS_64BIT)
+   #define EXTMATH_INLINE
+
+#endif
+
+/**
+ * CPU feature; 64-bit words (::HAS_64BIT) and `_x64` kernels.
+*/
+#define CPU_FEATURE_X64       0x01
+
+/**
+ * CPU feature; SSE2 instructions.
+*/
+#define CPU_FEATURE_SSE2      0x02
+
+/**
+ * CPU feature; AVX2 instructions, and OS support of AVX state.
+*/
+#define CPU_FEATURE_AVX2      0x04
+
+/**
+ * CPU feature; BMI2 instructions (MULX).
+*/
+#define CPU_FEATURE_BMI2      0x08
+
+/**
+ * CPU feature; ADX instructions (ADCX/ADOX).
+*/
+#define CPU_FEATURE_ADX       0x10
+
+/**
+ * CPU feature; SSSE3 instructions (PSHUFB).
+*/
+#define CPU_FEATURE_SSSE3     0x20
+
+/**
+ * All CPU features. Used to select the best kernels of dispatched
+ * functions with extmath_dispatch().
+*/
+#define CPU_FEATURE_ALL       0x7fff
+
+/**
+ * @private
+ * Internal marker of completed CPU feature detection.
+*/
+#define CPU_FEATURE_DETECTED  0x8000
+
+/**
+ * @struct u256 256-bit unsigned integer type.
+ * Stored as little-endian limbs, compatible with 32-byte values
+ * of cmp256() and multi_add(), etc. Limbs are accessible as bytes,
+ * 32-bit words, or (where available) 64-bit words.
+ * @property u256::b Bytes of value, least significant first
+ * @property u256::w 32-bit words of value, least significant first
+ * @property u256::q 64-bit words of value, least significant first
+*/
+typedef union u256 {
+   word8 b[32];
+   word32 w[8];
+#ifdef HAS_64BIT
+   word64 q[4];
+#endif
+} u256;
+
+/**
+ * @struct U256MONT Montgomery context for an odd 256-bit modulus.
+ * Holds values precomputed by u256_mont_init(), such that modular
+ * multiplication (in Montgomery form) requires no division. Here,
+ * `R = 2^256` and `n` is the modulus.
+ * @property U256MONT::n Modulus, n
+ * @property U256MONT::ninv Negative modular inverse, `-n^-1 mod R`
+ * @property U256MONT::one One in Montgomery form, `R mod n`
+ * @property U256MONT::r2 Conversion factor, `R^2 mod n`
+*/
+typedef struct u256_mont {
+   u256 n;
+   u256 ninv;
+   u256 one;
+   u256 r2;
+} U256MONT;
 
 /* C/C++ compatible function prototypes */
 #ifdef __cplusplus
@@ -27,6 +130,14 @@ extern "C" {
    int cmp256_x64(const void *ax, const void *bx);
    void shiftr64_x64(void *ax);
    int mult64_x64(const void *ax, const void *bx, void *cx);
+   int mult64_full_x64(const void *ax, const void *bx, void *lo, void *hi);
+   int multi_add_x64(const void *ax, const void *bx, void *cx, int bytelen);
+   int multi_sub_x64(const void *ax, const void *bx, void *cx, int bytelen);
+   int u256_add_x64(const u256 *a, const u256 *b, u256 *c);
+   int u256_divmod_x64(const u256 *a, const u256 *b, u256 *q, u256 *r);
+   int u256_divmod64_x64(const u256 *a, const void *d, u256 *q, void *r);
+   int u256_mul_x64(const u256 *a, const u256 *b, u256 *lo, u256 *hi);
+   int u256_sub_x64(const u256 *a, const u256 *b, u256 *c);
 
 /* end x64 guard */
 #endif
@@ -39,21 +150,320 @@ int cmp64_x86(const void *ax, const void *bx);
 int cmp256_x86(const void *ax, const void *bx);
 void shiftr64_x86(void *ax);
 int mult64_x86(const void *ax, const void *bx, void *cx);
+int mult64_full_x86(const void *ax, const void *bx, void *lo, void *hi);
+int multi_add_x86(const void *ax, const void *bx, void *cx, int bytelen);
+int multi_sub_x86(const void *ax, const void *bx, void *cx, int bytelen);
+int u256_add_x86(const u256 *a, const u256 *b, u256 *c);
+int u256_divmod_x86(const u256 *a, const u256 *b, u256 *q, u256 *r);
+int u256_divmod64_x86(const u256 *a, const void *d, u256 *q, void *r);
+int u256_mul_x86(const u256 *a, const u256 *b, u256 *lo, u256 *hi);
+int u256_sub_x86(const u256 *a, const u256 *b, u256 *c);
 
-int iszero(const void *buff, int len);
-int add64(const void *ax, const void *bx, void *cx);
-int sub64(const void *ax, const void *bx, void *cx);
-void negate64(void *ax);
-int cmp64(const void *ax, const void *bx);
-int cmp256(const void *ax, const void *bx);
-void shiftr64(void *ax);
+unsigned cpu_features(void);
+unsigned extmath_dispatch(unsigned features);
+unsigned extmath_features(void);
+
+/* library (out-of-line) forms, unless defined inline */
+#ifndef EXTMATH_INLINE
+   int iszero(const void *buff, int len);
+   int add64(const void *ax, const void *bx, void *cx);
+   int sub64(const void *ax, const void *bx, void *cx);
+   void negate64(void *ax);
+   int cmp64(const void *ax, const void *bx);
+   int cmp256(const void *ax, const void *bx);
+   void shiftr64(void *ax);
+
+#endif
+
+size_t cmp256_batch(const void *values, size_t n, const void *target,
+   void *out_mask);
 int mult64(const void *ax, const void *bx, void *cx);
+int mult64_full(const void *ax, const void *bx, void *lo, void *hi);
 int multi_add(const void *ax, const void *bx, void *cx, int bytelen);
+int multi_clz(const void *ax, int bytelen);
+int multi_ctz(const void *ax, int bytelen);
+int multi_from_dec(const char *str, void *cx, int bytelen);
+int multi_from_hex(const char *str, void *cx, int bytelen);
+int multi_mul(const void *ax, int alen, const void *bx, int blen,
+   void *cx);
+int multi_popcount(const void *ax, int bytelen);
+void multi_shl(const void *ax, int n, void *cx, int bytelen);
+void multi_shr(const void *ax, int n, void *cx, int bytelen);
+int multi_sqr(const void *ax, int alen, void *cx);
 int multi_sub(const void *ax, const void *bx, void *cx, int bytelen);
+int multi_to_dec(const void *ax, int bytelen, char *str, size_t len);
+int multi_to_hex(const void *ax, int bytelen, char *str, size_t len);
+int sort256(void *values, size_t n);
+int u256_add(const u256 *a, const u256 *b, u256 *c);
+void u256_and(const u256 *a, const u256 *b, u256 *c);
+int u256_cmp(const u256 *a, const u256 *b);
+int u256_divmod(const u256 *a, const u256 *b, u256 *q, u256 *r);
+int u256_divmod64(const u256 *a, const void *d, u256 *q, void *r);
+int u256_iszero(const u256 *a);
+void u256_mont_exp(const U256MONT *ctx, const u256 *a, const u256 *e,
+   u256 *c);
+void u256_mont_from(const U256MONT *ctx, const u256 *a, u256 *c);
+int u256_mont_init(U256MONT *ctx, const u256 *n);
+void u256_mont_mul(const U256MONT *ctx, const u256 *a, const u256 *b,
+   u256 *c);
+void u256_mont_sqr(const U256MONT *ctx, const u256 *a, u256 *c);
+void u256_mont_to(const U256MONT *ctx, const u256 *a, u256 *c);
+int u256_mul(const u256 *a, const u256 *b, u256 *lo, u256 *hi);
+void u256_not(const u256 *a, u256 *c);
+void u256_or(const u256 *a, const u256 *b, u256 *c);
+void u256_shl(const u256 *a, int n, u256 *c);
+void u256_shr(const u256 *a, int n, u256 *c);
+int u256_sub(const u256 *a, const u256 *b, u256 *c);
+void u256_xor(const u256 *a, const u256 *b, u256 *c);
 
 #ifdef __cplusplus
 }  /* end extern "C" */
 #endif
 
+/**
+ * Check if 16 bytes of @a ax and @a bx are equal. Inline equivalent
+ * of `memcmp(ax, bx, 16) == 0`, for fixed length key comparisons.
+ * @param ax Pointer to 16 bytes to compare
+ * @param bx Pointer to 16 bytes to compare
+ * @returns 1 if the bytes are equal, else 0.
+*/
+static inline int memeq16(const void *ax, const void *bx)
+{
+#ifdef EXTMATH_INLINE_SSE2
+   __m128i a = _mm_loadu_si128((const __m128i *) ax);
+   __m128i b = _mm_loadu_si128((const __m128i *) bx);
+
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xffff;
+
+#else
+   return memcmp(ax, bx, 16) == 0;
+
+#endif
+}
+
+/**
+ * Check if 32 bytes of @a ax and @a bx are equal. Inline equivalent
+ * of `memcmp(ax, bx, 32) == 0`, for fixed length key comparisons.
+ * @param ax Pointer to 32 bytes to compare
+ * @param bx Pointer to 32 bytes to compare
+ * @returns 1 if the bytes are equal, else 0.
+*/
+static inline int memeq32(const void *ax, const void *bx)
+{
+#if defined(EXTMATH_INLINE_AVX2)
+   __m256i a = _mm256_loadu_si256((const __m256i *) ax);
+   __m256i b = _mm256_loadu_si256((const __m256i *) bx);
+
+   return _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) == -1;
+
+#elif defined(EXTMATH_INLINE_SSE2)
+   const __m128i *a = (const __m128i *) ax;
+   const __m128i *b = (const __m128i *) bx;
+
+   return _mm_movemask_epi8(_mm_and_si128(
+      _mm_cmpeq_epi8(_mm_loadu_si128(a), _mm_loadu_si128(b)),
+      _mm_cmpeq_epi8(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1))))
+         == 0xffff;
+
+#else
+   return memcmp(ax, bx, 32) == 0;
+
+#endif
+}
+
+/**
+ * Check if 64 bytes of @a ax and @a bx are equal. Inline equivalent
+ * of `memcmp(ax, bx, 64) == 0`, for fixed length key comparisons.
+ * @param ax Pointer to 64 bytes to compare
+ * @param bx Pointer to 64 bytes to compare
+ * @returns 1 if the bytes are equal, else 0.
+*/
+static inline int memeq64(const void *ax, const void *bx)
+{
+#if defined(EXTMATH_INLINE_AVX2)
+   const __m256i *a = (const __m256i *) ax;
+   const __m256i *b = (const __m256i *) bx;
+   __m256i x;
+
+   x = _mm256_or_si256(
+      _mm256_xor_si256(_mm256_loadu_si256(a), _mm256_loadu_si256(b)),
+      _mm256_xor_si256(_mm256_loadu_si256(a + 1), _mm256_loadu_si256(b + 1)));
+   return _mm256_testz_si256(x, x);
+
+#elif defined(EXTMATH_INLINE_SSE2)
+   const __m128i *a = (const __m128i *) ax;
+   const __m128i *b = (const __m128i *) bx;
+   __m128i x;
+
+   x = _mm_or_si128(
+      _mm_or_si128(
+         _mm_xor_si128(_mm_loadu_si128(a), _mm_loadu_si128(b)),
+         _mm_xor_si128(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1))),
+      _mm_or_si128(
+         _mm_xor_si128(_mm_loadu_si128(a + 2), _mm_loadu_si128(b + 2)),
+         _mm_xor_si128(_mm_loadu_si128(a + 3), _mm_loadu_si128(b + 3))));
+   return _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128()))
+      == 0xffff;
+
+#else
+   return memcmp(ax, bx, 64) == 0;
+
+#endif
+}
+
+/* header-only (static inline) mode guard */
+#ifdef EXTMATH_INLINE
+
+   /**
+    * Check if `buff[len]` contains all zeros. Inline (`EXTC_INLINE`)
+    * form of the library iszero(), with SSE2 where available.
+    * @param buff Pointer to buffer to check contains zeros
+    * @param len The length of buffer, in bytes, to check
+    * @returns 1 if `buff[len]` is all zeros, else 0.
+   */
+   static inline int iszero(const void *buff, int len)
+   {
+      const word8 *bp = (const word8 *) buff;
+      word64 q;
+   #ifdef EXTMATH_INLINE_SSE2
+      const __m128i *vp;
+      __m128i x;
+
+      /* accumulate 64 bytes per test, for an early exit */
+      for ( ; len >= 64; bp += 64, len -= 64) {
+         vp = (const __m128i *) bp;
+         x = _mm_or_si128(
+            _mm_or_si128(_mm_loadu_si128(vp), _mm_loadu_si128(vp + 1)),
+            _mm_or_si128(_mm_loadu_si128(vp + 2), _mm_loadu_si128(vp + 3)));
+         if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128()))
+            != 0xffff) return 0;
+      }
+      for ( ; len >= 16; bp += 16, len -= 16) {
+         x = _mm_loadu_si128((const __m128i *) bp);
+         if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128()))
+            != 0xffff) return 0;
+      }
+   #endif
+
+      for ( ; len >= 8; bp += 8, len -= 8) {
+         memcpy(&q, bp, 8);
+         if (q) return 0;
+      }
+      for ( ; len > 0; bp++, len--) if (*bp) return 0;
+      return 1;
+   }
+
+   /**
+    * 64-bit addition of @a *ax and @a *bx. Result is placed in @a *cx.
+    * Inline (`EXTC_INLINE`) form of the library add64().
+    * @param ax Pointer to 64-bit value to add to
+    * @param bx Pointer to 64-bit value to add
+    * @param cx Pointer to place result of 64-bit addition
+    * @returns Resulting carry of operation.
+   */
+   static inline int add64(const void *ax, const void *bx, void *cx)
+   {
+      word64 a, b, c;
+
+      memcpy(&a, ax, 8);
+      memcpy(&b, bx, 8);
+      c = a + b;
+      memcpy(cx, &c, 8);
+      return (c < a);
+   }
+
+   /**
+    * 64-bit subtraction of @a *bx from @a *ax. Result is placed in
+    * @a *cx. Inline (`EXTC_INLINE`) form of the library sub64().
+    * @param ax Pointer to 64-bit value to subtract from
+    * @param bx Pointer to 64-bit value to subtract
+    * @param cx Pointer to place result of 64-bit subtraction
+    * @returns Resulting carry of operation.
+   */
+   static inline int sub64(const void *ax, const void *bx, void *cx)
+   {
+      word64 a, b, c;
+
+      memcpy(&a, ax, 8);
+      memcpy(&b, bx, 8);
+      c = a - b;
+      memcpy(cx, &c, 8);
+      return (c > a);
+   }
+
+   /**
+    * Swap sign on 64-bit @a *ax. Equivalent to @a *ax multiplied by
+    * (-1). Inline (`EXTC_INLINE`) form of the library negate64().
+    * @param ax Pointer to 64-bit value to "negate"
+   */
+   static inline void negate64(void *ax)
+   {
+      word64 a;
+
+      memcpy(&a, ax, 8);
+      a = ~a + 1;
+      memcpy(ax, &a, 8);
+   }
+
+   /**
+    * 64-bit unsigned compare @a *ax to @a *bx.
+    * Inline (`EXTC_INLINE`) form of the library cmp64().
+    * @param ax Pointer to 64-bit value to compare to
+    * @param bx Pointer to 64-bit value to compare
+    * @retval -1 if @a *ax < @a *bx
+    * @retval 1 if @a *ax > @a *bx
+    * @retval 0 if @a *ax == @a *bx.
+   */
+   static inline int cmp64(const void *ax, const void *bx)
+   {
+      word64 a, b;
+
+      memcpy(&a, ax, 8);
+      memcpy(&b, bx, 8);
+      return (a > b) - (a < b);
+   }
+
+   /**
+    * 256-bit unsigned compare @a *ax to @a *bx.
+    * Inline (`EXTC_INLINE`) form of the library cmp256().
+    * @param ax Pointer to 256-bit value to compare to
+    * @param bx Pointer to 256-bit value to compare
+    * @retval -1 if @a *ax < @a *bx
+    * @retval 1 if @a *ax > @a *bx
+    * @retval 0 if @a *ax == @a *bx.
+   */
+   static inline int cmp256(const void *ax, const void *bx)
+   {
+      const word8 *ap = (const word8 *) ax;
+      const word8 *bp = (const word8 *) bx;
+      word64 a, b;
+      int i;
+
+      for (i = 24; i >= 0; i -= 8) {
+         memcpy(&a, ap + i, 8);
+         memcpy(&b, bp + i, 8);
+         if (a != b) return (a < b) ? -1 : 1;
+      }
+
+      return 0;
+   }
+
+   /**
+    * 64-bit shift @a *ax one to the right.
+    * Inline (`EXTC_INLINE`) form of the library shiftr64().
+    * @param ax Pointer to 64-bit value to shift
+   */
+   static inline void shiftr64(void *ax)
+   {
+      word64 a;
+
+      memcpy(&a, ax, 8);
+      a >>= 1;
+      memcpy(ax, &a, 8);
+   }
+
+/* end header-only (static inline) mode guard */
+#endif
+
 /* end include guard */
 #endif
@@ -0,0 +1,568 @@
+/**
+ * @private
+ * @headerfile extqueue.h <extqueue.h>
+ * @copyright Adequate Systems LLC, 2022. All Rights Reserved.
+ * <br />For license information, please refer to ../LICENSE.md
+*/
+
+/* include guard */
+#ifndef EXTENDED_QUEUE_C
+#define EXTENDED_QUEUE_C
+
+
+#include "extqueue.h"
+
+/* internal support */
+#include "exterrno.h"
+#include "exttime.h"
+
+/* external support */
+#include <stddef.h>  /* for ptrdiff_t */
+#include <string.h>
+
+/* Link a SLNODE to the head of a MPSCQ. Wait-free. */
+static void mpscq_link(SLNODE *nodep, MPSCQ *qp)
+{
+   SLNODE *prevp;
+
+   nodep->next = NULL;
+   /* swing head to node, then link previous head to node -- the queue
+    * is momentarily "broken" between these steps, see mpscq_pop() */
+   prevp = atomic_xchg_ptr(&qp->head, nodep);
+   atomic_store_ptr(&prevp->next, nodep);
+}  /* end mpscq_link() */
+
+/**
+ * Destroy a MPSCQ. Any nodes remaining in the queue are NOT destroyed.
+ * @param qp Pointer to queue to destroy
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL The supplied pointer is NULL
+*/
+int mpscq_destroy(MPSCQ *qp)
+{
+   if (qp == NULL) goto FAIL_INVAL;
+
+   if (condition_destroy(&qp->cond) != 0) return (-1);
+   if (mutex_destroy(&qp->lock) != 0) return (-1);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end mpscq_destroy() */
+
+/**
+ * Initialize a MPSCQ. To prevent a resource leak, use mpscq_destroy()
+ * before discarding an initialized queue.
+ * @param qp Pointer to queue to initialize
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL The supplied pointer is NULL
+*/
+int mpscq_init(MPSCQ *qp)
+{
+   if (qp == NULL) goto FAIL_INVAL;
+
+   /* queue begins (and ends) with the stub node */
+   qp->stub.next = NULL;
+   qp->stub.data = NULL;
+   qp->head = qp->tail = &qp->stub;
+   qp->waiting = 0;
+   if (mutex_init(&qp->lock) != 0) return (-1);
+   if (condition_init(&qp->cond) != 0) {
+      mutex_destroy(&qp->lock);
+      return (-1);
+   }
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end mpscq_init() */
+
+/**
+ * Check if a MPSCQ is empty. A queue with a push in progress is NOT
+ * considered empty. Consumer operation.
+ * @param qp Pointer to queue to check
+ * @returns 1 if queue is empty, else 0.
+*/
+int mpscq_isempty(MPSCQ *qp)
+{
+   return (qp->tail == &qp->stub && atomic_load_ptr(&qp->head) == &qp->stub);
+}  /* end mpscq_isempty() */
+
+/**
+ * Pop a SLNODE from a MPSCQ, without blocking. Consumer operation.
+ * @param qp Pointer to queue to pop node from
+ * @returns Pointer to a SLNODE on success, or NULL on error.
+ * Check errno for details.
+ * @exception errno=ENOLINK The queue has no (fully) linked nodes
+ * @exception errno=EINVAL The supplied pointer is NULL
+ * @note A NULL return with a non-empty queue (see mpscq_isempty())
+ * indicates a producer is mid-push, and a node will be available soon.
+*/
+SLNODE *mpscq_pop(MPSCQ *qp)
+{
+   SLNODE *tailp, *nextp;
+
+   /* error checks */
+   if (qp == NULL) {
+      set_errno(EINVAL);
+      return NULL;
+   }
+
+   tailp = qp->tail;
+   nextp = atomic_load_ptr(&tailp->next);
+   /* skip over the stub node */
+   if (tailp == &qp->stub) {
+      if (nextp == NULL) goto FAIL_NOLINK;
+      qp->tail = tailp = nextp;
+      nextp = atomic_load_ptr(&nextp->next);
+   }
+   /* a linked successor means the tail node is free to go */
+   if (nextp == NULL) {
+      /* check for a push in progress, else push stub behind tail */
+      if (tailp != atomic_load_ptr(&qp->head)) goto FAIL_NOLINK;
+      mpscq_link(&qp->stub, qp);
+      nextp = atomic_load_ptr(&tailp->next);
+      if (nextp == NULL) goto FAIL_NOLINK;
+   }
+   /* advance tail -- remove old linkage */
+   qp->tail = nextp;
+   tailp->next = NULL;
+
+   return tailp;
+
+/* error handling */
+FAIL_NOLINK: set_errno(ENOLINK); return NULL;
+}  /* end mpscq_pop() */
+
+/**
+ * Push a SLNODE into a MPSCQ. Wait-free, unless the consumer is
+ * waiting on an empty queue, in which case the consumer is signalled.
+ * @param nodep Pointer to node to push
+ * @param qp Pointer to queue to push node to
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL One of the supplied pointers is NULL
+*/
+int mpscq_push(SLNODE *nodep, MPSCQ *qp)
+{
+   /* error checks */
+   if (nodep == NULL || qp == NULL) {
+      set_errno(EINVAL);
+      return (-1);
+   }
+
+   mpscq_link(nodep, qp);
+   /* pairs with the fence in mpscq_*wait() -- either the consumer sees
+    * this push, or this push sees the waiting consumer */
+   atomic_fence();
+   if (atomic_load32(&qp->waiting)) {
+      mutex_lock(&qp->lock);
+      condition_signal(&qp->cond);
+      mutex_unlock(&qp->lock);
+   }
+
+   return 0;
+}  /* end mpscq_push() */
+
+/**
+ * Pop a SLNODE from a MPSCQ, blocking for at most @a ms milliseconds
+ * while the queue is empty. Consumer operation.
+ * @param qp Pointer to queue to pop node from
+ * @param ms Milliseconds to wait on an empty queue
+ * @returns Pointer to a SLNODE on success, or NULL on error.
+ * Check errno for details.
+ * @exception errno=CONDITION_TIMEOUT The wait timed out
+ * @exception errno=EINVAL The supplied pointer is NULL
+*/
+SLNODE *mpscq_timedwait(MPSCQ *qp, unsigned int ms)
+{
+   unsigned long long deadline, now;
+   SLNODE *nodep;
+   int ecode;
+
+   if (qp == NULL) {
+      set_errno(EINVAL);
+      return NULL;
+   }
+
+   /* absolute deadline; wakeups without a node wait only the remainder */
+   deadline = millitime() + ms;
+   while ((nodep = mpscq_pop(qp)) == NULL) {
+      /* a push in progress completes without further blocking */
+      if (!mpscq_isempty(qp)) continue;
+      ecode = 0;
+      mutex_lock(&qp->lock);
+      atomic_store32(&qp->waiting, 1);
+      atomic_fence();
+      if (mpscq_isempty(qp)) {
+         now = millitime();
+         ms = now < deadline ? (unsigned int) (deadline - now) : 0;
+         if (condition_timedwait(&qp->cond, &qp->lock, ms) != 0) {
+            ecode = errno;
+         }
+      }
+      atomic_store32(&qp->waiting, 0);
+      mutex_unlock(&qp->lock);
+      if (ecode) {
+         /* final attempt -- restore wait error on failure */
+         nodep = mpscq_pop(qp);
+         if (nodep == NULL) set_errno(ecode);
+         break;
+      }
+   }
+
+   return nodep;
+}  /* end mpscq_timedwait() */
+
+/**
+ * Pop a SLNODE from a MPSCQ, blocking while the queue is empty.
+ * Consumer operation.
+ * @param qp Pointer to queue to pop node from
+ * @returns Pointer to a SLNODE on success, or NULL on error.
+ * Check errno for details.
+ * @exception errno=EINVAL The supplied pointer is NULL
+*/
+SLNODE *mpscq_wait(MPSCQ *qp)
+{
+   SLNODE *nodep;
+
+   if (qp == NULL) {
+      set_errno(EINVAL);
+      return NULL;
+   }
+
+   while ((nodep = mpscq_pop(qp)) == NULL) {
+      /* a push in progress completes without further blocking */
+      if (!mpscq_isempty(qp)) continue;
+      mutex_lock(&qp->lock);
+      atomic_store32(&qp->waiting, 1);
+      atomic_fence();
+      if (mpscq_isempty(qp)) condition_wait(&qp->cond, &qp->lock);
+      atomic_store32(&qp->waiting, 0);
+      mutex_unlock(&qp->lock);
+   }
+
+   return nodep;
+}  /* end mpscq_wait() */
+
+/* Wake threads waiting on a RINGBUF, if any. */
+static void ringbuf_notify(RINGBUF *rbp)
+{
+   /* pairs with the fence in ringbuf_wait_*() */
+   atomic_fence();
+   if (atomic_load32(&rbp->waiting)) {
+      mutex_lock(&rbp->lock);
+      condition_broadcast(&rbp->cond);
+      mutex_unlock(&rbp->lock);
+   }
+}  /* end ringbuf_notify() */
+
+/* Get, at most, @a count elements from a RINGBUF. */
+static size_t ringbuf_get(RINGBUF *rbp, void *elems, size_t count)
+{
+   unsigned char *dst = (unsigned char *) elems;
+   unsigned char *data = (unsigned char *) rbp->data;
+   size_t pos, seq, idx, avail, first, n;
+
+   if (rbp->mode == RINGBUF_SPSC) {
+      pos = rbp->tail;
+      avail = rbp->headc - pos;
+      if (avail < count) {
+         rbp->headc = atomic_load_size(&rbp->head);
+         avail = rbp->headc - pos;
+      }
+      if (count > avail) count = avail;
+      if (count == 0) return 0;
+      /* copy in (at most) two chunks, either side of wrap around */
+      idx = pos & rbp->mask;
+      first = rbp->mask + 1 - idx;
+      if (first > count) first = count;
+      memcpy(dst, &data[idx * rbp->size], first * rbp->size);
+      memcpy(&dst[first * rbp->size], data, (count - first) * rbp->size);
+      atomic_store_size(&rbp->tail, pos + count);
+      return count;
+   }
+
+   /* RINGBUF_MPMC -- claim and release one element at a time */
+   for (n = 0; n < count; n++, dst += rbp->size) {
+      pos = atomic_load_size(&rbp->tail);
+      for ( ;; ) {
+         seq = atomic_load_size(&rbp->seq[pos & rbp->mask]);
+         if (seq == pos + 1) {
+            if (atomic_cas_size(&rbp->tail, &pos, pos + 1)) break;
+         } else if ((ptrdiff_t) (seq - (pos + 1)) < 0) return n;
+         else pos = atomic_load_size(&rbp->tail);
+      }
+      idx = pos & rbp->mask;
+      memcpy(dst, &data[idx * rbp->size], rbp->size);
+      atomic_store_size(&rbp->seq[idx], pos + rbp->mask + 1);
+   }
+
+   return n;
+}  /* end ringbuf_get() */
+
+/* Put, at most, @a count elements in a RINGBUF. */
+static size_t ringbuf_put(RINGBUF *rbp, const void *elems, size_t count)
+{
+   const unsigned char *src = (const unsigned char *) elems;
+   unsigned char *data = (unsigned char *) rbp->data;
+   size_t pos, seq, idx, avail, first, n;
+
+   if (rbp->mode == RINGBUF_SPSC) {
+      pos = rbp->head;
+      avail = rbp->mask + 1 - (pos - rbp->tailc);
+      if (avail < count) {
+         rbp->tailc = atomic_load_size(&rbp->tail);
+         avail = rbp->mask + 1 - (pos - rbp->tailc);
+      }
+      if (count > avail) count = avail;
+      if (count == 0) return 0;
+      /* copy in (at most) two chunks, either side of wrap around */
+      idx = pos & rbp->mask;
+      first = rbp->mask + 1 - idx;
+      if (first > count) first = count;
+      memcpy(&data[idx * rbp->size], src, first * rbp->size);
+      memcpy(data, &src[first * rbp->size], (count - first) * rbp->size);
+      atomic_store_size(&rbp->head, pos + count);
+      return count;
+   }
+
+   /* RINGBUF_MPMC -- claim and publish one element at a time */
+   for (n = 0; n < count; n++, src += rbp->size) {
+      pos = atomic_load_size(&rbp->head);
+      for ( ;; ) {
+         seq = atomic_load_size(&rbp->seq[pos & rbp->mask]);
+         if (seq == pos) {
+            if (atomic_cas_size(&rbp->head, &pos, pos + 1)) break;
+         } else if ((ptrdiff_t) (seq - pos) < 0) return n;
+         else pos = atomic_load_size(&rbp->head);
+      }
+      idx = pos & rbp->mask;
+      memcpy(&data[idx * rbp->size], src, rbp->size);
+      atomic_store_size(&rbp->seq[idx], pos + 1);
+   }
+
+   return n;
+}  /* end ringbuf_put() */
+
+/**
+ * Get the number of elements in a RINGBUF. The result is only
+ * approximate while other threads are operating on the ring buffer.
+ * @param rbp Pointer to ring buffer
+ * @returns Number of elements in ring buffer.
+*/
+size_t ringbuf_count(RINGBUF *rbp)
+{
+   size_t tail = atomic_load_size(&rbp->tail);
+   size_t head = atomic_load_size(&rbp->head);
+
+   /* read order ensures head >= tail */
+   return head - tail;
+}  /* end ringbuf_count() */
+
+/**
+ * Destroy a RINGBUF and free associated element memory.
+ * @param rbp Pointer to ring buffer to destroy
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL The supplied pointer is NULL
+*/
+int ringbuf_destroy(RINGBUF *rbp)
+{
+   if (rbp == NULL) goto FAIL_INVAL;
+
+   if (rbp->seq) free(rbp->seq);
+   if (rbp->data) free(rbp->data);
+   rbp->seq = NULL;
+   rbp->data = NULL;
+   if (condition_destroy(&rbp->cond) != 0) return (-1);
+   if (mutex_destroy(&rbp->lock) != 0) return (-1);
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+}  /* end ringbuf_destroy() */
+
+/**
+ * Initialize a RINGBUF of @a count, @a size byte elements. Element
+ * memory is allocated (via malloc) for @a count rounded up to the next
+ * power of two. To prevent a memory leak, use ringbuf_destroy() before
+ * discarding an initialized ring buffer.
+ * @param rbp Pointer to ring buffer to initialize
+ * @param count Minimum number of elements the ring buffer can hold
+ * @param size Size of each element, in bytes
+ * @param mode Ring buffer mode, RINGBUF_SPSC or RINGBUF_MPMC
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EINVAL A function parameter is invalid
+ * @exception errno=ENOMEM Insufficient memory for elements
+*/
+int ringbuf_init(RINGBUF *rbp, size_t count, size_t size, int mode)
+{
+   size_t capacity, idx;
+
+   /* sanity checks */
+   if (rbp == NULL || count == 0 || size == 0) goto FAIL_INVAL;
+   if (mode != RINGBUF_SPSC && mode != RINGBUF_MPMC) goto FAIL_INVAL;
+   if (count > (((size_t) -1) >> 2)) goto FAIL_INVAL;
+
+   /* round capacity up to a power of two */
+   for (capacity = 1; capacity < count; capacity <<= 1);
+   if (capacity > ((size_t) -1) / size) goto FAIL_INVAL;
+
+   memset(rbp, 0, sizeof(*rbp));
+   rbp->mask = capacity - 1;
+   rbp->size = size;
+   rbp->mode = mode;
+   rbp->data = malloc(capacity * size);
+   if (rbp->data == NULL) goto FAIL_NOMEM;
+   if (mode == RINGBUF_MPMC) {
+      rbp->seq = malloc(capacity * sizeof(size_t));
+      if (rbp->seq == NULL) goto FAIL_NOMEM;
+      for (idx = 0; idx < capacity; idx++) rbp->seq[idx] = idx;
+   }
+   if (mutex_init(&rbp->lock) != 0) goto FAIL;
+   if (condition_init(&rbp->cond) != 0) {
+      mutex_destroy(&rbp->lock);
+      goto FAIL;
+   }
+
+   return 0;
+
+/* error handling */
+FAIL_INVAL: set_errno(EINVAL); return (-1);
+FAIL_NOMEM: set_errno(ENOMEM);
+FAIL:
+   if (rbp->seq) free(rbp->seq);
+   if (rbp->data) free(rbp->data);
+   rbp->seq = NULL;
+   rbp->data = NULL;
+   return (-1);
+}  /* end ringbuf_init() */
+
+/**
+ * Pop an element from a RINGBUF, without blocking.
+ * @param rbp Pointer to ring buffer to pop element from
+ * @param elem Pointer to place popped element
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EAGAIN The ring buffer is empty
+*/
+int ringbuf_pop(RINGBUF *rbp, void *elem)
+{
+   if (ringbuf_get(rbp, elem, 1) == 0) {
+      set_errno(EAGAIN);
+      return (-1);
+   }
+   ringbuf_notify(rbp);
+
+   return 0;
+}  /* end ringbuf_pop() */
+
+/**
+ * Pop, at most, @a count elements from a RINGBUF, without blocking.
+ * In RINGBUF_SPSC mode, elements are copied in (at most) two chunks,
+ * with a single update of the dequeue position.
+ * @param rbp Pointer to ring buffer to pop elements from
+ * @param elems Pointer to place popped elements
+ * @param count Maximum number of elements to pop
+ * @returns Number of elements popped.
+*/
+size_t ringbuf_pop_n(RINGBUF *rbp, void *elems, size_t count)
+{
+   count = ringbuf_get(rbp, elems, count);
+   if (count) ringbuf_notify(rbp);
+
+   return count;
+}  /* end ringbuf_pop_n() */
+
+/**
+ * Push an element into a RINGBUF, without blocking.
+ * @param rbp Pointer to ring buffer to push element to
+ * @param elem Pointer to element to push
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+ * @exception errno=EAGAIN The ring buffer is full
+*/
+int ringbuf_push(RINGBUF *rbp, const void *elem)
+{
+   if (ringbuf_put(rbp, elem, 1) == 0) {
+      set_errno(EAGAIN);
+      return (-1);
+   }
+   ringbuf_notify(rbp);
+
+   return 0;
+}  /* end ringbuf_push() */
+
+/**
+ * Push, at most, @a count elements into a RINGBUF, without blocking.
+ * In RINGBUF_SPSC mode, elements are copied in (at most) two chunks,
+ * with a single update of the enqueue position.
+ * @param rbp Pointer to ring buffer to push elements to
+ * @param elems Pointer to elements to push
+ * @param count Maximum number of elements to push
+ * @returns Number of elements pushed.
+*/
+size_t ringbuf_push_n(RINGBUF *rbp, const void *elems, size_t count)
+{
+   count = ringbuf_put(rbp, elems, count);
+   if (count) ringbuf_notify(rbp);
+
+   return count;
+}  /* end ringbuf_push_n() */
+
+/**
+ * Pop an element from a RINGBUF, blocking while the ring buffer is empty.
+ * @param rbp Pointer to ring buffer to pop element from
+ * @param elem Pointer to place popped element
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+*/
+int ringbuf_wait_pop(RINGBUF *rbp, void *elem)
+{
+   while (ringbuf_get(rbp, elem, 1) == 0) {
+      mutex_lock(&rbp->lock);
+      atomic_add32(&rbp->waiting, 1);
+      atomic_fence();
+      if (ringbuf_count(rbp) == 0) {
+         if (condition_wait(&rbp->cond, &rbp->lock) != 0) {
+            atomic_add32(&rbp->waiting, -1);
+            mutex_unlock(&rbp->lock);
+            return (-1);
+         }
+      }
+      atomic_add32(&rbp->waiting, -1);
+      mutex_unlock(&rbp->lock);
+   }
+   ringbuf_notify(rbp);
+
+   return 0;
+}  /* end ringbuf_wait_pop() */
+
+/**
+ * Push an element into a RINGBUF, blocking while the ring buffer is full.
+ * @param rbp Pointer to ring buffer to push element to
+ * @param elem Pointer to element to push
+ * @returns 0 on success, or non-zero on error. Check errno for details.
+*/
+int ringbuf_wait_push(RINGBUF *rbp, const void *elem)
+{
+   while (ringbuf_put(rbp, elem, 1) == 0) {
+      mutex_lock(&rbp->lock);
+      atomic_add32(&rbp->waiting, 1);
+      atomic_fence();
+      if (ringbuf_count(rbp) > rbp->mask) {
+         if (condition_wait(&rbp->cond, &rbp->lock) != 0) {
+            atomic_add32(&rbp->waiting, -1);
+            mutex_unlock(&rbp->lock);
+            return (-1);
+         }
+      }
+      atomic_add32(&rbp->waiting, -1);
+      mutex_unlock(&rbp->lock);
+   }
+   ringbuf_notify(rbp);
+
+   return 0;
+}  /* end ringbuf_wait_push() */
+
+/* end include guard */
+#endif
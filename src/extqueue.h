@@ -0,0 +1,118 @@
+/**
+ * @file extqueue.h
+ * @brief Extended queue support.
+ * @details Provides queues for handing data between threads,
+ * including linked (intrusive) queues and bounded ring buffers.
+ * @copyright Adequate Systems LLC, 2022. All Rights Reserved.
+ * <br />For license information, please refer to ../LICENSE.md
+*/
+
+/* include guard */
+#ifndef EXTENDED_QUEUE_H
+#define EXTENDED_QUEUE_H
+
+
+#include "extlib.h"
+#include "extthrd.h"
+
+/**
+ * @struct MPSCQ Multi-producer single-consumer intrusive queue struct.
+ * Based on the non-intrusive MPSC node-based queue by Dmitry Vyukov.
+ * Producers never block and never wait on each other (wait-free),
+ * while a single consumer may poll the queue or block until a node
+ * is available. The Mutex and Condition are only touched when the
+ * consumer finds the queue empty.
+ * @property MPSCQ::head Pointer to last node pushed (producers)
+ * @property MPSCQ::waiting Consumer is (about to be) waiting on cond
+ * @property MPSCQ::tail Pointer to next node to pop (consumer)
+ * @property MPSCQ::stub Stub node, used to keep the queue linked
+ * @property MPSCQ::lock Mutex guarding a consumer wait
+ * @property MPSCQ::cond Condition signalled when the consumer waits
+ * @note Only ONE thread may pop/wait on a queue at any time.
+*/
+typedef struct mpsc_queue {
+   struct singly_linked_node *head;
+   volatile word32 waiting;
+   char pad[CACHE_LINE_SIZE - sizeof(void *) - sizeof(word32)];
+   struct singly_linked_node *tail;
+   struct singly_linked_node stub;
+   Mutex lock;
+   Condition cond;
+} MPSCQ;
+
+/**
+ * Single-producer single-consumer mode for ringbuf_init().
+*/
+#define RINGBUF_SPSC 0
+
+/**
+ * Multi-producer multi-consumer mode for ringbuf_init().
+*/
+#define RINGBUF_MPMC 1
+
+/**
+ * @struct RINGBUF Bounded lock-free ring buffer struct.
+ * Holds a power-of-two number of fixed size elements, contiguously.
+ * In RINGBUF_SPSC mode, one producer and one consumer synchronize
+ * solely through the head and tail positions. In RINGBUF_MPMC mode,
+ * based on the bounded MPMC queue by Dmitry Vyukov, positions are
+ * claimed by compare and swap and elements are published through
+ * per-element sequence numbers.
+ * @property RINGBUF::head Enqueue position (producers)
+ * @property RINGBUF::tailc Cached dequeue position (SPSC producer)
+ * @property RINGBUF::tail Dequeue position (consumers)
+ * @property RINGBUF::headc Cached enqueue position (SPSC consumer)
+ * @property RINGBUF::seq Pointer to element sequence numbers (MPMC)
+ * @property RINGBUF::data Pointer to element data
+ * @property RINGBUF::mask Number of elements, less 1
+ * @property RINGBUF::size Size of each element, in bytes
+ * @property RINGBUF::mode Ring buffer mode, RINGBUF_SPSC or RINGBUF_MPMC
+ * @property RINGBUF::waiting Number of threads (about to be) waiting
+ * @property RINGBUF::lock Mutex guarding a blocking wait
+ * @property RINGBUF::cond Condition signalled when threads are waiting
+*/
+typedef struct ring_buffer {
+   size_t head;
+   size_t tailc;
+   char pad0[CACHE_LINE_SIZE - (2 * sizeof(size_t))];
+   size_t tail;
+   size_t headc;
+   char pad1[CACHE_LINE_SIZE - (2 * sizeof(size_t))];
+   size_t *seq;
+   void *data;
+   size_t mask;
+   size_t size;
+   int mode;
+   volatile word32 waiting;
+   Mutex lock;
+   Condition cond;
+} RINGBUF;
+
+/* C/C++ compatible function prototypes */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int mpscq_destroy(MPSCQ *qp);
+int mpscq_init(MPSCQ *qp);
+int mpscq_isempty(MPSCQ *qp);
+SLNODE *mpscq_pop(MPSCQ *qp);
+int mpscq_push(SLNODE *nodep, MPSCQ *qp);
+SLNODE *mpscq_timedwait(MPSCQ *qp, unsigned int ms);
+SLNODE *mpscq_wait(MPSCQ *qp);
+size_t ringbuf_count(RINGBUF *rbp);
+int ringbuf_destroy(RINGBUF *rbp);
+int ringbuf_init(RINGBUF *rbp, size_t count, size_t size, int mode);
+int ringbuf_pop(RINGBUF *rbp, void *elem);
+size_t ringbuf_pop_n(RINGBUF *rbp, void *elems, size_t count);
+int ringbuf_push(RINGBUF *rbp, const void *elem);
+size_t ringbuf_push_n(RINGBUF *rbp, const void *elems, size_t count);
+int ringbuf_wait_pop(RINGBUF *rbp, void *elem);
+int ringbuf_wait_push(RINGBUF *rbp, const void *elem);
+
+#ifdef __cplusplus
+}  /* end extern "C" */
+#endif
+
+/* end include guard */
+#endif
@@ -14,6 +14,7 @@
 
 /* internal support */
 #include "exterrno.h"
+#include "extint.h"     /* for word32 register swaps */
 
 /* external support */
 #include <stdio.h>
@@ -24,30 +25,95 @@
 
 #endif
 
+/* SIMD support for memswap() */
+#if defined(__AVX2__)
+   #include <immintrin.h>
+   #define MEMSWAP_AVX2
+
+#elif defined(__SSE2__) || defined(_M_X64) || \
+   (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #include <emmintrin.h>
+   #define MEMSWAP_SSE2
+
+#endif
+
+/* Swap a @a T sized value between pointers @a pa and @a pb, through
+ * registers. Fixed size memcpy() is reduced to a (unaligned) move. */
+#define MEMSWAP(T, pa, pb) \
+   do { \
+      T ta_, tb_; \
+      memcpy(&ta_, pa, sizeof(T)); \
+      memcpy(&tb_, pb, sizeof(T)); \
+      memcpy(pa, &tb_, sizeof(T)); \
+      memcpy(pb, &ta_, sizeof(T)); \
+   } while (0)
+
+/* Swap 32 bytes between pointers @a pa and @a pb, through registers. */
+static inline void memswap32(unsigned char *pa, unsigned char *pb)
+{
+#if defined(MEMSWAP_AVX2)
+   __m256i ta = _mm256_loadu_si256((const __m256i *) pa);
+   __m256i tb = _mm256_loadu_si256((const __m256i *) pb);
+   _mm256_storeu_si256((__m256i *) pa, tb);
+   _mm256_storeu_si256((__m256i *) pb, ta);
+
+#elif defined(MEMSWAP_SSE2)
+   __m128i ta0 = _mm_loadu_si128((const __m128i *) pa);
+   __m128i ta1 = _mm_loadu_si128((const __m128i *) (pa + 16));
+   __m128i tb0 = _mm_loadu_si128((const __m128i *) pb);
+   __m128i tb1 = _mm_loadu_si128((const __m128i *) (pb + 16));
+   _mm_storeu_si128((__m128i *) pa, tb0);
+   _mm_storeu_si128((__m128i *) (pa + 16), tb1);
+   _mm_storeu_si128((__m128i *) pb, ta0);
+   _mm_storeu_si128((__m128i *) (pb + 16), ta1);
+
+#else
+   MEMSWAP(unsigned long long, pa, pb);
+   MEMSWAP(unsigned long long, pa + 8, pb + 8);
+   MEMSWAP(unsigned long long, pa + 16, pb + 16);
+   MEMSWAP(unsigned long long, pa + 24, pb + 24);
+
+#endif
+}  /* end memswap32() */
+
 /**
  * Swap @a count bytes between pointers @a ax and @a bx.
- * Swap occurs in, at most, BUFSIZ chunks.
+ * Swap occurs directly through registers, in 32-byte (SIMD) chunks,
+ * then 8 and 4-byte chunks, with fast paths for common element sizes.
  * @param ax Pointer to primary array of bytes to swap
  * @param bx Pointer to secondary array of bytes to swap
+ * @param count Number of bytes to swap
+ * @note Arrays must not overlap.
 */
 void memswap(void *ax, void *bx, size_t count)
 {
    unsigned char *pa = (unsigned char *) ax;
    unsigned char *pb = (unsigned char *) bx;
-   unsigned char temp[BUFSIZ];
-
-   while (count >= BUFSIZ) {
-      memcpy(temp, pa, BUFSIZ);
-      memcpy(pa, pb, BUFSIZ);
-      memcpy(pb, temp, BUFSIZ);
-      count -= BUFSIZ;
-      pa += BUFSIZ;
-      pb += BUFSIZ;
+   unsigned char t;
+
+   /* fast paths for common (element) sizes */
+   switch (count) {
+      case 4: MEMSWAP(word32, pa, pb); return;
+      case 8: MEMSWAP(unsigned long long, pa, pb); return;
+      case 16:
+         MEMSWAP(unsigned long long, pa, pb);
+         MEMSWAP(unsigned long long, pa + 8, pb + 8);
+         return;
+      case 32: memswap32(pa, pb); return;
+   }
+
+   for ( ; count >= 32; count -= 32, pa += 32, pb += 32) memswap32(pa, pb);
+   for ( ; count >= 8; count -= 8, pa += 8, pb += 8) {
+      MEMSWAP(unsigned long long, pa, pb);
+   }
+   if (count >= 4) {
+      MEMSWAP(word32, pa, pb);
+      count -= 4, pa += 4, pb += 4;
    }
-   if (count) {
-      memcpy(temp, pa, count);
-      memcpy(pa, pb, count);
-      memcpy(pb, temp, count);
+   for ( ; count; count--, pa++, pb++) {
+      t = *pa;
+      *pa = *pb;
+      *pb = t;
    }
 }  /* end memswap() */
 
@@ -136,10 +136,14 @@ int condition_timedwait(Condition *condp, Mutex *mutexp, unsigned int ms)
 
    /* obtain current time value */
    gettimeofday(&now, NULL);
-   /* add ms to time val, store in timeout */
+   /* add ms to time val, store in timeout (carry nanoseconds) */
    abs_timeout.tv_sec = now.tv_sec + (ms / 1000UL);
    abs_timeout.tv_nsec =
-      ((now.tv_usec + (ms * 1000UL)) * 1000UL) % 1000000000UL;
+      (long) ((now.tv_usec + ((ms % 1000UL) * 1000UL)) * 1000UL);
+   if (abs_timeout.tv_nsec >= 1000000000L) {
+      abs_timeout.tv_nsec -= 1000000000L;
+      abs_timeout.tv_sec++;
+   }
 
    boilerplate(
       pthread_cond_timedwait(condp, mutexp, &abs_timeout) );
@@ -61,6 +61,9 @@
    #define ext_ThreadRoutine  LPTHREAD_START_ROUTINE
    #define ext_ThreadReturn   0
 
+   /* Windows thread local storage class */
+   #define ext_ThreadLocal    __declspec(thread)
+
 /* end OS_WINDOWS */
 #else
    /* use pthreads library */
@@ -88,9 +91,99 @@
    #define ext_ThreadRoutine  THREAD_START_ROUTINE
    #define ext_ThreadReturn   NULL
 
+   /* GNU thread local storage class */
+   #define ext_ThreadLocal    __thread
+
 /* end UNIX-like */
 #endif
 
+/* atomic operations; compiler builtins where available */
+#if defined(__GNUC__) || defined(__clang__)
+   #define ext_atomic_load_ptr(pp)     __atomic_load_n(pp, __ATOMIC_ACQUIRE)
+   #define ext_atomic_store_ptr(pp, v) \
+      __atomic_store_n(pp, v, __ATOMIC_RELEASE)
+   #define ext_atomic_xchg_ptr(pp, v)  \
+      __atomic_exchange_n(pp, v, __ATOMIC_ACQ_REL)
+   #define ext_atomic_load_size(p)     __atomic_load_n(p, __ATOMIC_ACQUIRE)
+   #define ext_atomic_store_size(p, v) \
+      __atomic_store_n(p, v, __ATOMIC_RELEASE)
+   #define ext_atomic_cas_size(p, e, d) \
+      __atomic_compare_exchange_n(p, e, d, 0, \
+         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+   #define ext_atomic_load32(p)        __atomic_load_n(p, __ATOMIC_ACQUIRE)
+   #define ext_atomic_store32(p, v)    \
+      __atomic_store_n(p, v, __ATOMIC_RELEASE)
+   #define ext_atomic_add32(p, v)      \
+      __atomic_fetch_add(p, v, __ATOMIC_ACQ_REL)
+   #define ext_atomic_fence()          \
+      __atomic_thread_fence(__ATOMIC_SEQ_CST)
+   #define ext_atomic_fence_acq()      \
+      __atomic_thread_fence(__ATOMIC_ACQUIRE)
+   #define ext_atomic_fence_rel()      \
+      __atomic_thread_fence(__ATOMIC_RELEASE)
+
+/* end GNUC-like */
+#elif defined(_WIN32)
+   /* Windows API Interlocked operations (full memory barriers) */
+   #ifdef _WIN64
+      #define ext_InterlockedSize(f) f ## 64
+      #define ext_LONGSIZE           LONG64
+
+   #else
+      #define ext_InterlockedSize(f) f
+      #define ext_LONGSIZE           LONG
+
+   #endif
+
+   static __inline int ext_atomic_cas_size_win(
+      size_t volatile *p, size_t *e, size_t d)
+   {
+      size_t prev = (size_t) ext_InterlockedSize(InterlockedCompareExchange)(
+         (ext_LONGSIZE volatile *) p, (ext_LONGSIZE) d, (ext_LONGSIZE) *e);
+      if (prev == *e) return 1;
+      *e = prev;
+      return 0;
+   }
+
+   #define ext_atomic_load_ptr(pp)     \
+      InterlockedCompareExchangePointer((PVOID volatile *) (pp), NULL, NULL)
+   #define ext_atomic_store_ptr(pp, v) \
+      ((void) InterlockedExchangePointer((PVOID volatile *) (pp), (PVOID) (v)))
+   #define ext_atomic_xchg_ptr(pp, v)  \
+      InterlockedExchangePointer((PVOID volatile *) (pp), (PVOID) (v))
+   #define ext_atomic_load_size(p)     \
+      ((size_t) ext_InterlockedSize(InterlockedCompareExchange)( \
+         (ext_LONGSIZE volatile *) (p), 0, 0))
+   #define ext_atomic_store_size(p, v) \
+      ((void) ext_InterlockedSize(InterlockedExchange)( \
+         (ext_LONGSIZE volatile *) (p), (ext_LONGSIZE) (v)))
+   #define ext_atomic_cas_size(p, e, d) \
+      ext_atomic_cas_size_win((size_t volatile *) (p), e, d)
+   #define ext_atomic_load32(p)        \
+      ((ULONG) InterlockedCompareExchange((LONG volatile *) (p), 0, 0))
+   #define ext_atomic_store32(p, v)    \
+      ((void) InterlockedExchange((LONG volatile *) (p), (LONG) (v)))
+   #define ext_atomic_add32(p, v)      \
+      ((ULONG) InterlockedExchangeAdd((LONG volatile *) (p), (LONG) (v)))
+   #define ext_atomic_fence()          MemoryBarrier()
+   #define ext_atomic_fence_acq()      MemoryBarrier()
+   #define ext_atomic_fence_rel()      MemoryBarrier()
+
+/* end Windows */
+#else
+   #error Unsupported compiler for atomic operations.
+
+#endif
+
+/**
+ * Cache line size, in bytes. Used to pad data shared between threads,
+ * such that independently written fields do not share a cache line.
+*/
+#ifndef CACHE_LINE_SIZE
+   #define CACHE_LINE_SIZE 64
+
+#endif
+
 /**
  * Static Condition initializer.
  * Used to initialize a Condition at the time of declaration.
@@ -157,6 +250,17 @@
 */
 #define Unthread return ext_ThreadReturn
 
+/**
+ * Thread local storage class. Used to declare a static (or global)
+ * variable with a separate instance for each thread. A thread local
+ * variable may only be initialized with a constant expression.
+ * <br/>On Windows, expands to: `__declspec(thread)`.
+ * <br/>On Unix, expands to: `__thread`.
+ * <br/>Example usage:
+ * @code static ThreadLocal int counter = 0; @endcode
+*/
+#define ThreadLocal ext_ThreadLocal
+
 /**
  * Condition variable datatype. Used to define a "meeting place"
  * for multiple threads to "wait" on a certain condition.
@@ -206,6 +310,89 @@ typedef ext_ThreadId ThreadId;
 */
 typedef ext_ThreadRoutine ThreadRoutine;
 
+/**
+ * Atomic load of a pointer, with acquire semantics.
+ * @param pp Pointer to pointer to load
+*/
+#define atomic_load_ptr(pp)         ext_atomic_load_ptr(pp)
+
+/**
+ * Atomic store of a pointer, with release semantics.
+ * @param pp Pointer to pointer to store to
+ * @param v Pointer value to store
+*/
+#define atomic_store_ptr(pp, v)     ext_atomic_store_ptr(pp, v)
+
+/**
+ * Atomic exchange of a pointer, with acquire-release semantics.
+ * @param pp Pointer to pointer to exchange
+ * @param v Pointer value to exchange with
+ * @returns Previous pointer value of @a *pp.
+*/
+#define atomic_xchg_ptr(pp, v)      ext_atomic_xchg_ptr(pp, v)
+
+/**
+ * Atomic load of a `size_t`, with acquire semantics.
+ * @param p Pointer to `size_t` to load
+*/
+#define atomic_load_size(p)         ext_atomic_load_size(p)
+
+/**
+ * Atomic store of a `size_t`, with release semantics.
+ * @param p Pointer to `size_t` to store to
+ * @param v Value to store
+*/
+#define atomic_store_size(p, v)     ext_atomic_store_size(p, v)
+
+/**
+ * Atomic compare and swap of a `size_t`, with acquire-release semantics.
+ * If @a *p equals @a *e, @a d is stored in @a *p. Otherwise, the
+ * current value of @a *p is placed in @a *e.
+ * @param p Pointer to `size_t` to compare and swap
+ * @param e Pointer to `size_t` expected value
+ * @param d Desired value
+ * @returns 1 if the swap occurred, else 0.
+*/
+#define atomic_cas_size(p, e, d)    ext_atomic_cas_size(p, e, d)
+
+/**
+ * Atomic load of a `word32`, with acquire semantics.
+ * @param p Pointer to `word32` to load
+*/
+#define atomic_load32(p)            ext_atomic_load32(p)
+
+/**
+ * Atomic store of a `word32`, with release semantics.
+ * @param p Pointer to `word32` to store to
+ * @param v Value to store
+*/
+#define atomic_store32(p, v)        ext_atomic_store32(p, v)
+
+/**
+ * Atomic addition to a `word32`, with acquire-release semantics.
+ * @param p Pointer to `word32` to add to
+ * @param v Value to add
+ * @returns Previous value of @a *p.
+*/
+#define atomic_add32(p, v)          ext_atomic_add32(p, v)
+
+/**
+ * Full (sequentially consistent) memory fence.
+*/
+#define atomic_fence()              ext_atomic_fence()
+
+/**
+ * Acquire memory fence. Memory operations after the fence are not
+ * reordered before loads preceding the fence.
+*/
+#define atomic_fence_acq()          ext_atomic_fence_acq()
+
+/**
+ * Release memory fence. Memory operations before the fence are not
+ * reordered after stores following the fence.
+*/
+#define atomic_fence_rel()          ext_atomic_fence_rel()
+
 /* C/C++ compatible function prototypes */
 #ifdef __cplusplus
 extern "C" {
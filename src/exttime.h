@@ -20,6 +20,33 @@
 
 #endif
 
+/**
+ * Get a monotonic time, in milliseconds. Suitable only for measuring
+ * intervals, as the reference point is unspecified.
+ * @returns Milliseconds since an unspecified reference point.
+*/
+static inline unsigned long long millitime(void)
+{
+#ifdef _WIN32
+   return (unsigned long long) GetTickCount64();
+
+/* end Windows */
+#elif _POSIX_VERSION >= 199309L
+   /* clock_gettime() is specified by POSIX.1b-1993... */
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((unsigned long long) ts.tv_sec * 1000ULL) +
+      ((unsigned long long) ts.tv_nsec / 1000000ULL);
+
+/* end _POSIX_VERSION >= 199309L */
+#else
+   return (unsigned long long) time(NULL) * 1000ULL;
+
+/* end remaining UNIX-like */
+#endif
+}
+
 /**
  * Suspend the current thread for a specified number of milliseconds.
  * @param ms Number of milliseconds to suspend the current thread
@@ -0,0 +1,41 @@
+
+/* library (out-of-line) accessors, for comparison in extmath-inline.c;
+ * a separate translation unit, built WITHOUT EXTC_INLINE, such that
+ * every call is a call into the library */
+
+#undef EXTC_INLINE
+
+#include "_extmath-inline.h"
+
+#include "extlib.h"
+#include "extmath.h"
+
+word16 lib_get16(const void *buff)
+{
+   return get16(buff);
+}
+
+word32 lib_get32(const void *buff)
+{
+   return get32(buff);
+}
+
+void lib_put16(void *buff, word16 value)
+{
+   put16(buff, value);
+}
+
+void lib_put32(void *buff, word32 value)
+{
+   put32(buff, value);
+}
+
+void lib_put64(void *buff, const void *value)
+{
+   put64(buff, value);
+}
+
+int lib_iszero(const void *buff, int len)
+{
+   return iszero(buff, len);
+}
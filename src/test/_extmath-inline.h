@@ -0,0 +1,27 @@
+/**
+ * @private
+ * @file _extmath-inline.h
+ * @brief Test support; library (out-of-line) accessors.
+ * @details Wrappers of library accessors, defined in _extmath-inline.c,
+ * a translation unit built WITHOUT `EXTC_INLINE`. References for the
+ * inline (`EXTC_INLINE`) forms in extmath-inline.c.
+ * @copyright Adequate Systems LLC, 2022. All Rights Reserved.
+ * <br />For license information, please refer to ../LICENSE.md
+*/
+
+/* include guard */
+#ifndef TEST_EXTMATH_INLINE_H
+#define TEST_EXTMATH_INLINE_H
+
+
+#include "extint.h"
+
+word16 lib_get16(const void *buff);
+word32 lib_get32(const void *buff);
+void lib_put16(void *buff, word16 value);
+void lib_put32(void *buff, word32 value);
+void lib_put64(void *buff, const void *value);
+int lib_iszero(const void *buff, int len);
+
+/* end include guard */
+#endif
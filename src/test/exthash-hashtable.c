@@ -0,0 +1,137 @@
+
+#include "_assert.h"
+#include "exthash.h"
+
+#include "exterrno.h"
+#include "extlib.h"
+#include <stdio.h>
+
+#define FNAME     "hashtable.dat"
+#define KEYLEN    32
+#define COUNT     100000
+
+typedef struct {
+   word8 key[KEYLEN];
+   word32 value;
+} RECORD;
+
+int comp(const void *a, const void *b)
+{
+   return memcmp(a, b, KEYLEN);
+}
+
+int main()
+{  /* check; operation and failures of HASHTABLE operation */
+   static RECORD records[COUNT];
+   HASHTABLE table;
+   FILE *fp;
+   word32 *vp, value;
+   size_t i, j;
+
+   /* generate distinct random keys */
+   srand32(12345);
+   for (i = 0; i < COUNT; i++) {
+      for (j = 0; j < KEYLEN; j += 4) put32(&records[i].key[j], rand32());
+      put32(records[i].key, (word32) i);
+      records[i].value = (word32) i;
+   }
+
+   /* FUNCTION TESTS */
+
+   /* put keys through multiple (incremental) resizes */
+   ASSERT_EQ(hashtable_init(&table, KEYLEN, sizeof(word32), 0, 1), 0);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_EQ(hashtable_put(&table, records[i].key, &records[i].value), 0);
+      /* check a previous key during migration */
+      ASSERT_NE((vp = hashtable_get(&table, records[i / 2].key)), NULL);
+      ASSERT_EQ(*vp, records[i / 2].value);
+   }
+   ASSERT_EQ(table.count, COUNT);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_NE((vp = hashtable_get(&table, records[i].key)), NULL);
+      ASSERT_EQ(*vp, records[i].value);
+   }
+   /* overwrite values */
+   for (i = 0; i < COUNT; i += 2) {
+      value = (word32) (i * 2);
+      ASSERT_EQ(hashtable_put(&table, records[i].key, &value), 0);
+   }
+   ASSERT_EQ(table.count, COUNT);
+   /* remove every other key, check remaining */
+   for (i = 0; i < COUNT; i += 2) {
+      ASSERT_EQ(hashtable_remove(&table, records[i].key), 0);
+   }
+   ASSERT_EQ(table.count, COUNT / 2);
+   for (i = 0; i < COUNT; i++) {
+      vp = hashtable_get(&table, records[i].key);
+      if (i & 1) {
+         ASSERT_NE(vp, NULL);
+         ASSERT_EQ(*vp, records[i].value);
+      } else ASSERT_EQ(vp, NULL);
+   }
+   /* reinsert removed keys, reusing deleted slots */
+   for (i = 0; i < COUNT; i += 2) {
+      ASSERT_EQ(hashtable_put(&table, records[i].key, NULL), 0);
+      ASSERT_NE((vp = hashtable_get(&table, records[i].key)), NULL);
+      ASSERT_EQ(*vp, 0);
+   }
+   ASSERT_EQ(table.count, COUNT);
+   hashtable_destroy(&table);
+
+   /* bulk-build from a sorted file, with duplicate keys */
+   ASSERT_NE((fp = fopen(FNAME, "wb")), NULL);
+   ASSERT_EQ(fwrite(records, sizeof(RECORD), COUNT, fp), COUNT);
+   ASSERT_EQ(fwrite(records, sizeof(RECORD), 1, fp), 1);
+   fclose(fp);
+   ASSERT_EQ(filesort(FNAME, sizeof(RECORD), BUFSIZ, comp), 0);
+   ASSERT_EQ(hashtable_init(&table, KEYLEN, sizeof(word32), 0, 2), 0);
+   ASSERT_EQ(hashtable_build(&table, FNAME), 0);
+   ASSERT_EQ(table.count, COUNT);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_NE((vp = hashtable_get(&table, records[i].key)), NULL);
+      ASSERT_EQ(*vp, records[i].value);
+   }
+   /* bulk-build into a non-empty table */
+   ASSERT_EQ(hashtable_remove(&table, records[1].key), 0);
+   ASSERT_EQ(hashtable_build(&table, FNAME), 0);
+   ASSERT_EQ(table.count, COUNT);
+   ASSERT_NE(hashtable_get(&table, records[1].key), NULL);
+   hashtable_destroy(&table);
+   /* bulk-build from an unsorted file, with a non-adjacent duplicate */
+   ASSERT_NE((fp = fopen(FNAME, "wb")), NULL);
+   ASSERT_EQ(fwrite(records, sizeof(RECORD), COUNT, fp), COUNT);
+   ASSERT_EQ(fwrite(records, sizeof(RECORD), 1, fp), 1);
+   fclose(fp);
+   ASSERT_EQ(hashtable_init(&table, KEYLEN, sizeof(word32), 0, 3), 0);
+   ASSERT_EQ(hashtable_build(&table, FNAME), 0);
+   ASSERT_EQ(table.count, COUNT);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_NE((vp = hashtable_get(&table, records[i].key)), NULL);
+      ASSERT_EQ(*vp, records[i].value);
+   }
+   hashtable_destroy(&table);
+   remove(FNAME);
+
+   /* FAILURE TESTS */
+
+   ASSERT_EQ(hashtable_init(&table, KEYLEN, 0, 0, 0), 0);
+   set_errno(0);
+   ASSERT_NE(hashtable_remove(&table, records[0].key), 0);
+   ASSERT_EQ(errno, ENOENT);
+   ASSERT_EQ(hashtable_get(&table, records[0].key), NULL);
+   set_errno(0);
+   ASSERT_NE(hashtable_put(&table, NULL, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(hashtable_build(&table, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_NE(hashtable_build(&table, "dummy.file"), 0);
+   set_errno(0);
+   ASSERT_NE(hashtable_reserve(&table, (size_t) -1), 0);
+   ASSERT_EQ(errno, ENOMEM);
+   hashtable_destroy(&table);
+   set_errno(0);
+   ASSERT_NE(hashtable_init(&table, 0, 0, 0, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_NE(hashtable_init(NULL, KEYLEN, 0, 0, 0), 0);
+}
@@ -0,0 +1,152 @@
+
+#include "_assert.h"
+#include "exthash.h"
+
+#include "exterrno.h"
+#include "extlib.h"
+
+#define KEYLEN       32
+#define COUNT        20000
+#define NUMTHREADS   4
+#define ITERATIONS   20000
+
+typedef struct {
+   word8 key[KEYLEN];
+   word32 value[2];
+} RECORD;
+
+static RECORD si_records[COUNT * 2];
+static SHARDMAP si_map;
+static volatile int si_done;
+
+ThreadProc writer(void *args)
+{
+   long id = *((long *) args);
+   word32 value[2];
+   long i, j;
+
+   for (i = 0; i < ITERATIONS; i++) {
+      /* overwrite a persistent key with a self-checking value */
+      j = (i * NUMTHREADS + id) % COUNT;
+      value[0] = (word32) (i * NUMTHREADS + id);
+      value[1] = ~value[0];
+      ASSERT_EQ(shardmap_put(&si_map, si_records[j].key, value), 0);
+      /* insert and remove transient keys, forcing growth and purges */
+      j = COUNT + ((i * NUMTHREADS + id) % COUNT);
+      ASSERT_EQ(shardmap_put(&si_map, si_records[j].key, value), 0);
+      if (i & 1) ASSERT_EQ(shardmap_remove(&si_map, si_records[j].key), 0);
+   }
+
+   Unthread;
+}
+
+ThreadProc reader(void *args)
+{
+   word32 value[2];
+   long i;
+
+   (void) args;
+   for (i = 0; !si_done || i < ITERATIONS; i++) {
+      /* persistent keys are always found, and never torn */
+      ASSERT_EQ(shardmap_get(&si_map, si_records[i % COUNT].key, value), 0);
+      ASSERT_EQ(value[1], ~value[0]);
+   }
+
+   Unthread;
+}
+
+int main()
+{  /* check; operation and failures of SHARDMAP operation */
+   Thread writers[NUMTHREADS], readers[NUMTHREADS];
+   long ids[NUMTHREADS];
+   word32 value[2];
+   size_t i, j;
+
+   /* generate distinct random keys */
+   srand32(54321);
+   for (i = 0; i < COUNT * 2; i++) {
+      for (j = 0; j < KEYLEN; j += 4) put32(&si_records[i].key[j], rand32());
+      put32(si_records[i].key, (word32) i);
+      si_records[i].value[0] = (word32) i;
+      si_records[i].value[1] = ~((word32) i);
+   }
+
+   /* FUNCTION TESTS */
+
+   /* shard count is rounded up to a power of two */
+   ASSERT_EQ(shardmap_init(&si_map, KEYLEN, sizeof(value), 5, 1), 0);
+   ASSERT_EQ(si_map.mask, 7);
+   ASSERT_EQ((size_t) si_map.shards % CACHE_LINE_SIZE, 0);
+   ASSERT_EQ(si_map.shardsz % CACHE_LINE_SIZE, 0);
+   /* put keys through multiple resizes */
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_EQ(shardmap_put(&si_map, si_records[i].key, si_records[i].value), 0);
+   }
+   ASSERT_EQ(shardmap_count(&si_map), COUNT);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_EQ(shardmap_get(&si_map, si_records[i].key, value), 0);
+      ASSERT_CMP(value, si_records[i].value, sizeof(value));
+   }
+   /* overwrite, remove and reinsert keys */
+   ASSERT_EQ(shardmap_put(&si_map, si_records[0].key, NULL), 0);
+   ASSERT_EQ(shardmap_get(&si_map, si_records[0].key, value), 0);
+   ASSERT_EQ(value[0], 0);
+   ASSERT_EQ(shardmap_put(&si_map, si_records[0].key, si_records[0].value), 0);
+   for (i = 0; i < COUNT; i += 2) {
+      ASSERT_EQ(shardmap_remove(&si_map, si_records[i].key), 0);
+   }
+   ASSERT_EQ(shardmap_count(&si_map), COUNT / 2);
+   for (i = 0; i < COUNT; i++) {
+      if (i & 1) ASSERT_EQ(shardmap_get(&si_map, si_records[i].key, NULL), 0);
+      else ASSERT_NE(shardmap_get(&si_map, si_records[i].key, NULL), 0);
+   }
+   for (i = 0; i < COUNT; i += 2) {
+      ASSERT_EQ(shardmap_put(&si_map, si_records[i].key, si_records[i].value), 0);
+   }
+   ASSERT_EQ(shardmap_count(&si_map), COUNT);
+
+   /* concurrent writers and (lock-free) readers */
+   si_done = 0;
+   for (i = 0; i < NUMTHREADS; i++) {
+      ids[i] = (long) i;
+      ASSERT_EQ(thread_create(&readers[i], reader, NULL), 0);
+      ASSERT_EQ(thread_create(&writers[i], writer, &ids[i]), 0);
+   }
+   for (i = 0; i < NUMTHREADS; i++) ASSERT_EQ(thread_join(writers[i]), 0);
+   si_done = 1;
+   for (i = 0; i < NUMTHREADS; i++) ASSERT_EQ(thread_join(readers[i]), 0);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_EQ(shardmap_get(&si_map, si_records[i].key, value), 0);
+      ASSERT_EQ(value[1], ~value[0]);
+   }
+   shardmap_destroy(&si_map);
+
+   /* default shard count */
+   ASSERT_EQ(shardmap_init(&si_map, KEYLEN, 0, 0, 0), 0);
+   ASSERT_GE(si_map.mask + 1, 4);
+   ASSERT_EQ(shardmap_put(&si_map, si_records[0].key, NULL), 0);
+   ASSERT_EQ(shardmap_get(&si_map, si_records[0].key, NULL), 0);
+
+   /* FAILURE TESTS */
+
+   set_errno(0);
+   ASSERT_NE(shardmap_get(&si_map, si_records[1].key, value), 0);
+   ASSERT_EQ(errno, ENOENT);
+   set_errno(0);
+   ASSERT_NE(shardmap_remove(&si_map, si_records[1].key), 0);
+   ASSERT_EQ(errno, ENOENT);
+   set_errno(0);
+   ASSERT_NE(shardmap_put(&si_map, NULL, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(shardmap_remove(NULL, si_records[0].key), 0);
+   ASSERT_EQ(errno, EINVAL);
+   shardmap_destroy(&si_map);
+   set_errno(0);
+   ASSERT_NE(shardmap_init(&si_map, 0, 0, 0, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(shardmap_init(&si_map, KEYLEN, 0, (size_t) -1, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_NE(shardmap_init(NULL, KEYLEN, 0, 0, 0), 0);
+}
@@ -0,0 +1,50 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "extmath.h"
+#include <string.h>
+
+#define MAXCOUNT  300
+
+int main()
+{  /* check bswap32/64_array() reverse bytes of each element */
+   static const unsigned overrides[] = {
+      0, CPU_FEATURE_SSSE3, CPU_FEATURE_ALL
+   };
+   static unsigned char src[(MAXCOUNT * 8) + 1], dst[(MAXCOUNT * 8) + 2];
+   static unsigned char expect[MAXCOUNT * 8];
+   size_t i, k, n, off;
+
+   for (i = 0; i < sizeof(src); i++) src[i] = (unsigned char) (i * 7);
+
+   /* every kernel and count (across vector widths), misaligned too */
+   for (k = 0; k < sizeof(overrides) / sizeof(overrides[0]); k++) {
+      extmath_dispatch(overrides[k]);
+      for (off = 0; off < 2; off++) {
+         for (n = 0; n <= MAXCOUNT; n++) {
+            for (i = 0; i < n * 4; i++) {
+               expect[i] = src[off + (i & ~(size_t) 3) + 3 - (i & 3)];
+            }
+            memset(dst, 0xaa, sizeof(dst));
+            bswap32_array(&dst[off], &src[off], n);
+            ASSERT_CMP(&dst[off], expect, n * 4);
+            ASSERT_EQ(dst[off + (n * 4)], 0xaa);
+            for (i = 0; i < n * 8; i++) {
+               expect[i] = src[off + (i & ~(size_t) 7) + 7 - (i & 7)];
+            }
+            memset(dst, 0xaa, sizeof(dst));
+            bswap64_array(&dst[off], &src[off], n);
+            ASSERT_CMP(&dst[off], expect, n * 8);
+            ASSERT_EQ(dst[off + (n * 8)], 0xaa);
+            /* in place, and back */
+            bswap64_array(&dst[off], &dst[off], n);
+            ASSERT_CMP(&dst[off], &src[off], n * 8);
+         }
+      }
+   }
+   extmath_dispatch(CPU_FEATURE_ALL);
+   /* 32-bit elements are big-endian values */
+   bswap32_array(dst, src, 4);
+   ASSERT_EQ(get32(&dst[4]), get32be(&src[4]));
+}
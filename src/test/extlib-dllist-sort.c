@@ -0,0 +1,125 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "exterrno.h"
+
+#define COUNT  1000
+
+typedef struct {
+   int key;
+   int seq;
+} ITEM;
+
+int comp(const void *a, const void *b)
+{
+   return ((const ITEM *) a)->key - ((const ITEM *) b)->key;
+}
+
+/* check linkage and count of a list, and return sorted state */
+static int check_list(DLLIST *listp, int sorted)
+{
+   DLNODE *np, *prevp;
+   ITEM *a, *b;
+   int count;
+
+   for (count = 0, prevp = NULL, np = listp->next; np; np = np->next) {
+      ASSERT_EQ(np->prev, prevp);
+      if (sorted && prevp) {
+         a = (ITEM *) prevp->data;
+         b = (ITEM *) np->data;
+         /* stable; equal keys retain order */
+         ASSERT_LE(a->key, b->key);
+         if (a->key == b->key) ASSERT_LT(a->seq, b->seq);
+      }
+      prevp = np;
+      count++;
+   }
+   ASSERT_EQ(listp->last, prevp);
+   ASSERT_EQ(listp->count, count);
+
+   return count;
+}
+
+int main()
+{  /* check; operation and failures of DLLIST sort, split and splice */
+   DLLIST list = { 0 }, list2 = { 0 }, empty = { 0 };
+   DLNODE *np, *first, *last, *nodes[COUNT];
+   int i;
+
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_NE((nodes[i] = dlnode_create(sizeof(ITEM))), NULL);
+      ((ITEM *) nodes[i]->data)->key = (int) (rand16() % 64);
+      ((ITEM *) nodes[i]->data)->seq = i;
+      ASSERT_EQ(dlnode_append(nodes[i], &list), 0);
+   }
+
+   /* FUNCTION TESTS */
+
+   /* stable sort, incl. empty and single node lists */
+   ASSERT_EQ(dllist_sort(&empty, comp), 0);
+   ASSERT_EQ(check_list(&empty, 1), 0);
+   ASSERT_EQ(dllist_sort(&list, comp), 0);
+   ASSERT_EQ(check_list(&list, 1), COUNT);
+   /* split at a middle node, then at the head */
+   for (np = list.next, i = 0; i < COUNT / 4; i++) np = np->next;
+   ASSERT_EQ(dllist_split(&list, np, &list2), 0);
+   ASSERT_EQ(check_list(&list, 1), COUNT / 4);
+   ASSERT_EQ(check_list(&list2, 1), COUNT - (COUNT / 4));
+   ASSERT_EQ(list2.next, np);
+   ASSERT_EQ(dllist_split(&list2, list2.next, &list), 0);
+   ASSERT_EQ(check_list(&list, 1), COUNT);
+   ASSERT_EQ(check_list(&list2, 0), 0);
+   /* splice a range to an empty list, with a known count */
+   first = list.next->next;
+   for (last = first, i = 1; i < 10; i++) last = last->next;
+   ASSERT_EQ(dllist_splice(&list2, NULL, &list, first, last, 10), 0);
+   ASSERT_EQ(check_list(&list, 1), COUNT - 10);
+   ASSERT_EQ(check_list(&list2, 1), 10);
+   ASSERT_EQ(list2.next, first);
+   ASSERT_EQ(list2.last, last);
+   /* splice back, before the head, with counting */
+   ASSERT_EQ(dllist_splice(&list, list.next, &list2, first, last, -1), 0);
+   ASSERT_EQ(check_list(&list, 0), COUNT);
+   ASSERT_EQ(check_list(&list2, 0), 0);
+   ASSERT_EQ(list.next, first);
+   /* splice within a list, moving the head range to the tail */
+   ASSERT_EQ(dllist_splice(&list, NULL, &list, first, last, 10), 0);
+   ASSERT_EQ(check_list(&list, 0), COUNT);
+   ASSERT_EQ(list.last, last);
+   /* splice the tail range before a middle node */
+   np = list.next->next->next;
+   ASSERT_EQ(dllist_splice(&list, np, &list, first, last, 10), 0);
+   ASSERT_EQ(check_list(&list, 0), COUNT);
+   ASSERT_EQ(np->prev, last);
+   /* resort */
+   ASSERT_EQ(dllist_sort(&list, comp), 0);
+   ASSERT_EQ(check_list(&list, 0), COUNT);
+
+   /* FAILURE TESTS */
+
+   set_errno(0);
+   ASSERT_NE(dllist_sort(NULL, comp), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(dllist_sort(&list, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(dllist_split(&empty, list.next, &list2), 0);
+   ASSERT_EQ(errno, ENOLINK);
+   set_errno(0);
+   ASSERT_NE(dllist_splice(&list2, NULL, &list, NULL, list.last, 1), 0);
+   ASSERT_EQ(errno, EINVAL);
+   /* range that does not reach last node */
+   set_errno(0);
+   ASSERT_NE(dllist_splice(&list2, NULL, &list, list.last,
+      list.next, -1), 0);
+   ASSERT_EQ(errno, ENOLINK);
+   ASSERT_EQ(check_list(&list, 0), COUNT);
+
+   /* cleanup */
+   while ((np = list.next)) {
+      ASSERT_EQ(dlnode_remove(np, &list), 0);
+      dlnode_destroy(np);
+   }
+}
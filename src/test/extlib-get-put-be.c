@@ -0,0 +1,25 @@
+
+#include "_assert.h"
+#include "../extlib.h"
+
+int main()
+{  /* check big-endian accessors get/put16/32/64be(), at any alignment */
+   unsigned char data[9] = { 0x1, 0x3, 0x7, 0xff, 0xf, 0x1f, 0x3f, 0x7f, 0xff };
+   unsigned char expect[9] = { 0 };
+   unsigned char array[9] = { 0 };
+
+   ASSERT_EQ(get16be(data), 0x0103);
+   ASSERT_EQ(get16be(&data[7]), 0x7fff);
+   ASSERT_EQ(get32be(data), WORD32_C(0x010307ff));
+   ASSERT_EQ(get32be(&data[5]), WORD32_C(0x1f3f7fff));
+   put16be(&array[1], 0x0307);
+   put32be(&array[3], WORD32_C(0xff0f1f3f));
+   memcpy(&expect[1], &data[1], 6);
+   ASSERT_CMP(array, expect, 9);
+#ifdef HAS_64BIT
+   ASSERT_EQ(get64be(data), WORD64_C(0x010307ff0f1f3f7f));
+   ASSERT_EQ(get64be(&data[1]), WORD64_C(0x0307ff0f1f3f7fff));
+   put64be(&array[1], WORD64_C(0x0307ff0f1f3f7fff));
+   ASSERT_CMP(&array[1], &data[1], 8);
+#endif
+}
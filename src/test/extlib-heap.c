@@ -0,0 +1,131 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "exterrno.h"
+
+#define COUNT  1000
+
+typedef struct {
+   word32 id;
+   word32 pad;
+   word64 fee;
+} TX;
+
+int comp_fee_desc(const void *a, const void *b)
+{
+   const TX *ta = (const TX *) a;
+   const TX *tb = (const TX *) b;
+
+   return (ta->fee < tb->fee) - (ta->fee > tb->fee);
+}
+
+int main()
+{  /* check; operation and failures of HEAP operation */
+   static TX list[COUNT];
+   static size_t handles[COUNT];
+   HEAP heap;
+   TX tx, *txp;
+   word64 prev;
+   size_t i;
+
+   srand32(123);
+   for (i = 0; i < COUNT; i++) {
+      list[i].id = (word32) i;
+      list[i].pad = 0;
+      list[i].fee = 1 + (rand32() % (COUNT / 2));
+   }
+
+   /* FUNCTION TESTS */
+
+   /* inline key (min-heap) -- push and pop in ascending order */
+   ASSERT_EQ(heap_init(&heap, sizeof(TX), 0, NULL, 8), 0);
+   ASSERT_EQ(heap_peek(&heap), NULL);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_EQ(heap_push(&heap, &list[i], &handles[i]), 0);
+   }
+   ASSERT_EQ(heap.count, COUNT);
+   /* decrease-key of every 10th element to below all others */
+   for (i = 0; i < COUNT; i += 10) {
+      tx = list[i];
+      tx.fee = 0;
+      ASSERT_EQ(heap_update(&heap, handles[i], &tx), 0);
+   }
+   /* increase-key of every 10th (+1) element to above all others */
+   for (i = 1; i < COUNT; i += 10) {
+      tx = list[i];
+      tx.fee = COUNT;
+      ASSERT_EQ(heap_update(&heap, handles[i], &tx), 0);
+   }
+   /* remove every 10th (+2) element */
+   for (i = 2; i < COUNT; i += 10) {
+      ASSERT_EQ(heap_remove(&heap, handles[i], &tx), 0);
+      ASSERT_EQ(tx.id, list[i].id);
+   }
+   ASSERT_EQ(heap.count, COUNT - (COUNT / 10));
+   ASSERT_NE((txp = heap_peek(&heap)), NULL);
+   ASSERT_EQ(txp->fee, 0);
+   for (prev = 0, i = 0; heap.count; i++) {
+      ASSERT_EQ(heap_pop(&heap, &tx), 0);
+      ASSERT_GE(tx.fee, prev);
+      if (i < COUNT / 10) ASSERT_EQ(tx.id % 10, 0);
+      if (i >= COUNT - (COUNT / 5)) ASSERT_EQ(tx.id % 10, 1);
+      prev = tx.fee;
+   }
+   ASSERT_EQ(i, COUNT - (COUNT / 10));
+   /* handles are reused */
+   ASSERT_EQ(heap_push(&heap, &list[0], &handles[0]), 0);
+   ASSERT_LT(handles[0], COUNT);
+   heap_destroy(&heap);
+
+   /* comparator (max-heap by fee) -- O(n) bulk build */
+   ASSERT_EQ(heap_init(&heap, sizeof(TX), COUNT, comp_fee_desc, 0), 0);
+   ASSERT_EQ(heap_build(&heap, list, COUNT / 2, handles), 0);
+   ASSERT_EQ(heap_push(&heap, &list[COUNT / 2], NULL), 0);
+   ASSERT_EQ(heap_build(&heap, &list[COUNT / 2 + 1], COUNT / 2 - 1,
+      &handles[COUNT / 2 + 1]), 0);
+   ASSERT_EQ(heap.count, COUNT);
+   /* handles of built elements are valid */
+   tx = list[COUNT - 1];
+   tx.fee = COUNT;
+   ASSERT_EQ(heap_update(&heap, handles[COUNT - 1], &tx), 0);
+   ASSERT_EQ(((TX *) heap_peek(&heap))->id, COUNT - 1);
+   for (prev = COUNT; heap.count; ) {
+      ASSERT_EQ(heap_pop(&heap, &tx), 0);
+      ASSERT_LE(tx.fee, prev);
+      prev = tx.fee;
+   }
+   heap_destroy(&heap);
+
+   /* FAILURE TESTS */
+
+   ASSERT_EQ(heap_init(&heap, sizeof(TX), 0, NULL, 0), 0);
+   set_errno(0);
+   ASSERT_NE(heap_pop(&heap, &tx), 0);
+   ASSERT_EQ(errno, ENOLINK);
+   ASSERT_EQ(heap_push(&heap, &list[0], &handles[0]), 0);
+   ASSERT_EQ(heap_pop(&heap, NULL), 0);
+   set_errno(0);
+   ASSERT_NE(heap_update(&heap, handles[0], &list[0]), 0);
+   ASSERT_EQ(errno, ENOENT);
+   set_errno(0);
+   ASSERT_NE(heap_remove(&heap, (size_t) -1, NULL), 0);
+   ASSERT_EQ(errno, ENOENT);
+   set_errno(0);
+   ASSERT_NE(heap_push(&heap, NULL, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(heap_build(&heap, NULL, 1, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(heap_build(&heap, list, (size_t) -1, NULL), 0);
+   ASSERT_EQ(errno, ENOMEM);
+   heap_destroy(&heap);
+   set_errno(0);
+   ASSERT_NE(heap_init(&heap, 0, 0, NULL, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(heap_init(&heap, sizeof(TX), 0, NULL, 12), 0);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_NE(heap_init(NULL, sizeof(TX), 0, NULL, 0), 0);
+}
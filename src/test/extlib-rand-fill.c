@@ -0,0 +1,68 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "extmath.h"
+#include <string.h>
+
+#define BUFLEN    4099
+
+int main()
+{  /* check; rand_fill() output against a reference of interleaved lanes */
+   static unsigned char buf[BUFLEN + 1], ref[BUFLEN + 1];
+   static const unsigned overrides[] = {
+      0, CPU_FEATURE_SSE2, CPU_FEATURE_ALL
+   };
+   RANDSTATE state, copy, lanes[RANDFILL_LANES];
+   unsigned long long seed;
+   size_t i, len;
+   word32 r;
+   int j, k;
+
+   /* FUNCTION TESTS */
+
+   /* small buffers are filled directly by rand32_r() */
+   srand32_r(&state, 1);
+   copy = state;
+   rand_fill(&state, buf, 11);
+   for (i = 0; i < 11; i += 4) {
+      r = rand32_r(&copy);
+      ASSERT_CMP(&buf[i], &r, (11 - i) < 4 ? 11 - i : 4);
+   }
+   ASSERT_CMP(&state, &copy, sizeof(state));
+
+   /* large buffers, of various (odd) lengths, match a scalar reference
+    * of lanes seeded as srand32_r(), from consecutive SplitMix64 seeds,
+    * with every kernel selection */
+   for (k = 0; k < (int) (sizeof(overrides) / sizeof(*overrides)); k++) {
+      extmath_dispatch(overrides[k]);
+      for (len = RANDFILL_LANES * RANDFILL_LANES * 4; len <= BUFLEN;
+            len += 333) {
+         srand32_r(&state, (word32) len);
+         copy = state;
+         memset(buf, 0xa5, sizeof(buf));
+         rand_fill(&state, buf, len);
+         /* state advances once per 64-bit lane seed */
+         seed = rand32_r(&copy);
+         seed |= (unsigned long long) rand32_r(&copy) << 32;
+         ASSERT_CMP(&state, &copy, sizeof(state));
+         for (j = 0; j < RANDFILL_LANES; j++) {
+            srand32_r(&lanes[j], seed);
+            seed += WORD64_C(0x3c6ef372fe94f82a);
+         }
+         for (i = 0; i < len; i += 4) {
+            r = rand32_r(&lanes[(i / 4) % RANDFILL_LANES]);
+            memcpy(&ref[i], &r, 4);
+         }
+         ASSERT_CMP(buf, ref, len);
+         /* no overrun */
+         ASSERT_EQ(buf[len], 0xa5);
+      }
+   }
+   extmath_dispatch(CPU_FEATURE_ALL);
+
+   /* zero length does nothing */
+   copy = state;
+   rand_fill(&state, buf, 0);
+   ASSERT_CMP(&state, &copy, sizeof(state));
+}
@@ -0,0 +1,73 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "extthrd.h"
+#include <string.h>
+
+#define NUMTHREADS   4
+#define ITERATIONS   100000
+
+word32 si_results[NUMTHREADS];
+word32 si_firsts[NUMTHREADS];
+
+ThreadProc generate(void *args)
+{
+   RANDSTATE initial = RANDSTATE_INITIALIZER;
+   word32 *result = (word32 *) args;
+   word32 i, sum;
+
+   /* record the first value of the (unseeded) default state */
+   si_firsts[result - si_results] = rand32();
+   *rand_state() = initial;
+   srand32(1234);
+   for (sum = i = 0; i < ITERATIONS; i++) sum += rand32() ^ rand16();
+   *result = sum;
+
+   Unthread;
+}
+
+int main()
+{  /* check; reentrant PRNG's and thread local default state */
+   RANDSTATE initial = RANDSTATE_INITIALIZER;
+   RANDSTATE state = RANDSTATE_INITIALIZER;
+   Thread threads[NUMTHREADS];
+   word32 i, j, sum, first;
+
+   /* reentrant PRNG's match the sequences of default PRNG's */
+   for (i = 0; i < 1000; i++) {
+      ASSERT_EQ(rand16fast_r(&state), rand16fast());
+      ASSERT_EQ(rand16_r(&state), rand16());
+      ASSERT_EQ(rand32_r(&state), rand32());
+   }
+   srand16fast_r(&state, 5);
+   srand16fast(5);
+   srand16_r(&state, 1, 2, 3);
+   srand16(1, 2, 3);
+   srand32_r(&state, 42);
+   srand32(42);
+   ASSERT_CMP(&state, rand_state(), sizeof(state));
+   for (i = 0; i < 1000; i++) {
+      ASSERT_EQ(rand16fast_r(&state), rand16fast());
+      ASSERT_EQ(rand16_r(&state), rand16());
+      ASSERT_EQ(rand32_r(&state), rand32());
+   }
+
+   /* threads do not share default state; sequences are deterministic */
+   for (i = 0; i < NUMTHREADS; i++) {
+      ASSERT_EQ(thread_create(&threads[i], generate, &si_results[i]), 0);
+   }
+   for (i = 0; i < NUMTHREADS; i++) ASSERT_EQ(thread_join(threads[i]), 0);
+   /* unseeded threads begin with distinct default states */
+   state = initial;
+   first = rand32_r(&state);
+   for (i = 0; i < NUMTHREADS; i++) {
+      ASSERT_NE(si_firsts[i], first);
+      for (j = 0; j < i; j++) ASSERT_NE(si_firsts[i], si_firsts[j]);
+   }
+   /* the calling thread is unaffected by other threads seeding */
+   *rand_state() = initial;
+   srand32(1234);
+   for (sum = i = 0; i < ITERATIONS; i++) sum += rand32() ^ rand16();
+   for (i = 0; i < NUMTHREADS; i++) ASSERT_EQ(si_results[i], sum);
+}
@@ -0,0 +1,49 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include <string.h>
+
+#define STREAMS   4
+
+int main()
+{  /* check; rand32() full state seeding, jump, long jump and split */
+   RANDSTATE state = RANDSTATE_INITIALIZER;
+   RANDSTATE other, streams[STREAMS];
+   word32 seed[4] = { 0x12345678, 0x9abcdef0, 0x0fedcba9, 0x87654321 };
+   word32 jump[4] = { 0x72b2ad32, 0x15ed5bb2, 0xa7135069, 0xf9af4baf };
+   word32 long_jump[4] = { 0x17bfc5ed, 0xac235cc1, 0xe03346b3, 0x1ff34885 };
+   word32 splitmix[4] = { 0x7b1dcdaf, 0xe220a839, 0xa1b965f4, 0x6e789e6a };
+   int i;
+
+   /* full state seeding, from SplitMix64 (seed 0) */
+   srand32_r(&state, 0);
+   ASSERT_CMP(state.s128, splitmix, sizeof(splitmix));
+
+   /* jump and long jump, to known states */
+   memcpy(state.s128, seed, sizeof(seed));
+   rand32_jump(&state);
+   ASSERT_CMP(state.s128, jump, sizeof(jump));
+   memcpy(state.s128, seed, sizeof(seed));
+   rand32_long_jump(&state);
+   ASSERT_CMP(state.s128, long_jump, sizeof(long_jump));
+   /* jump commutes with generation */
+   memcpy(state.s128, seed, sizeof(seed));
+   other = state;
+   rand32_r(&state);
+   rand32_jump(&state);
+   rand32_jump(&other);
+   rand32_r(&other);
+   ASSERT_CMP(state.s128, other.s128, sizeof(state.s128));
+
+   /* split; each stream is a jump from the last, as is final state */
+   srand32_r(&state, 1);
+   other = state;
+   rand32_split(&state, streams, STREAMS);
+   for (i = 0; i < STREAMS; i++) {
+      ASSERT_CMP(streams[i].s128, other.s128, sizeof(other.s128));
+      rand32_jump(&other);
+   }
+   ASSERT_CMP(state.s128, other.s128, sizeof(other.s128));
+   ASSERT_NE(rand32_r(&streams[0]), rand32_r(&streams[1]));
+}
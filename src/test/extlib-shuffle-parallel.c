@@ -0,0 +1,117 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "exterrno.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define COUNT     (1 << 20)
+#define BIGSIZE   (SHUFFLE_BLOCK / 8)
+#define BIGCOUNT  24
+#define TRIALS    12000
+/* chi-square bound, 23 degrees of freedom (p ~ 1e-6) */
+#define CHISQMAX  72
+#define HUGESIZE  (SHUFFLE_BLOCK + (SHUFFLE_BLOCK / 4))
+#define HUGECOUNT 3
+
+static int comp(const void *a, const void *b)
+{
+   const word32 x = *((const word32 *) a);
+   const word32 y = *((const word32 *) b);
+
+   return (x > y) - (x < y);
+}
+
+int main()
+{  /* check; shuffle_parallel() permutations, determinism and uniformity */
+   static unsigned char big[BIGCOUNT * BIGSIZE];
+   static word32 list[COUNT], list2[COUNT];
+   unsigned char *huge;
+   word32 first[BIGCOUNT] = { 0 }, last[BIGCOUNT] = { 0 };
+   RANDSTATE state, copy;
+   long chisq[2], diff;
+   size_t i, moved;
+   word32 id;
+   int threads;
+
+   /* FUNCTION TESTS */
+
+   srand32_r(&state, 42);
+   for (threads = 0; threads < 4; threads++) {
+      for (i = 0; i < COUNT; i++) list[i] = list2[i] = (word32) i;
+      copy = state;
+      ASSERT_EQ(shuffle_parallel(&state, list, sizeof(list[0]), COUNT,
+         threads), 0);
+      ASSERT_EQ(shuffle_parallel(&copy, list2, sizeof(list2[0]), COUNT,
+         threads), 0);
+      /* deterministic, and state is advanced */
+      ASSERT_CMP(list, list2, sizeof(list));
+      ASSERT_CMP(&state, &copy, sizeof(state));
+      ASSERT_EQ(shuffle_parallel(&copy, list2, sizeof(list2[0]), COUNT,
+         threads), 0);
+      ASSERT_NE(memcmp(list, list2, sizeof(list)), 0);
+      /* every element is moved, and remains present */
+      for (moved = i = 0; i < COUNT; i++) if (list[i] != i) moved++;
+      ASSERT_GT(moved, COUNT - 100);
+      qsort(list, COUNT, sizeof(list[0]), comp);
+      for (i = 0; i < COUNT; i++) ASSERT_EQ(list[i], i);
+   }
+
+   /* first and last elements of a multi-bucket list land uniformly */
+   for (i = 0; i < (size_t) TRIALS; i++) {
+      for (id = 0; id < BIGCOUNT; id++) put32(&big[id * BIGSIZE], id);
+      ASSERT_EQ(shuffle_parallel(&state, big, BIGSIZE, BIGCOUNT, 2), 0);
+      for (id = 0; id < BIGCOUNT; id++) {
+         if (get32(&big[id * BIGSIZE]) == 0) first[id]++;
+         if (get32(&big[id * BIGSIZE]) == BIGCOUNT - 1) last[id]++;
+      }
+   }
+   /* chi-square statistic, scaled by expected count per position */
+   for (chisq[0] = chisq[1] = id = 0; id < BIGCOUNT; id++) {
+      diff = (long) first[id] - (TRIALS / BIGCOUNT);
+      chisq[0] += diff * diff;
+      diff = (long) last[id] - (TRIALS / BIGCOUNT);
+      chisq[1] += diff * diff;
+   }
+   ASSERT_LT(chisq[0], CHISQMAX * (TRIALS / BIGCOUNT));
+   ASSERT_LT(chisq[1], CHISQMAX * (TRIALS / BIGCOUNT));
+
+   /* elements larger than a bucket are one per bucket */
+   ASSERT_NE((huge = malloc(HUGECOUNT * HUGESIZE)), NULL);
+   for (id = 0; id < HUGECOUNT; id++) {
+      memset(&huge[id * HUGESIZE], (int) id, HUGESIZE);
+   }
+   ASSERT_EQ(shuffle_parallel(&state, huge, HUGESIZE, HUGECOUNT, 2), 0);
+   for (moved = id = 0; id < HUGECOUNT; id++) {
+      ASSERT_EQ(huge[id * HUGESIZE], huge[(id + 1) * HUGESIZE - 1]);
+      moved |= (size_t) 1 << huge[id * HUGESIZE];
+   }
+   ASSERT_EQ(moved, (1 << HUGECOUNT) - 1);
+   free(huge);
+
+   /* small lists are shuffled in place, as shuffle_r() */
+   for (i = 0; i < 100; i++) list[i] = list2[i] = (word32) i;
+   copy = state;
+   ASSERT_EQ(shuffle_parallel(&state, list, sizeof(list[0]), 100, 4), 0);
+   shuffle_r(&copy, list2, sizeof(list2[0]), 100);
+   ASSERT_CMP(list, list2, 100 * sizeof(list[0]));
+
+   /* FAILURE TESTS */
+
+   set_errno(0);
+   ASSERT_NE(shuffle_parallel(NULL, list, sizeof(list[0]), COUNT, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(shuffle_parallel(&state, NULL, sizeof(list[0]), COUNT, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(shuffle_parallel(&state, list, 0, COUNT, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(shuffle_parallel(&state, list, sizeof(list[0]), COUNT, -1), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(shuffle_parallel(&state, list, 16, ((size_t) -1) / 8, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+}
@@ -0,0 +1,77 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLES   300000
+#define COUNT     100000
+
+static int comp(const void *a, const void *b)
+{
+   const word32 x = *((const word32 *) a);
+   const word32 y = *((const word32 *) b);
+
+   return (x > y) - (x < y);
+}
+
+int main()
+{  /* check; unbiased bounded PRNG's and shuffle_r() of large lists */
+   RANDSTATE state, copy;
+   static word32 list[COUNT], list2[COUNT];
+   unsigned long long bound64, r64;
+   word32 bound, r, low;
+   size_t i, moved;
+
+   /* FUNCTION TESTS */
+
+   srand32_r(&state, 123);
+   /* results are within bound, including edge bounds */
+   ASSERT_EQ(rand32_bound_r(&state, 0), 0);
+   ASSERT_EQ(rand32_bound_r(&state, 1), 0);
+   ASSERT_EQ(rand64_bound_r(&state, 0), 0);
+   ASSERT_EQ(rand64_bound_r(&state, 1), 0);
+   for (i = 0; i < 10000; i++) {
+      bound = rand32_r(&state) | 1;
+      ASSERT_LT(rand32_bound_r(&state, bound), bound);
+      bound64 = ((unsigned long long) bound << 31) + 3;
+      ASSERT_LT(rand64_bound_r(&state, bound64), bound64);
+   }
+   ASSERT_LE(rand32_bound_r(&state, WORD32_C(0xffffffff)), 0xfffffffe);
+
+   /* a bound of 3 * 2^30 is unbiased; modulo would place half of all
+    * results in the lowest third of the range */
+   bound = WORD32_C(3) << 30;
+   for (low = 0, i = 0; i < SAMPLES; i++) {
+      r = rand32_bound_r(&state, bound);
+      if (r < (WORD32_C(1) << 30)) low++;
+   }
+   ASSERT_LT2(SAMPLES / 3 - SAMPLES / 100, low, SAMPLES / 3 + SAMPLES / 100);
+   bound64 = 3ULL << 62;
+   for (low = 0, i = 0; i < SAMPLES; i++) {
+      r64 = rand64_bound_r(&state, bound64);
+      if (r64 < (1ULL << 62)) low++;
+   }
+   ASSERT_LT2(SAMPLES / 3 - SAMPLES / 100, low, SAMPLES / 3 + SAMPLES / 100);
+
+   /* shuffle beyond 65536 elements is a deterministic permutation */
+   for (i = 0; i < COUNT; i++) list[i] = list2[i] = (word32) i;
+   copy = state;
+   shuffle_r(&state, list, sizeof(list[0]), COUNT);
+   shuffle_r(&copy, list2, sizeof(list2[0]), COUNT);
+   ASSERT_CMP(list, list2, sizeof(list));
+   for (moved = i = 0; i < COUNT; i++) if (list[i] != i) moved++;
+   ASSERT_GT(moved, COUNT - 100);
+   /* elements beyond 65536 reach the front of the list */
+   for (r = 0, i = 0; i < COUNT / 4; i++) if (list[i] > 65536) r++;
+   ASSERT_GT(r, 0);
+   qsort(list, COUNT, sizeof(list[0]), comp);
+   for (i = 0; i < COUNT; i++) ASSERT_EQ(list[i], i);
+
+   /* lists < 2 are unchanged, and do not advance state */
+   copy = state;
+   shuffle_r(&state, list, sizeof(list[0]), 1);
+   ASSERT_CMP(&state, &copy, sizeof(state));
+   ASSERT_EQ(list[0], 0);
+}
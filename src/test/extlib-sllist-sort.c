@@ -0,0 +1,67 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "exterrno.h"
+
+#define COUNT  1000
+
+typedef struct {
+   int key;
+   int seq;
+} ITEM;
+
+int comp(const void *a, const void *b)
+{
+   return ((const ITEM *) a)->key - ((const ITEM *) b)->key;
+}
+
+int main()
+{  /* check; operation and failures of SLLIST sort and split */
+   SLLIST list = { 0 }, list2 = { 0 };
+   SLNODE *np;
+   ITEM *a, *b;
+   int i;
+
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_NE((np = slnode_create(sizeof(ITEM))), NULL);
+      ((ITEM *) np->data)->key = (int) (rand16() % 64);
+      ((ITEM *) np->data)->seq = COUNT - i;
+      ASSERT_EQ(slnode_push(np, &list), 0);
+   }
+
+   /* FUNCTION TESTS */
+
+   /* stable sort; pushed nodes are in (ascending) seq order */
+   ASSERT_EQ(sllist_sort(&list, comp), 0);
+   ASSERT_EQ(list.count, COUNT);
+   for (i = 1, np = list.next; np->next; np = np->next, i++) {
+      a = (ITEM *) np->data;
+      b = (ITEM *) np->next->data;
+      ASSERT_LE(a->key, b->key);
+      if (a->key == b->key) ASSERT_LT(a->seq, b->seq);
+   }
+   ASSERT_EQ(i, COUNT);
+   /* split after a middle node */
+   for (np = list.next, i = 1; i < COUNT / 4; i++) np = np->next;
+   ASSERT_EQ(sllist_split(&list, np, &list2), 0);
+   ASSERT_EQ(np->next, NULL);
+   ASSERT_EQ(list.count, COUNT / 4);
+   ASSERT_EQ(list2.count, COUNT - (COUNT / 4));
+
+   /* FAILURE TESTS */
+
+   set_errno(0);
+   ASSERT_NE(sllist_split(&list, list.next, &list2), 0);
+   ASSERT_EQ(errno, ENOLINK);
+   set_errno(0);
+   ASSERT_NE(sllist_sort(NULL, comp), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(sllist_split(&list, NULL, &list2), 0);
+   ASSERT_EQ(errno, EINVAL);
+
+   /* cleanup */
+   while ((np = slnode_pop(&list))) slnode_destroy(np);
+   while ((np = slnode_pop(&list2))) slnode_destroy(np);
+}
@@ -0,0 +1,135 @@
+
+#include "_assert.h"
+#include "extlib.h"
+
+#include "exterrno.h"
+#include "extio.h"
+#include <string.h>
+
+#define COUNT  1000
+
+int comp(const void *a, const void *b)
+{
+   return memcmp(a, b, sizeof(word32));
+}
+
+int main()
+{  /* check; operation and failures of VECTOR operation */
+   word32 list[COUNT], borrowed[4] = { 1, 2, 3, 4 };
+   word32 value, *vp;
+   VECTOR vec;
+   size_t i;
+   void *buf;
+
+   for (i = 0; i < COUNT; i++) put32(&list[i], (word32) ((i * 7919) % COUNT));
+
+   /* FUNCTION TESTS */
+
+   /* append one at a time, with geometric growth */
+   ASSERT_EQ(vector_init(&vec, sizeof(word32), 0), 0);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_EQ(vector_append(&vec, &list[i], 1), 0);
+      ASSERT_GE(vec.capacity, vec.count);
+      ASSERT_LT(vec.capacity, vec.count * 2 + 16);
+   }
+   ASSERT_EQ(vec.count, COUNT);
+   ASSERT_CMP(vec.data, list, sizeof(list));
+   ASSERT_EQ(vector_get(&vec, COUNT), NULL);
+   ASSERT_NE((vp = vector_get(&vec, 1)), NULL);
+   ASSERT_EQ(*vp, list[1]);
+   /* bulk append, and zero append */
+   ASSERT_EQ(vector_append(&vec, list, COUNT), 0);
+   ASSERT_EQ(vector_append(&vec, NULL, 1), 0);
+   ASSERT_EQ(vec.count, COUNT * 2 + 1);
+   ASSERT_CMP(vector_get(&vec, COUNT), list, sizeof(list));
+   ASSERT_EQ(*((word32 *) vector_get(&vec, COUNT * 2)), 0);
+   /* resize smaller, then larger (zero filled) */
+   ASSERT_EQ(vector_resize(&vec, COUNT), 0);
+   ASSERT_EQ(vector_resize(&vec, COUNT + 1), 0);
+   ASSERT_EQ(*((word32 *) vector_get(&vec, COUNT)), 0);
+   ASSERT_EQ(vector_resize(&vec, COUNT), 0);
+   /* sort and search, in place */
+   vector_sort(&vec, comp);
+   for (i = 1; i < COUNT; i++) {
+      ASSERT_LE(comp(vector_get(&vec, i - 1), vector_get(&vec, i)), 0);
+   }
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_NE((vp = vector_search(&vec, &list[i], sizeof(word32))), NULL);
+      ASSERT_EQ(*vp, list[i]);
+   }
+   put32(&value, COUNT);
+   ASSERT_EQ(vector_search(&vec, &value, sizeof(word32)), NULL);
+   /* shuffle retains elements */
+   vector_shuffle(&vec);
+   vector_sort(&vec, comp);
+   for (i = 0; i < COUNT; i++) {
+      ASSERT_NE(vector_search(&vec, &list[i], sizeof(word32)), NULL);
+   }
+   vector_destroy(&vec);
+   ASSERT_EQ(vec.data, NULL);
+
+   /* adopt a borrowed buffer; growth copies, leaving buffer intact */
+   ASSERT_EQ(vector_init(&vec, sizeof(word32), 0), 0);
+   ASSERT_EQ(vector_adopt(&vec, borrowed, sizeof(word32), 2, 4,
+      VECTOR_BORROWED), 0);
+   ASSERT_EQ(vec.data, (void *) borrowed);
+   ASSERT_EQ(vector_append(&vec, list, 2), 0);
+   ASSERT_EQ(vec.data, (void *) borrowed);
+   ASSERT_EQ(vector_append(&vec, list, 1), 0);
+   ASSERT_NE(vec.data, (void *) borrowed);
+   ASSERT_EQ(vec.owner, VECTOR_OWNED);
+   ASSERT_EQ(borrowed[0], 1);
+   ASSERT_EQ(borrowed[2], list[0]);
+   ASSERT_CMP(vec.data, borrowed, sizeof(borrowed));
+   vector_destroy(&vec);
+   /* adopt an owned buffer */
+   ASSERT_NE((buf = malloc(sizeof(list))), NULL);
+   memcpy(buf, list, sizeof(list));
+   ASSERT_EQ(vector_init(&vec, sizeof(word32), 0), 0);
+   ASSERT_EQ(vector_adopt(&vec, buf, sizeof(word32), COUNT, COUNT,
+      VECTOR_OWNED), 0);
+   vector_sort(&vec, comp);
+   ASSERT_NE(vector_search(&vec, &list[0], sizeof(word32)), NULL);
+   ASSERT_EQ(vector_append(&vec, list, COUNT), 0);
+   vector_destroy(&vec);
+
+#ifndef _WIN32
+   /* adopt a mapped region */
+   buf = mmap(NULL, sizeof(list), PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   ASSERT_NE(buf, MAP_FAILED);
+   memcpy(buf, list, sizeof(list));
+   ASSERT_EQ(vector_init(&vec, sizeof(word32), 0), 0);
+   ASSERT_EQ(vector_adopt(&vec, buf, sizeof(word32), COUNT, COUNT,
+      VECTOR_MAPPED), 0);
+   vector_sort(&vec, comp);
+   ASSERT_EQ(vec.data, buf);
+   ASSERT_EQ(vector_append(&vec, list, 1), 0);
+   ASSERT_NE(vec.data, buf);
+   vector_destroy(&vec);
+
+#endif
+
+   /* FAILURE TESTS */
+
+   ASSERT_EQ(vector_init(&vec, sizeof(word32), 0), 0);
+   set_errno(0);
+   ASSERT_NE(vector_reserve(&vec, (size_t) -1), 0);
+   ASSERT_EQ(errno, ENOMEM);
+   set_errno(0);
+   ASSERT_NE(vector_adopt(&vec, NULL, sizeof(word32), 0, 4, VECTOR_OWNED), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(vector_adopt(&vec, list, sizeof(word32), 5, 4, VECTOR_OWNED), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(vector_adopt(&vec, list, sizeof(word32), 0, 4, -1), 0);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_EQ(vector_search(&vec, list, sizeof(word32)), NULL);
+   vector_destroy(&vec);
+   set_errno(0);
+   ASSERT_NE(vector_init(&vec, 0, 0), 0);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_NE(vector_append(NULL, list, 1), 0);
+   ASSERT_NE(vector_init(NULL, sizeof(word32), 0), 0);
+}
@@ -0,0 +1,57 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "extlib.h"
+#include <string.h>
+
+#define COUNT  1003
+
+int main()
+{  /* check; cmp256_batch() against cmp256(), for every kernel */
+   static const unsigned overrides[] = {
+      0, CPU_FEATURE_X64, CPU_FEATURE_X64 | CPU_FEATURE_SSE2,
+      CPU_FEATURE_ALL
+   };
+   static word8 values[COUNT + 1][32];
+   word8 mask[(COUNT + 7) / 8 + 1], target[32];
+   size_t i, n, o, expect;
+
+   /* random values, and values differing from target in single words,
+    * at every (sign bit significant) position of every word */
+   srand32(1);
+   for (i = 0; i < 32; i++) target[i] = (word8) rand32();
+   for (i = 0; i < COUNT; i++) {
+      if (i & 1) {
+         for (n = 0; n < 32; n++) values[i][n] = (word8) rand32();
+      } else {
+         memcpy(values[i], target, 32);
+         values[i][(i >> 1) & 31] ^= (word8) (1 << ((i >> 6) & 7));
+      }
+   }
+   memcpy(values[COUNT / 2], target, 32);
+
+   /* FUNCTION TESTS */
+
+   for (o = 0; o < sizeof(overrides) / sizeof(overrides[0]); o++) {
+      extmath_dispatch(overrides[o]);
+      /* every length, including partial mask bytes */
+      for (n = 0; n <= COUNT; n += (n < 64) ? 1 : 97) {
+         memset(mask, 0xff, sizeof(mask));
+         for (expect = i = 0; i < n; i++) {
+            expect += (cmp256(values[i], target) < 0);
+         }
+         ASSERT_EQ(cmp256_batch(values, n, target, mask), expect);
+         for (i = 0; i < n; i++) {
+            ASSERT_EQ(((mask[i >> 3] >> (i & 7)) & 1),
+               (cmp256(values[i], target) < 0));
+         }
+         if (n & 7) ASSERT_EQ((mask[n >> 3] >> (n & 7)), 0);
+         ASSERT_EQ(mask[(n + 7) / 8], 0xff);
+      }
+      /* no value is less than itself */
+      ASSERT_EQ(cmp256_batch(target, 1, target, mask), 0);
+      ASSERT_EQ(mask[0], 0);
+   }
+   extmath_dispatch(CPU_FEATURE_ALL);
+}
@@ -0,0 +1,75 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "extlib.h"
+#include <string.h>
+
+int main()
+{  /* check; CPU features and kernel selection of dispatched functions */
+   static const unsigned overrides[] = {
+      0, CPU_FEATURE_X64, CPU_FEATURE_X64 | CPU_FEATURE_BMI2,
+      CPU_FEATURE_X64 | CPU_FEATURE_ADX,
+      CPU_FEATURE_X64 | CPU_FEATURE_BMI2 | CPU_FEATURE_ADX, CPU_FEATURE_ALL
+   };
+   word8 buf[100] = { 0 };
+   u256 a, b, lo, hi, elo, ehi, sum, esum;
+   u256 x, y, xlo, xhi;
+   unsigned features, used;
+   int ecarry, i, j;
+   size_t n;
+
+   /* detected features are stable, and include 64-bit where available */
+   features = cpu_features();
+   ASSERT_EQ(cpu_features(), features);
+#ifdef HAS_64BIT
+   ASSERT_NE((features & CPU_FEATURE_X64), 0);
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+   ASSERT_NE((features & CPU_FEATURE_SSE2), 0);
+#endif
+   /* automatic selection uses the best supported kernels */
+   used = extmath_features();
+   ASSERT_EQ((used & ~features), 0);
+   ASSERT_EQ(extmath_dispatch(CPU_FEATURE_ALL), used);
+
+   /* reference results, from forced 32-bit kernels */
+   srand32(1);
+   for (i = 0; i < 8; i++) a.w[i] = rand32(), b.w[i] = rand32();
+   u256_mul_x86(&a, &b, &elo, &ehi);
+   ecarry = multi_add_x86(&a, &b, &esum, 31);
+
+   for (n = 0; n < sizeof(overrides) / sizeof(overrides[0]); n++) {
+      /* selection is limited to override and host features */
+      used = extmath_dispatch(overrides[n]);
+      ASSERT_EQ((used & ~(overrides[n] & features)), 0);
+      ASSERT_EQ(extmath_features(), used);
+      /* dispatched functions produce identical results */
+      ASSERT_EQ(u256_mul(&a, &b, &lo, &hi), 1);
+      ASSERT_CMP(&lo, &elo, sizeof(lo));
+      ASSERT_CMP(&hi, &ehi, sizeof(hi));
+      ASSERT_EQ(multi_add(&a, &b, &sum, 31), ecarry);
+      ASSERT_CMP(&sum, &esum, 31);
+      ASSERT_EQ(multi_sub(&sum, &b, &sum, 31), ecarry);
+      ASSERT_CMP(&sum, &a, 31);
+      ASSERT_EQ(cmp256(&a, &b), cmp256_x86(&a, &b));
+      ASSERT_EQ(cmp256(&a, &a), 0);
+      ASSERT_EQ(iszero(buf, sizeof(buf)), 1);
+      buf[sizeof(buf) - 1] = 1;
+      ASSERT_EQ(iszero(buf, sizeof(buf)), 0);
+      buf[sizeof(buf) - 1] = 0;
+      /* products with full carry propagation, and of random values */
+      for (j = 0; j < 256; j++) {
+         for (i = 0; i < 8; i++) {
+            x.w[i] = j ? rand32() : WORD32_C(0xffffffff);
+            y.w[i] = j ? rand32() : WORD32_C(0xffffffff);
+         }
+         u256_mul_x86(&x, &y, &xlo, &xhi);
+         ASSERT_EQ(u256_mul(&x, &y, &x, &y), 1);
+         ASSERT_CMP(&x, &xlo, sizeof(x));
+         ASSERT_CMP(&y, &xhi, sizeof(y));
+      }
+   }
+   /* generic 32-bit kernels use no features */
+   ASSERT_EQ(extmath_dispatch(0), 0);
+}
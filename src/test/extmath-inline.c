@@ -0,0 +1,110 @@
+
+/* header-only (static inline) forms, see EXTC_INLINE */
+#ifndef EXTC_INLINE
+   #define EXTC_INLINE
+#endif
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "_extmath-inline.h"
+
+#include "extlib.h"
+#include <string.h>
+
+#define RANDOMS   10000
+
+/* library (out-of-line) forms, for comparison */
+#ifdef HAS_64BIT
+   #define LIB(fn)   fn##_x64
+#else
+   #define LIB(fn)   fn##_x86
+#endif
+
+int main()
+{  /* check; inline forms against library forms, at any alignment */
+   word64 a[4], b[4], c[4], d[4];
+   word8 buff[128 + 8], ref[128 + 8], *bp;
+   word32 w32;
+   word16 w16;
+   int i, j, n;
+
+   srand32(1);
+
+   /* FUNCTION TESTS */
+
+   /* byte accessors, at every alignment, against library forms */
+   for (i = 0; i < 8; i++) {
+      memset(buff, 0, sizeof(buff));
+      memset(ref, 0, sizeof(ref));
+      bp = buff + i;
+      w32 = rand32();
+      w16 = (word16) w32;
+      put16(bp, w16);
+      lib_put16(ref + i, w16);
+      ASSERT_CMP(buff, ref, sizeof(buff));
+      ASSERT_EQ(get16(bp), w16);
+      ASSERT_EQ(get16(bp), lib_get16(bp));
+      put32(bp, w32);
+      lib_put32(ref + i, w32);
+      ASSERT_CMP(buff, ref, sizeof(buff));
+      ASSERT_EQ(get32(bp), w32);
+      ASSERT_EQ(get32(bp), lib_get32(bp));
+      a[0] = ((word64) rand32() << 32) | rand32();
+      put64(bp, a);
+      lib_put64(ref + i, a);
+      ASSERT_CMP(buff, ref, sizeof(buff));
+      put64(b, bp);
+      ASSERT_EQ(b[0], a[0]);
+      ASSERT_EQ(iszero(buff, i), lib_iszero(buff, i));
+      ASSERT_EQ(iszero(bp + 8, 64 - i), 1);
+   }
+
+   /* 64-bit math, including carries and equal values */
+   for (i = 0; i < RANDOMS; i++) {
+      for (j = 0; j < 4; j++) a[j] = ((word64) rand32() << 32) | rand32();
+      for (j = 0; j < 4; j++) b[j] = ((word64) rand32() << 32) | rand32();
+      if (i & 1) b[3] = a[3];
+      if (i & 2) b[2] = a[2];
+      if ((i & 15) == 0) memcpy(b, a, sizeof(a));
+      ASSERT_EQ(add64(a, b, c), LIB(add64)(a, b, d));
+      ASSERT_EQ(c[0], d[0]);
+      ASSERT_EQ(sub64(a, b, c), LIB(sub64)(a, b, d));
+      ASSERT_EQ(c[0], d[0]);
+      ASSERT_EQ(cmp64(a, b), LIB(cmp64)(a, b));
+      ASSERT_EQ(cmp256(a, b), LIB(cmp256)(a, b));
+      ASSERT_EQ(cmp256(b, a), LIB(cmp256)(b, a));
+      c[0] = d[0] = a[0];
+      negate64(c);
+      LIB(negate64)(d);
+      ASSERT_EQ(c[0], d[0]);
+      c[0] = d[0] = a[0];
+      shiftr64(c);
+      LIB(shiftr64)(d);
+      ASSERT_EQ(c[0], d[0]);
+   }
+   /* unaligned operands */
+   a[0] = ~((word64) 0);
+   b[0] = 1;
+   memcpy(buff + 1, a, 8);
+   memcpy(buff + 11, b, 8);
+   ASSERT_EQ(add64(buff + 1, buff + 11, buff + 21), 1);
+   ASSERT_EQ(iszero(buff + 21, 8), 1);
+   ASSERT_EQ(sub64(buff + 21, buff + 11, buff + 21), 1);
+   ASSERT_CMP(buff + 21, a, 8);
+   ASSERT_EQ(cmp64(buff + 1, buff + 11), 1);
+
+   /* zero checks, of every length, with a single non-zero byte */
+   for (n = 0; n <= 128; n++) {
+      memset(buff, 0, sizeof(buff));
+      ASSERT_EQ(iszero(buff + 1, n), 1);
+      for (j = 0; j < n; j++) {
+         buff[1 + j] = 0x80;
+         ASSERT_EQ(iszero(buff + 1, n), 0);
+         ASSERT_EQ(lib_iszero(buff + 1, n), 0);
+         buff[1 + j] = 0;
+      }
+      buff[1 + n] = 1;
+      ASSERT_EQ(iszero(buff + 1, n), 1);
+   }
+}
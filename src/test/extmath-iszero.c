@@ -5,8 +5,15 @@
 
 int main()
 {  /* check iszero() appropriately returns falsey and truthy values */
+   static const unsigned overrides[] = {
+      0, CPU_FEATURE_X64, CPU_FEATURE_X64 | CPU_FEATURE_SSE2,
+      CPU_FEATURE_ALL
+   };
    unsigned char nonzero[9] = { 0, 0x1, 0x3, 0x7, 0xf, 0x1f, 0x3f, 0x7f, 0xff };
    unsigned char zero[9] = { 0 };
+   unsigned char buf[256] = { 0 };
+   int len, off, pos;
+   size_t n;
 
    /* test ext function */
    ASSERT_EQ(iszero(nonzero, 9), 0);
@@ -17,4 +24,25 @@ int main()
    /* test x86 function */
    ASSERT_EQ(iszero_x86(nonzero, 9), 0);
    ASSERT_EQ(iszero_x86(zero, 9), 1);
+
+   /* test dispatched (SIMD) kernels, across lengths and alignments */
+   for (n = 0; n < sizeof(overrides) / sizeof(overrides[0]); n++) {
+      extmath_dispatch(overrides[n]);
+      for (off = 0; off < 4; off++) {
+         for (len = 0; len <= 200; len++) {
+            ASSERT_EQ(iszero(buf + off, len), 1);
+            for (pos = 0; pos < len; pos++) {
+               buf[off + pos] = 0x80;
+               ASSERT_EQ(iszero(buf + off, len), 0);
+               buf[off + pos] = 0;
+            }
+            /* bytes outside of buffer are ignored */
+            buf[off + len] = 1;
+            if (off) buf[off - 1] = 1;
+            ASSERT_EQ(iszero(buf + off, len), 1);
+            buf[off + len] = 0;
+            if (off) buf[off - 1] = 0;
+         }
+      }
+   }
 }
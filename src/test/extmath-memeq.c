@@ -0,0 +1,30 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+int main()
+{  /* check; memeq16/32/64() match memcmp() equality, at any alignment */
+   word8 a[72], b[72];
+   int off, pos, bit;
+
+   srand32(1);
+   for (pos = 0; pos < 72; pos++) a[pos] = b[pos] = (word8) rand32();
+
+   for (off = 0; off < 8; off++) {
+      ASSERT_EQ(memeq16(a + off, b + off), 1);
+      ASSERT_EQ(memeq32(a + off, b + off), 1);
+      ASSERT_EQ(memeq64(a + off, b + off), 1);
+      /* a single differing bit, anywhere in the key */
+      for (pos = 0; pos < 64; pos++) {
+         for (bit = 0; bit < 8; bit++) {
+            b[off + pos] ^= (word8) (1 << bit);
+            ASSERT_EQ(memeq16(a + off, b + off), (pos >= 16));
+            ASSERT_EQ(memeq32(a + off, b + off), (pos >= 32));
+            ASSERT_EQ(memeq64(a + off, b + off), 0);
+            b[off + pos] ^= (word8) (1 << bit);
+         }
+      }
+   }
+}
@@ -0,0 +1,60 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "extlib.h"
+
+typedef int (*MULT64_FULL)(const void *, const void *, void *, void *);
+
+int main()
+{  /* check; full 128-bit product and overflow, of each variant */
+   MULT64_FULL fn[] = {
+      mult64_full,
+#ifdef HAS_64BIT
+      mult64_full_x64,
+#endif
+      mult64_full_x86
+   };
+   word32 numA[2] = { WORD32_C(0xc0c0aace) };
+   word32 numB[2] = { WORD32_C(0xdeadbeef), WORD32_C(0xcafef00d) };
+   word32 ones[2] = { WORD32_C(0xffffffff), WORD32_C(0xffffffff) };
+   word32 expAB[4] = {
+      WORD32_C(0x03da5a52), WORD32_C(0x15f7b28b),
+      WORD32_C(0x98d7faaf), WORD32_C(0)
+   };
+   word32 expOnes[4] = {
+      WORD32_C(0x00000001), WORD32_C(0x00000000),
+      WORD32_C(0xfffffffe), WORD32_C(0xffffffff)
+   };
+   word32 a[2], b[2], lo[2], hi[2], elo[2], ehi[2];
+   size_t n;
+   int i;
+
+   for (n = 0; n < sizeof(fn) / sizeof(fn[0]); n++) {
+      /* FUNCTION TESTS */
+      ASSERT_EQ(fn[n](numA, numA, lo, hi), 0);
+      ASSERT_EQ((hi[0] | hi[1]), 0);
+      ASSERT_EQ(fn[n](numA, numB, lo, hi), 1);
+      ASSERT_CMP(lo, expAB, 8);
+      ASSERT_CMP(hi, &expAB[2], 8);
+      ASSERT_EQ(fn[n](ones, ones, lo, hi), 1);
+      ASSERT_CMP(lo, expOnes, 8);
+      ASSERT_CMP(hi, &expOnes[2], 8);
+      /* high product is optional, and operands may alias results */
+      a[0] = numB[0], a[1] = numB[1];
+      ASSERT_EQ(fn[n](a, numA, a, NULL), 1);
+      ASSERT_CMP(a, expAB, 8);
+      /* random operands, against the forced 32-bit variant */
+      srand32(1);
+      for (i = 0; i < 10000; i++) {
+         a[0] = rand32(), a[1] = (i & 1) ? rand32() : 0;
+         b[0] = rand32(), b[1] = (i & 2) ? rand32() : 0;
+         ASSERT_EQ(fn[n](a, b, lo, hi), mult64_full_x86(a, b, elo, ehi));
+         ASSERT_CMP(lo, elo, 8);
+         ASSERT_CMP(hi, ehi, 8);
+         /* low product and overflow agree with mult64() */
+         ASSERT_EQ(mult64(a, b, elo), ((hi[0] | hi[1]) != 0));
+         ASSERT_CMP(lo, elo, 8);
+      }
+   }
+}
@@ -3,6 +3,20 @@
 #include "../extint.h"
 #include "../extmath.h"
 
+/* reference byte loop of multi_add(), for odd lengths */
+static int ref_add(const word8 *a, const word8 *b, word8 *c, int len)
+{
+   int t, carry = 0;
+
+   for( ; len > 0; a++, b++, c++, len--) {
+      t = *a + *b + carry;
+      carry = (t >> 8) & 1;
+      *c = (word8) t;
+   }
+
+   return carry;
+}
+
 int main()
 {  /* check; returned carry, and final result */
    word32 numA[8] = {
@@ -18,8 +32,24 @@ int main()
       0x8ca9d6bc, 0x9d784cee, 0x8bfede0e, 0x9f6e69be
    };
    word32 result[8] = { 0 };
+   word32 result2[8];
+   int len;
 
    ASSERT_EQ(multi_add(&result, &numB, &result, 32), 0);
    ASSERT_EQ(multi_add(&numA, &numB, &result, 32), 1);
    ASSERT_CMP(result, expect, 32);
+   /* test x64 and x86 functions */
+   ASSERT_EQ(multi_add_x64(&numB, &numA, &result2, 32), 1);
+   ASSERT_CMP(result2, expect, 32);
+   ASSERT_EQ(multi_add_x86(&numB, &numA, &result2, 32), 1);
+   ASSERT_CMP(result2, expect, 32);
+   /* odd lengths match the reference byte loop */
+   for (len = 0; len <= 32; len++) {
+      ASSERT_EQ(multi_add_x64(&numA, &numB, &result, len),
+         ref_add((word8 *) numA, (word8 *) numB, (word8 *) result2, len));
+      ASSERT_CMP(result, result2, len);
+      ASSERT_EQ(multi_add_x86(&numB, &numA, &result, len),
+         ref_add((word8 *) numB, (word8 *) numA, (word8 *) result2, len));
+      ASSERT_CMP(result, result2, len);
+   }
 }
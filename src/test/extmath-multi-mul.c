@@ -0,0 +1,92 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "exterrno.h"
+#include "extlib.h"
+#include <string.h>
+
+#define MAXLEN 1200
+
+/* reference byte-wise schoolbook multiplication */
+void ref_mul(const word8 *a, int alen, const word8 *b, int blen, word8 *c)
+{
+   word32 t;
+   int i, j;
+
+   memset(c, 0, (size_t) (alen + blen));
+   for (i = 0; i < alen; i++) {
+      for (t = 0, j = 0; j < blen; j++) {
+         t += (word32) a[i] * b[j] + c[i + j];
+         c[i + j] = (word8) t;
+         t >>= 8;
+      }
+      c[i + blen] = (word8) t;
+   }
+}
+
+/* fill with random bytes, or (mode 1) all ones for maximal carries */
+void fill(word8 *p, int len, int mode)
+{
+   int i;
+
+   for (i = 0; i < len; i++) p[i] = mode ? 0xff : (word8) rand32();
+}
+
+int main()
+{  /* check; multi_mul() and multi_sqr() against a reference */
+   static const int lens[] = {
+      1, 3, 7, 8, 9, 16, 31, 100, 255, 256, 257, 383, 384, 385, 600,
+      1024, 1111, MAXLEN
+   };
+   static word8 a[MAXLEN], b[MAXLEN], c[(2 * MAXLEN) + 1], e[2 * MAXLEN];
+   int alen, blen, mode;
+   size_t i, j;
+
+   srand32(1);
+   /* FUNCTION TESTS */
+   for (mode = 0; mode < 2; mode++) {
+      for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+         alen = lens[i];
+         fill(a, alen, mode);
+         /* balanced and unbalanced products, either operand longer */
+         for (j = 0; j < sizeof(lens) / sizeof(lens[0]); j++) {
+            blen = lens[j];
+            fill(b, blen, mode);
+            ref_mul(a, alen, b, blen, e);
+            memset(c, 0xaa, sizeof(c));
+            ASSERT_EQ(multi_mul(a, alen, b, blen, c), 0);
+            ASSERT_CMP(c, e, alen + blen);
+            ASSERT_EQ(c[alen + blen], 0xaa);
+         }
+         /* squares, by either function */
+         ref_mul(a, alen, a, alen, e);
+         ASSERT_EQ(multi_sqr(a, alen, c), 0);
+         ASSERT_CMP(c, e, 2 * alen);
+         memset(c, 0, sizeof(c));
+         ASSERT_EQ(multi_mul(a, alen, a, alen, c), 0);
+         ASSERT_CMP(c, e, 2 * alen);
+         /* product may overlap operands */
+         memcpy(c, a, (size_t) alen);
+         ASSERT_EQ(multi_sqr(c, alen, c), 0);
+         ASSERT_CMP(c, e, 2 * alen);
+      }
+   }
+
+   /* FAILURE TESTS */
+   set_errno(0);
+   ASSERT_NE(multi_mul(NULL, 1, b, 1, c), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(multi_mul(a, 1, b, 0, c), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(multi_mul(a, 1, b, 1, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(multi_sqr(a, -1, c), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(multi_sqr(NULL, 1, c), 0);
+   ASSERT_EQ(errno, EINVAL);
+}
@@ -0,0 +1,79 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "extlib.h"
+#include <string.h>
+
+#define MAXLEN 70
+
+/* reference bit-at-a-time shifts and scans */
+int ref_bit(const word8 *a, int len, int i)
+{
+   if (i < 0 || i >= len * 8) return 0;
+   return (a[i >> 3] >> (i & 7)) & 1;
+}
+
+void ref_shift(const word8 *a, int n, word8 *c, int len)
+{
+   int i;
+
+   memset(c, 0, (size_t) len);
+   for (i = 0; i < len * 8; i++) {
+      if (ref_bit(a, len, i - n)) c[i >> 3] |= (word8) (1 << (i & 7));
+   }
+}
+
+int main()
+{  /* check; multi-byte shifts and bit scans against a reference */
+   word8 a[MAXLEN], c[MAXLEN + 1], e[MAXLEN];
+   int len, n, i, clz, ctz, pop;
+
+   srand32(1);
+   /* FUNCTION TESTS */
+   for (len = 1; len <= MAXLEN; len++) {
+      for (i = 0; i < len; i++) a[i] = (word8) rand32();
+      for (n = 0; n <= (len * 8) + 9; n++) {
+         /* left shift, then in place */
+         ref_shift(a, n, e, len);
+         c[len] = 0xaa;
+         multi_shl(a, n, c, len);
+         ASSERT_CMP(c, e, len);
+         ASSERT_EQ(c[len], 0xaa);
+         memcpy(c, a, (size_t) len);
+         multi_shl(c, n, c, len);
+         ASSERT_CMP(c, e, len);
+         /* right shift, then in place */
+         ref_shift(a, -n, e, len);
+         multi_shr(a, n, c, len);
+         ASSERT_CMP(c, e, len);
+         ASSERT_EQ(c[len], 0xaa);
+         memcpy(c, a, (size_t) len);
+         multi_shr(c, n, c, len);
+         ASSERT_CMP(c, e, len);
+      }
+      /* bit scans of shifted (sparse) values */
+      for (n = 0; n <= len * 8; n++) {
+         memset(c, 0, sizeof(c));
+         if (n < len * 8) c[n >> 3] = (word8) (1 << (n & 7));
+         if (n + 3 < len * 8) c[(n + 3) >> 3] |= (word8) (1 << ((n + 3) & 7));
+         clz = ctz = pop = 0;
+         for (i = (len * 8) - 1; i >= 0 && !ref_bit(c, len, i); i--) clz++;
+         for (i = 0; i < len * 8 && !ref_bit(c, len, i); i++) ctz++;
+         for (i = 0; i < len * 8; i++) pop += ref_bit(c, len, i);
+         ASSERT_EQ(multi_clz(c, len), clz);
+         ASSERT_EQ(multi_ctz(c, len), ctz);
+         ASSERT_EQ(multi_popcount(c, len), pop);
+      }
+      ASSERT_EQ(multi_popcount(a, len), multi_popcount(a, len - 1) +
+         multi_popcount(&a[len - 1], 1));
+   }
+   memset(a, 0xff, sizeof(a));
+   ASSERT_EQ(multi_popcount(a, MAXLEN), MAXLEN * 8);
+   ASSERT_EQ(multi_clz(a, MAXLEN), 0);
+   ASSERT_EQ(multi_ctz(a, MAXLEN), 0);
+   /* zero length */
+   ASSERT_EQ(multi_clz(a, 0), 0);
+   ASSERT_EQ(multi_ctz(a, 0), 0);
+   ASSERT_EQ(multi_popcount(a, 0), 0);
+}
@@ -0,0 +1,129 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "exterrno.h"
+#include "extlib.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MAXLEN 300
+
+/* reference decimal conversion, by repeated division by 10 */
+void ref_dec(const word8 *a, int len, char *str)
+{
+   word8 t[MAXLEN];
+   char rev[(MAXLEN * 3) + 2];
+   int i, n = 0, r, nonzero;
+
+   memcpy(t, a, (size_t) len);
+   do {
+      for (nonzero = r = 0, i = len - 1; i >= 0; i--) {
+         r = (r << 8) | t[i];
+         t[i] = (word8) (r / 10);
+         r %= 10;
+         nonzero |= t[i];
+      }
+      rev[n++] = (char) ('0' + r);
+   } while (nonzero);
+   for (i = 0; i < n; i++) str[i] = rev[n - 1 - i];
+   str[n] = '\0';
+}
+
+int main()
+{  /* check; decimal and hexadecimal conversion, both ways */
+   static const int lens[] = { 1, 2, 7, 8, 9, 16, 31, 32, 33, 64, MAXLEN };
+   char str[(MAXLEN * 3) + 2], expect[(MAXLEN * 3) + 2];
+   word8 a[MAXLEN], c[MAXLEN + 1];
+   word64 v64;
+   size_t i;
+   int len, j, mode;
+
+   srand32(1);
+   /* FUNCTION TESTS */
+   for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+      len = lens[i];
+      for (mode = 0; mode < 4; mode++) {
+         /* random, all ones, zero, and a single (top or bottom) bit */
+         for (j = 0; j < len; j++) {
+            a[j] = mode == 0 ? (word8) rand32() : mode == 1 ? 0xff : 0;
+         }
+         if (mode == 3) a[(i & 1) ? len - 1 : 0] = 0x80;
+         ref_dec(a, len, expect);
+         ASSERT_EQ(multi_to_dec(a, len, str, sizeof(str)), (int) strlen(expect));
+         ASSERT_STR(str, expect, sizeof(str));
+         memset(c, 0xaa, sizeof(c));
+         ASSERT_EQ(multi_from_dec(str, c, len), 0);
+         ASSERT_CMP(c, a, len);
+         ASSERT_EQ(c[len], 0xaa);
+         ASSERT_GT(multi_to_hex(a, len, str, sizeof(str)), 0);
+         ASSERT_EQ(multi_from_hex(str, c, len), 0);
+         ASSERT_CMP(c, a, len);
+         ASSERT_EQ(c[len], 0xaa);
+      }
+   }
+   /* known values, against printf() */
+   v64 = WORD64_C(18446744073709551615);
+   ASSERT_EQ(multi_to_dec(&v64, 8, str, sizeof(str)), 20);
+   snprintf(expect, sizeof(expect), "%" P64u, v64);
+   ASSERT_STR(str, expect, sizeof(str));
+   v64 = WORD64_C(10000000000000000000);
+   ASSERT_EQ(multi_to_dec(&v64, 8, str, sizeof(str)), 20);
+   ASSERT_STR(str, "10000000000000000000", sizeof(str));
+   v64 = WORD64_C(0x0123456789abcdef);
+   ASSERT_EQ(multi_to_hex(&v64, 8, str, sizeof(str)), 15);
+   ASSERT_STR(str, "123456789abcdef", sizeof(str));
+   v64 = 0;
+   ASSERT_EQ(multi_to_hex(&v64, 8, str, sizeof(str)), 1);
+   ASSERT_STR(str, "0", sizeof(str));
+   ASSERT_EQ(multi_to_dec(&v64, 8, str, sizeof(str)), 1);
+   ASSERT_STR(str, "0", sizeof(str));
+   /* parsers accept leading zeros, prefixes and uppercase */
+   ASSERT_EQ(multi_from_hex("0x00000000ABCdef", &v64, 3), 0);
+   ASSERT_EQ(v64, 0xabcdef);
+   v64 = 0;
+   ASSERT_EQ(multi_from_dec("000000000000000000000000065535", &v64, 2), 0);
+   ASSERT_EQ(v64, 0xffff);
+   ASSERT_EQ(multi_from_dec("18446744073709551615", &v64, 8), 0);
+   ASSERT_EQ(v64, WORD64_C(18446744073709551615));
+
+   /* FAILURE TESTS */
+   v64 = 12345;
+   set_errno(0);
+   ASSERT_EQ(multi_to_dec(&v64, 8, str, 5), -1);
+   ASSERT_EQ(errno, ERANGE);
+   ASSERT_EQ(multi_to_dec(&v64, 8, str, 6), 5);
+   set_errno(0);
+   ASSERT_EQ(multi_to_hex(&v64, 8, str, 4), -1);
+   ASSERT_EQ(errno, ERANGE);
+   set_errno(0);
+   ASSERT_EQ(multi_to_dec(NULL, 8, str, sizeof(str)), -1);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_EQ(multi_to_hex(&v64, 0, str, sizeof(str)), -1);
+   ASSERT_EQ(errno, EINVAL);
+   /* value is unmodified on parse failure */
+   set_errno(0);
+   ASSERT_EQ(multi_from_dec("65536", &v64, 2), -1);
+   ASSERT_EQ(errno, ERANGE);
+   set_errno(0);
+   ASSERT_EQ(multi_from_dec("18446744073709551616", &v64, 8), -1);
+   ASSERT_EQ(errno, ERANGE);
+   set_errno(0);
+   ASSERT_EQ(multi_from_hex("0x10000", &v64, 2), -1);
+   ASSERT_EQ(errno, ERANGE);
+   ASSERT_EQ(v64, 12345);
+   set_errno(0);
+   ASSERT_EQ(multi_from_dec("12a", &v64, 8), -1);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_EQ(multi_from_dec("", &v64, 8), -1);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_EQ(multi_from_hex("0x", &v64, 8), -1);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_EQ(multi_from_hex("0xfg", &v64, 8), -1);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_EQ(v64, 12345);
+}
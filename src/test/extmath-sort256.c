@@ -0,0 +1,60 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "exterrno.h"
+#include "extlib.h"
+#include <string.h>
+
+#define COUNT  50000
+
+int comp(const void *a, const void *b)
+{
+   return cmp256(a, b);
+}
+
+int main()
+{  /* check; sort256() against qsort(), for varied key distributions */
+   static word8 values[COUNT][32], expect[COUNT][32];
+   size_t i, j, n;
+   int dist;
+
+   srand32(1);
+
+   /* FUNCTION TESTS */
+
+   for (dist = 0; dist < 5; dist++) {
+      for (i = 0; i < COUNT; i++) {
+         for (j = 0; j < 32; j++) values[i][j] = (word8) rand32();
+         switch (dist) {
+            /* small values; most significant limbs are zero */
+            case 1: memset(&values[i][5], 0, 27); break;
+            /* equal most significant limbs, but for a single bit */
+            case 2: memset(&values[i][8], 0xa5, 24);
+               values[i][27] ^= (word8) (i & 1); break;
+            /* few distinct values, with duplicates */
+            case 3: memset(values[i], (int) (rand32() & 3), 32); break;
+            /* values differing only in the least significant limb */
+            case 4: memset(&values[i][1], 0x5a, 31); break;
+         }
+      }
+      for (n = 0; n <= COUNT; n = (n < 130) ? n + 1 : n * 7) {
+         memcpy(expect, values, n * 32);
+         qsort(expect, n, 32, comp);
+         ASSERT_EQ(sort256(values, n), 0);
+         ASSERT_CMP(values, expect, n * 32);
+         /* sorted input */
+         ASSERT_EQ(sort256(values, n), 0);
+         ASSERT_CMP(values, expect, n * 32);
+      }
+   }
+
+   /* FAILURE TESTS */
+
+   set_errno(0);
+   ASSERT_NE(sort256(NULL, 1), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(sort256(values, (size_t) -1), 0);
+   ASSERT_EQ(errno, ENOMEM);
+}
@@ -0,0 +1,164 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "exterrno.h"
+#include "extlib.h"
+#include <string.h>
+
+#define RANDOMS   2000
+
+/* moduli; primes of secp256k1 field, curve25519 field and secp256k1
+ * group order, all ones, a 61-bit prime, and the smallest moduli */
+static const char *Moduli[] = {
+   "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+   "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed",
+   "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141",
+   "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+   "1fffffffffffffff", "3", "1"
+};
+
+/* reference modular product of @a a and @a b (both less than @a n),
+ * by shift-and-add, with modular addition and subtraction */
+static void mulmod_ref(const u256 *a, const u256 *b, const u256 *n,
+   u256 *c)
+{
+   u256 r;
+   int i;
+
+   memset(&r, 0, sizeof(r));
+   for (i = 255; i >= 0; i--) {
+      if (u256_add(&r, &r, &r) || u256_cmp(&r, n) >= 0) {
+         u256_sub(&r, n, &r);
+      }
+      if ((b->b[i >> 3] >> (i & 7)) & 1) {
+         if (u256_add(&r, a, &r) || u256_cmp(&r, n) >= 0) {
+            u256_sub(&r, n, &r);
+         }
+      }
+   }
+   *c = r;
+}
+
+static void random_u256(u256 *a)
+{
+   int i;
+
+   for (i = 0; i < 8; i++) a->w[i] = rand32();
+}
+
+int main()
+{  /* check; Montgomery arithmetic against reference and known answers */
+   U256MONT ctx;
+   u256 n, a, b, e, am, bm, c, d, x, y, zero, one;
+   size_t m;
+   int i;
+
+   memset(&zero, 0, sizeof(zero));
+   memset(&one, 0, sizeof(one));
+   one.b[0] = 1;
+   srand32(1);
+
+   /* FUNCTION TESTS */
+
+   for (m = 0; m < sizeof(Moduli) / sizeof(Moduli[0]); m++) {
+      ASSERT_EQ(multi_from_hex(Moduli[m], &n, sizeof(n)), 0);
+      ASSERT_EQ(u256_mont_init(&ctx, &n), 0);
+      /* n * n' == -1 mod R */
+      u256_mul(&n, &ctx.ninv, &x, NULL);
+      u256_add(&x, &one, &x);
+      ASSERT_EQ(u256_iszero(&x), 1);
+      /* one and R^2 convert back to 1 and R mod n */
+      u256_mont_from(&ctx, &ctx.one, &x);
+      ASSERT_EQ(u256_cmp(&x, u256_cmp(&n, &one) ? &one : &zero), 0);
+      u256_mont_from(&ctx, &ctx.r2, &x);
+      ASSERT_EQ(u256_cmp(&x, &ctx.one), 0);
+      for (i = 0; i < RANDOMS; i++) {
+         random_u256(&a);
+         random_u256(&b);
+         /* conversion reduces operands of any value */
+         u256_mont_to(&ctx, &a, &am);
+         u256_mont_to(&ctx, &b, &bm);
+         ASSERT_LT(u256_cmp(&am, &n), 0);
+         u256_divmod(&a, &n, NULL, &a);
+         u256_divmod(&b, &n, NULL, &b);
+         u256_mont_from(&ctx, &am, &x);
+         ASSERT_EQ(u256_cmp(&x, &a), 0);
+         /* product and square, against reference */
+         u256_mont_mul(&ctx, &am, &bm, &c);
+         u256_mont_from(&ctx, &c, &x);
+         mulmod_ref(&a, &b, &n, &y);
+         ASSERT_EQ(u256_cmp(&x, &y), 0);
+         u256_mont_sqr(&ctx, &am, &x);
+         u256_mont_mul(&ctx, &am, &am, &y);
+         ASSERT_EQ(u256_cmp(&x, &y), 0);
+         /* result may overlap operands */
+         u256_mont_mul(&ctx, &am, &bm, &am);
+         ASSERT_EQ(u256_cmp(&am, &c), 0);
+         u256_mont_sqr(&ctx, &c, &d);
+         u256_mont_sqr(&ctx, &c, &c);
+         ASSERT_EQ(u256_cmp(&c, &d), 0);
+         if (i < 8) {
+            /* exponentiation, against reference square-and-multiply */
+            random_u256(&e);
+            e.w[7 - (i & 7)] = 0;
+            u256_mont_exp(&ctx, &a, &e, &x);
+            y = u256_cmp(&n, &one) ? one : zero;
+            for (d = a, c = e; !u256_iszero(&c); u256_shr(&c, 1, &c)) {
+               if (c.b[0] & 1) mulmod_ref(&y, &d, &n, &y);
+               mulmod_ref(&d, &d, &n, &d);
+            }
+            ASSERT_EQ(u256_cmp(&x, &y), 0);
+         }
+      }
+      /* a^0 == 1 and a^1 == a */
+      u256_mont_exp(&ctx, &a, &zero, &x);
+      ASSERT_EQ(u256_cmp(&x, u256_cmp(&n, &one) ? &one : &zero), 0);
+      u256_mont_exp(&ctx, &a, &one, &x);
+      ASSERT_EQ(u256_cmp(&x, &a), 0);
+   }
+
+   /* known answers of a^e mod n */
+   ASSERT_EQ(multi_from_hex("decafbeeaddedbedc0ffee00c0c0aace"
+      "0000000000000000cafef00ddeadbeef", &a, sizeof(a)), 0);
+   ASSERT_EQ(multi_from_hex("c0c0aacec0ffee00decafbeeaddedbed"
+      "decafacebead50ffcafef00ddeadbeef", &e, sizeof(e)), 0);
+   ASSERT_EQ(multi_from_hex(Moduli[0], &n, sizeof(n)), 0);
+   ASSERT_EQ(u256_mont_init(&ctx, &n), 0);
+   u256_mont_exp(&ctx, &a, &e, &x);
+   ASSERT_EQ(multi_from_hex("fc158de642a21bd52e8cf214807c98b7"
+      "752a3a9f08a6d92b5a5c98b7512f809b", &y, sizeof(y)), 0);
+   ASSERT_EQ(u256_cmp(&x, &y), 0);
+   /* Fermat's little theorem, a^(p - 1) == 1 mod p */
+   u256_sub(&n, &one, &e);
+   u256_mont_exp(&ctx, &a, &e, &x);
+   ASSERT_EQ(u256_cmp(&x, &one), 0);
+   ASSERT_EQ(multi_from_hex(Moduli[1], &n, sizeof(n)), 0);
+   ASSERT_EQ(multi_from_hex("c0c0aacec0ffee00decafbeeaddedbed"
+      "decafacebead50ffcafef00ddeadbeef", &e, sizeof(e)), 0);
+   ASSERT_EQ(u256_mont_init(&ctx, &n), 0);
+   u256_mont_exp(&ctx, &a, &e, &x);
+   ASSERT_EQ(multi_from_hex("26c5a68fab5f2463467e117607eb3277"
+      "543d5fce3823bb37f12bbbdc53459ff7", &y, sizeof(y)), 0);
+   ASSERT_EQ(u256_cmp(&x, &y), 0);
+   ASSERT_EQ(multi_from_hex(Moduli[3], &n, sizeof(n)), 0);
+   ASSERT_EQ(u256_mont_init(&ctx, &n), 0);
+   u256_mont_exp(&ctx, &a, &e, &x);
+   ASSERT_EQ(multi_from_hex("8afd7e09e475281f001c1bc6646424e4"
+      "a2f4bc7ac0dfdbbb0c0b2298b9295d31", &y, sizeof(y)), 0);
+   ASSERT_EQ(u256_cmp(&x, &y), 0);
+
+   /* FAILURE TESTS */
+
+   n.b[0] &= 0xfe;
+   set_errno(0);
+   ASSERT_NE(u256_mont_init(&ctx, &n), 0);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_NE(u256_mont_init(&ctx, &zero), 0);
+   set_errno(0);
+   ASSERT_NE(u256_mont_init(NULL, &one), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(u256_mont_init(&ctx, NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+}
@@ -0,0 +1,182 @@
+
+#include "_assert.h"
+#include "extmath.h"
+
+#include "exterrno.h"
+#include "extlib.h"
+#include <string.h>
+
+#define RANDOMS   10000
+
+typedef struct {
+   int (*add)(const u256 *, const u256 *, u256 *);
+   int (*sub)(const u256 *, const u256 *, u256 *);
+   int (*mul)(const u256 *, const u256 *, u256 *, u256 *);
+   int (*divmod)(const u256 *, const u256 *, u256 *, u256 *);
+   int (*divmod64)(const u256 *, const void *, u256 *, void *);
+} U256OPS;
+
+static const U256OPS Ops[] = {
+   { u256_add, u256_sub, u256_mul, u256_divmod, u256_divmod64 },
+#ifdef HAS_64BIT
+   { u256_add_x64, u256_sub_x64, u256_mul_x64, u256_divmod_x64,
+      u256_divmod64_x64 },
+#endif
+   { u256_add_x86, u256_sub_x86, u256_mul_x86, u256_divmod_x86,
+      u256_divmod64_x86 },
+};
+
+/* fill @a a with a random value of @a words (significant) words,
+ * favouring edge case words that exercise quotient corrections */
+static void random_u256(u256 *a, int words)
+{
+   static const word32 edge[4] = { 0, 1, 0x7fffffff, 0xffffffff };
+   int i;
+
+   memset(a, 0, sizeof(*a));
+   for (i = 0; i < words; i++) {
+      a->w[i] = (rand32() & 1) ? rand32() : edge[rand32() & 3];
+   }
+}
+
+int main()
+{  /* check; u256 arithmetic against known answers and identities */
+   const u256 a = { .w = {
+      0xc0c0aace, 0xc0ffee00, 0xdecafbee, 0xaddedbed,
+      0xdecaface, 0xbead50ff, 0xcafef00d, 0xdeadbeef
+   } };
+   const u256 b = { .w = {
+      0xdeadbeef, 0xcafef00d, 0xbead50ff, 0xdecaface,
+      0xaddedbed, 0xdecafbee, 0xc0ffee00, 0xc0c0aace
+   } };
+   const u256 expect_lo = { .w = {
+      0x03da5a52, 0x0d8ae48b, 0xf1aa585d, 0xe42bb195,
+      0x202768e2, 0x3144cd52, 0x32709449, 0xd0c2ec68
+   } };
+   const u256 expect_hi = { .w = {
+      0x7ae1c8d4, 0x6a69830b, 0x65800019, 0x164181ce,
+      0x30594325, 0x5047dcf0, 0x4493424c, 0xa7a9e616
+   } };
+   /* divisor c = b >> 100 */
+   const u256 expect_q = { .w = {
+      0xed137271, 0xfb48fbc6, 0x7bee3424, 0x00000012
+   } };
+   const u256 expect_r = { .w = {
+      0x1f4887e2, 0x26dee3b2, 0x088e5c4a, 0x1e3910a3, 0x047bf3db
+   } };
+   /* divisor d = 0xcafef00ddeadbeef */
+   const word32 d[2] = { 0xdeadbeef, 0xcafef00d };
+   const word32 expect_r64[2] = { 0xbe3e16bb, 0xbd3c1965 };
+   const u256 expect_q64 = { .w = {
+      0xb2fb3d1d, 0x15ea5bf3, 0x52ea2303, 0xb3b466b9,
+      0xe58bf19b, 0x18d27d29, 0x00000001
+   } };
+   const u256 zero = { .w = { 0 } };
+   u256 c, x, y, q, r, lo, hi, ones;
+   word32 r64[2];
+   size_t n;
+   int i, j;
+
+   memset(&ones, 0xff, sizeof(ones));
+
+   /* FUNCTION TESTS -- for each of ext, x64 and x86 */
+   for (n = 0; n < sizeof(Ops) / sizeof(Ops[0]); n++) {
+      /* add/sub, with carry */
+      ASSERT_EQ(Ops[n].add(&a, &b, &x), 1);
+      ASSERT_EQ(Ops[n].sub(&x, &b, &y), 1);
+      ASSERT_CMP(&y, &a, sizeof(a));
+      ASSERT_EQ(Ops[n].sub(&a, &b, &x), 0);
+      ASSERT_EQ(Ops[n].add(&x, &b, &y), 0);
+      ASSERT_CMP(&y, &a, sizeof(a));
+      ASSERT_EQ(Ops[n].sub(&zero, &ones, &x), 1);
+      ASSERT_EQ(x.w[0], 1);
+      /* full 512-bit product */
+      ASSERT_EQ(Ops[n].mul(&a, &b, &lo, &hi), 1);
+      ASSERT_CMP(&lo, &expect_lo, sizeof(lo));
+      ASSERT_CMP(&hi, &expect_hi, sizeof(hi));
+      ASSERT_EQ(Ops[n].mul(&ones, &ones, &lo, &hi), 1);
+      ASSERT_EQ(lo.w[0], 1);
+      ASSERT_EQ(hi.w[0], 0xfffffffe);
+      ASSERT_EQ(hi.w[7], 0xffffffff);
+      ASSERT_EQ(Ops[n].mul(&a, &zero, &lo, NULL), 0);
+      ASSERT_CMP(&lo, &zero, sizeof(lo));
+      /* divmod by u256 and u64 */
+      u256_shr(&b, 100, &c);
+      ASSERT_EQ(Ops[n].divmod(&a, &c, &q, &r), 0);
+      ASSERT_CMP(&q, &expect_q, sizeof(q));
+      ASSERT_CMP(&r, &expect_r, sizeof(r));
+      ASSERT_EQ(Ops[n].divmod(&a, &b, &q, &r), 0);
+      ASSERT_EQ(q.w[0], 1);
+      ASSERT_EQ(Ops[n].divmod(&b, &a, &q, NULL), 0);
+      ASSERT_CMP(&q, &zero, sizeof(q));
+      ASSERT_EQ(Ops[n].divmod64(&a, d, &q, r64), 0);
+      ASSERT_CMP(&q, &expect_q64, sizeof(q));
+      ASSERT_CMP(r64, expect_r64, sizeof(r64));
+      /* random divisors of every length satisfy a = q * b + r, r < b */
+      srand32(n + 1);
+      for (i = 0; i < RANDOMS; i++) {
+         random_u256(&x, 8);
+         random_u256(&c, 1 + (int) (rand32() % 8));
+         if (u256_iszero(&c)) continue;
+         ASSERT_EQ(Ops[n].divmod(&x, &c, &q, &r), 0);
+         ASSERT_LT(u256_cmp(&r, &c), 0);
+         ASSERT_EQ(Ops[n].mul(&q, &c, &y, NULL), 0);
+         ASSERT_EQ(Ops[n].add(&y, &r, &y), 0);
+         ASSERT_CMP(&y, &x, sizeof(x));
+         /* and divisors of 64 bits, match u64 division */
+         if (c.w[2] | c.w[3] | c.w[4] | c.w[5] | c.w[6] | c.w[7]) continue;
+         ASSERT_EQ(Ops[n].divmod64(&x, c.w, &y, r64), 0);
+         ASSERT_CMP(&y, &q, sizeof(q));
+         ASSERT_CMP(r64, r.w, sizeof(r64));
+      }
+   }
+
+   /* shifts */
+   for (i = 0; i <= 256; i += 7) {
+      u256_shl(&a, i, &x);
+      u256_shr(&x, i, &y);
+      u256_shr(&ones, i, &c);
+      u256_and(&a, &c, &c);
+      ASSERT_CMP(&y, &c, sizeof(c));
+      /* shift matches multiplication by 2^i */
+      memset(&c, 0, sizeof(c));
+      if (i < 256) c.w[i >> 5] = WORD32_C(1) << (i & 31);
+      u256_mul(&a, &c, &y, NULL);
+      ASSERT_CMP(&x, &y, sizeof(y));
+   }
+   u256_shl(&a, 300, &x);
+   ASSERT_CMP(&x, &zero, sizeof(x));
+   u256_shr(&a, 0, &x);
+   ASSERT_CMP(&x, &a, sizeof(x));
+
+   /* bitwise operations and compare */
+   u256_not(&a, &x);
+   u256_xor(&a, &x, &y);
+   ASSERT_CMP(&y, &ones, sizeof(y));
+   u256_or(&a, &x, &y);
+   ASSERT_CMP(&y, &ones, sizeof(y));
+   u256_and(&a, &x, &y);
+   ASSERT_CMP(&y, &zero, sizeof(y));
+   ASSERT_EQ(u256_iszero(&y), 1);
+   ASSERT_EQ(u256_iszero(&a), 0);
+   ASSERT_EQ(u256_cmp(&a, &b), 1);
+   ASSERT_EQ(u256_cmp(&b, &a), -1);
+   ASSERT_EQ(u256_cmp(&a, &a), 0);
+   ASSERT_EQ(u256_cmp(&a, &b), cmp256(&a, &b));
+   for (j = 0; j < 8; j++) {
+      x = a;
+      x.w[j]++;
+      ASSERT_EQ(u256_cmp(&x, &a), 1);
+   }
+
+   /* FAILURE TESTS */
+
+   for (n = 0; n < sizeof(Ops) / sizeof(Ops[0]); n++) {
+      set_errno(0);
+      ASSERT_NE(Ops[n].divmod(&a, &zero, &q, &r), 0);
+      ASSERT_EQ(errno, EINVAL);
+      set_errno(0);
+      ASSERT_NE(Ops[n].divmod64(&a, zero.w, &q, r64), 0);
+      ASSERT_EQ(errno, EINVAL);
+   }
+}
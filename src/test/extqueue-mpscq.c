@@ -0,0 +1,140 @@
+
+#include "_assert.h"
+#include "extqueue.h"
+
+#include "exterrno.h"
+#include "exttime.h"
+
+#define NUMPRODUCERS 8
+#define ITERATIONS   10000
+
+typedef struct {
+   MPSCQ *qp;
+   SLNODE nodes[ITERATIONS];
+   long id[ITERATIONS][2];
+   long producer;
+} PRODUCER;
+
+ThreadProc producer(void *args)
+{
+   PRODUCER *pp = (PRODUCER *) args;
+   long i;
+
+   for (i = 0; i < ITERATIONS; i++) {
+      pp->id[i][0] = pp->producer;
+      pp->id[i][1] = i;
+      pp->nodes[i].data = pp->id[i];
+      ASSERT_EQ(mpscq_push(&pp->nodes[i], pp->qp), 0);
+   }
+
+   Unthread;
+}
+
+ThreadProc waker(void *args)
+{
+   MPSCQ *qp = (MPSCQ *) args;
+   int i;
+
+   /* wake the consumer, repeatedly, without pushing a node */
+   for (i = 0; i < 400; i++) {
+      mutex_lock(&qp->lock);
+      condition_signal(&qp->cond);
+      mutex_unlock(&qp->lock);
+      millisleep(5);
+   }
+
+   Unthread;
+}
+
+int main()
+{  /* check; operation and failures of MPSCQ operation */
+   static PRODUCER producers[NUMPRODUCERS];
+   Thread thrd[NUMPRODUCERS];
+   long expect[NUMPRODUCERS] = { 0 };
+   unsigned long long start;
+   SLNODE nodes[4], *np;
+   MPSCQ queue;
+   long *id;
+   int i;
+
+   /* FUNCTION TESTS */
+
+   ASSERT_EQ(mpscq_init(&queue), 0);
+   ASSERT_EQ(mpscq_isempty(&queue), 1);
+   /* push nodes, check FIFO order */
+   for (i = 0; i < 4; i++) {
+      ASSERT_EQ(mpscq_push(&nodes[i], &queue), 0);
+      ASSERT_EQ(mpscq_isempty(&queue), 0);
+   }
+   for (i = 0; i < 4; i++) {
+      ASSERT_EQ(mpscq_pop(&queue), &nodes[i]);
+      ASSERT_EQ(nodes[i].next, NULL);
+   }
+   ASSERT_EQ(mpscq_isempty(&queue), 1);
+   /* interleaved push/pop */
+   ASSERT_EQ(mpscq_push(&nodes[0], &queue), 0);
+   ASSERT_EQ(mpscq_pop(&queue), &nodes[0]);
+   ASSERT_EQ(mpscq_push(&nodes[1], &queue), 0);
+   ASSERT_EQ(mpscq_push(&nodes[2], &queue), 0);
+   ASSERT_EQ(mpscq_pop(&queue), &nodes[1]);
+   ASSERT_EQ(mpscq_push(&nodes[3], &queue), 0);
+   ASSERT_EQ(mpscq_wait(&queue), &nodes[2]);
+   ASSERT_EQ(mpscq_timedwait(&queue, 100), &nodes[3]);
+   ASSERT_EQ(mpscq_isempty(&queue), 1);
+
+   /* multiple producers, single (waiting) consumer */
+   for (i = 0; i < NUMPRODUCERS; i++) {
+      producers[i].qp = &queue;
+      producers[i].producer = i;
+      ASSERT_EQ(thread_create(&thrd[i], producer, &producers[i]), 0);
+   }
+   for (i = 0; i < NUMPRODUCERS * ITERATIONS; i++) {
+      ASSERT_NE((np = mpscq_wait(&queue)), NULL);
+      id = (long *) np->data;
+      /* each producers' nodes are received in order */
+      ASSERT_EQ(id[1], expect[id[0]]);
+      expect[id[0]]++;
+   }
+   for (i = 0; i < NUMPRODUCERS; i++) {
+      ASSERT_EQ(thread_join(thrd[i]), 0);
+      ASSERT_EQ(expect[i], ITERATIONS);
+   }
+   ASSERT_EQ(mpscq_isempty(&queue), 1);
+
+   /* FAILURE TESTS */
+
+   /* empty queue */
+   set_errno(0);
+   ASSERT_EQ(mpscq_pop(&queue), NULL);
+   ASSERT_EQ(errno, ENOLINK);
+   set_errno(0);
+   ASSERT_EQ(mpscq_timedwait(&queue, 1), NULL);
+   ASSERT_EQ(errno, CONDITION_TIMEOUT);
+   /* wakeups without a node do not extend the wait */
+   ASSERT_EQ(thread_create(&thrd[0], waker, &queue), 0);
+   set_errno(0);
+   start = millitime();
+   ASSERT_EQ(mpscq_timedwait(&queue, 100), NULL);
+   ASSERT_EQ(errno, CONDITION_TIMEOUT);
+   ASSERT_LT(millitime() - start, 1000);
+   ASSERT_EQ(thread_join(thrd[0]), 0);
+
+   /* bad parameters */
+   set_errno(0);
+   ASSERT_NE(mpscq_push(NULL, &queue), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(mpscq_push(&nodes[0], NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_EQ(mpscq_pop(NULL), NULL);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_EQ(mpscq_wait(NULL), NULL);
+   ASSERT_EQ(errno, EINVAL);
+   ASSERT_NE(mpscq_init(NULL), 0);
+   ASSERT_NE(mpscq_destroy(NULL), 0);
+
+   /* cleanup */
+   ASSERT_EQ(mpscq_destroy(&queue), 0);
+}
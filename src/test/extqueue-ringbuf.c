@@ -0,0 +1,132 @@
+
+#include "_assert.h"
+#include "extqueue.h"
+
+#include "exterrno.h"
+
+#define NUMTHREADS   4
+#define ITERATIONS   10000
+
+RINGBUF si_ringbuf;
+
+ThreadProc producer(void *args)
+{
+   long i, elem[2];
+
+   elem[0] = *((long *) args);
+   for (i = 0; i < ITERATIONS; i++) {
+      elem[1] = i;
+      ASSERT_EQ(ringbuf_wait_push(&si_ringbuf, elem), 0);
+   }
+
+   Unthread;
+}
+
+ThreadProc consumer(void *args)
+{
+   long *sum = (long *) args;
+   long i, elem[2];
+
+   for (i = 0; i < ITERATIONS; i++) {
+      ASSERT_EQ(ringbuf_wait_pop(&si_ringbuf, elem), 0);
+      *sum += elem[1];
+   }
+
+   Unthread;
+}
+
+int main()
+{  /* check; operation and failures of RINGBUF operation */
+   Thread prod[NUMTHREADS], cons[NUMTHREADS];
+   long ids[NUMTHREADS], sums[NUMTHREADS] = { 0 };
+   long expect[NUMTHREADS] = { 0 };
+   int list[32], out[32];
+   long elem[2], sum;
+   int i, j, mode;
+
+   for (i = 0; i < 32; i++) list[i] = i;
+
+   /* FUNCTION TESTS -- for both modes */
+   for (mode = RINGBUF_SPSC; mode <= RINGBUF_MPMC; mode++) {
+      /* capacity is rounded up to a power of two */
+      ASSERT_EQ(ringbuf_init(&si_ringbuf, 7, sizeof(int), mode), 0);
+      ASSERT_EQ(si_ringbuf.mask, 7);
+      ASSERT_EQ(ringbuf_count(&si_ringbuf), 0);
+      /* fill, check full, drain, check empty and FIFO order */
+      for (i = 0; i < 8; i++) ASSERT_EQ(ringbuf_push(&si_ringbuf, &i), 0);
+      ASSERT_EQ(ringbuf_count(&si_ringbuf), 8);
+      set_errno(0);
+      ASSERT_NE(ringbuf_push(&si_ringbuf, &i), 0);
+      ASSERT_EQ(errno, EAGAIN);
+      for (i = 0; i < 8; i++) {
+         ASSERT_EQ(ringbuf_pop(&si_ringbuf, &j), 0);
+         ASSERT_EQ(j, i);
+      }
+      set_errno(0);
+      ASSERT_NE(ringbuf_pop(&si_ringbuf, &j), 0);
+      ASSERT_EQ(errno, EAGAIN);
+      /* batch operations, across wrap around */
+      for (i = 0; i < 5; i++) {
+         ASSERT_EQ(ringbuf_push_n(&si_ringbuf, &list[i * 3], 3), 3);
+         ASSERT_EQ(ringbuf_pop_n(&si_ringbuf, out, 2), 2);
+         ASSERT_CMP(out, &list[i * 3], 2 * sizeof(int));
+         ASSERT_EQ(ringbuf_pop_n(&si_ringbuf, out, 32), 1);
+         ASSERT_EQ(out[0], list[(i * 3) + 2]);
+      }
+      ASSERT_EQ(ringbuf_push_n(&si_ringbuf, list, 32), 8);
+      ASSERT_EQ(ringbuf_push_n(&si_ringbuf, list, 32), 0);
+      ASSERT_EQ(ringbuf_pop_n(&si_ringbuf, out, 32), 8);
+      ASSERT_CMP(out, list, 8 * sizeof(int));
+      ASSERT_EQ(ringbuf_pop_n(&si_ringbuf, out, 32), 0);
+      ASSERT_EQ(ringbuf_destroy(&si_ringbuf), 0);
+   }
+
+   /* single producer, single consumer, blocking */
+   ASSERT_EQ(ringbuf_init(&si_ringbuf, 16, sizeof(elem), RINGBUF_SPSC), 0);
+   ids[0] = 0;
+   ASSERT_EQ(thread_create(&prod[0], producer, &ids[0]), 0);
+   for (i = 0; i < ITERATIONS; i++) {
+      ASSERT_EQ(ringbuf_wait_pop(&si_ringbuf, elem), 0);
+      ASSERT_EQ(elem[1], i);
+   }
+   ASSERT_EQ(thread_join(prod[0]), 0);
+   ASSERT_EQ(ringbuf_destroy(&si_ringbuf), 0);
+
+   /* multiple producers, multiple consumers, blocking */
+   ASSERT_EQ(ringbuf_init(&si_ringbuf, 16, sizeof(elem), RINGBUF_MPMC), 0);
+   for (i = 0; i < NUMTHREADS; i++) {
+      ids[i] = i;
+      ASSERT_EQ(thread_create(&prod[i], producer, &ids[i]), 0);
+      ASSERT_EQ(thread_create(&cons[i], consumer, &sums[i]), 0);
+   }
+   for (sum = i = 0; i < NUMTHREADS; i++) {
+      ASSERT_EQ(thread_join(prod[i]), 0);
+      ASSERT_EQ(thread_join(cons[i]), 0);
+      sum += sums[i];
+      expect[0] += (long) ITERATIONS * (ITERATIONS - 1) / 2;
+   }
+   ASSERT_EQ(sum, expect[0]);
+   ASSERT_EQ(ringbuf_count(&si_ringbuf), 0);
+   ASSERT_EQ(ringbuf_destroy(&si_ringbuf), 0);
+
+   /* FAILURE TESTS */
+
+   /* bad ringbuf_init() */
+   set_errno(0);
+   ASSERT_NE(ringbuf_init(NULL, 8, 8, RINGBUF_SPSC), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(ringbuf_init(&si_ringbuf, 0, 8, RINGBUF_SPSC), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(ringbuf_init(&si_ringbuf, 8, 0, RINGBUF_SPSC), 0);
+   ASSERT_EQ(errno, EINVAL);
+   set_errno(0);
+   ASSERT_NE(ringbuf_init(&si_ringbuf, 8, 8, -1), 0);
+   ASSERT_EQ(errno, EINVAL);
+   /* obscene memsize */
+   ASSERT_NE(ringbuf_init(&si_ringbuf, 1LL << 40, 1LL << 20, RINGBUF_SPSC), 0);
+   set_errno(0);
+   ASSERT_NE(ringbuf_destroy(NULL), 0);
+   ASSERT_EQ(errno, EINVAL);
+}
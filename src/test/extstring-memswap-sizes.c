@@ -0,0 +1,29 @@
+
+#include "_assert.h"
+#include "extstring.h"
+
+#define MAXLEN    200
+
+int main()
+{  /* check; memswap() of every size, at unaligned offsets */
+   unsigned char a[MAXLEN + 8], b[MAXLEN + 8];
+   unsigned char expect_a[MAXLEN + 8], expect_b[MAXLEN + 8];
+   size_t len, off, i;
+
+   for (len = 0; len <= MAXLEN; len++) {
+      for (off = 0; off < 4; off++) {
+         for (i = 0; i < sizeof(a); i++) {
+            a[i] = (unsigned char) i;
+            b[i] = (unsigned char) ~i;
+         }
+         memcpy(expect_a, a, sizeof(a));
+         memcpy(expect_b, b, sizeof(b));
+         memcpy(&expect_a[off], &b[off + 1], len);
+         memcpy(&expect_b[off + 1], &a[off], len);
+         memswap(&a[off], &b[off + 1], len);
+         /* swapped bytes, with neighbouring bytes untouched */
+         ASSERT_CMP(a, expect_a, sizeof(a));
+         ASSERT_CMP(b, expect_b, sizeof(b));
+      }
+   }
+}